@@ -6,6 +6,9 @@
 #include "../World/Npc.h"
 #include "../World/Player.h"
 #include "../World/WorldManager.h"
+#include "../World/MapManager.h"
+#include "../World/Map.h"
+#include "../World/Pathfinder.h"
 #include "../Combat/CombatFormulas.h"
 #include "../Combat/CombatMessenger.h"
 #include "../Combat/SpellCaster.h"
@@ -19,10 +22,19 @@
 
 #include <cmath>
 #include <algorithm>
+#include <atomic>
 #include <random>
 
 // Forward declarations for helper functions
-static void broadcastNpcMovement(Npc* npc, float targetX, float targetY);
+static void broadcastNpcMovement(Npc* npc);
+static const Map* npcMap(Npc* npc);
+static PathResult findNpcPath(Npc* npc, float targetX, float targetY, std::vector<MoveSpline::Point>& path);
+
+// Movement packet counters. NPCs move inside map jobs, so these are atomic.
+// s_perTickBytes is what re-sending the spline every moving tick would cost.
+static std::atomic<uint64_t> s_splinesSent{0};
+static std::atomic<uint64_t> s_splineBytes{0};
+static std::atomic<uint64_t> s_perTickBytes{0};
 
 // ============================================================================
 // NpcAI Namespace Implementation
@@ -123,7 +135,7 @@ void NpcAI::updateCombat(Npc* npc, float deltaTime)
     }
 
     // Update target reference
-    if (npc->getTarget() != target)
+    if (npc->getTargetGuid() != target->getGuid())
     {
         npc->setTarget(target);
     }
@@ -136,13 +148,21 @@ void NpcAI::updateCombat(Npc* npc, float deltaTime)
     // Check if in melee range
     if (isInMeleeRange(npc, target))
     {
+        // Plant feet before swinging
+        stopMoving(npc);
+
         // Perform melee attack
         performMeleeAttack(npc, target);
     }
-    else
+    else if (!moveTowardsEntity(npc, target, deltaTime))
     {
-        // Move towards target
-        moveTowardsEntity(npc, target, deltaTime);
+        // Walled off from the target - give up rather than stand there
+        npc->setAIState(NpcAIState::Evading);
+        npc->setTarget(nullptr);
+        npc->getThreatManager().clear();
+
+        LOG_DEBUG("NpcAI: '{}' target unreachable - evading", npc->getName());
+        return;
     }
 
     // Try to cast spells if available
@@ -161,6 +181,15 @@ void NpcAI::updateEvading(Npc* npc, float deltaTime)
     // Check if we've arrived home
     if (npc->distanceFromHome() < HOME_ARRIVAL_DISTANCE)
     {
+        // Viewers walk the last cell on the spline already sent;
+        // finish it here instead of sending a stop short of home
+        if (npc->getMoveSpline().isActive())
+        {
+            npc->getMoveSpline().stop();
+            npc->setPosition(npc->getHomeX(), npc->getHomeY());
+            sWorldManager.onNpcMoved(npc);
+        }
+
         // Reset NPC
         npc->setAIState(NpcAIState::Idle);
 
@@ -191,37 +220,44 @@ Player* NpcAI::findAggroTarget(Npc* npc)
         return nullptr;
 
     float aggroRange = npc->getAggroRange();
-    int mapId = npc->getMapId();
-
-    // Get all players on the same map
-    std::vector<Player*> players = sWorldManager.getPlayersOnMap(mapId);
-
-    Player* closestTarget = nullptr;
-    float closestDistSq = aggroRange * aggroRange;
+    if (aggroRange <= 0.0f)
+        return nullptr;
 
-    for (Player* player : players)
-    {
-        // Skip invalid targets
-        if (!player || player->isDead())
-            continue;
+    // Closest living, hostile player within aggro range that the NPC can see
+    SpatialFilter filter;
+    filter.types = SpatialFilter::Players;
+    filter.aliveOnly = true;
+    filter.predicate = [npc](Entity* player) { return npc->isHostileTo(player); };
 
-        // Check if hostile
-        if (!npc->isHostileTo(player))
-            continue;
+    static thread_local std::vector<SpatialHit> hits;
+    size_t count = sWorldManager.queryNearestN(npc->getMapId(), npc->getX(), npc->getY(), aggroRange,
+                                               AGGRO_CANDIDATES, filter, hits);
+    if (count == 0)
+        return nullptr;
 
-        // Check distance
-        float dx = player->getX() - npc->getX();
-        float dy = player->getY() - npc->getY();
-        float distSq = dx * dx + dy * dy;
+    const Map* map = npcMap(npc);
+    if (!map)
+        return static_cast<Player*>(hits[0].entity);
 
-        if (distSq < closestDistSq)
-        {
-            closestDistSq = distSq;
-            closestTarget = player;
-        }
+    static thread_local std::vector<float> hitX;
+    static thread_local std::vector<float> hitY;
+    static thread_local std::vector<uint8_t> inSight;
+    hitX.clear();
+    hitY.clear();
+    for (const SpatialHit& hit : hits)
+    {
+        hitX.push_back(hit.entity->getX());
+        hitY.push_back(hit.entity->getY());
     }
+    inSight.resize(count);
+    map->getSightLayer().segmentsClear(npc->getX(), npc->getY(), hitX.data(), hitY.data(), count, inSight.data());
 
-    return closestTarget;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (inSight[i])
+            return static_cast<Player*>(hits[i].entity);
+    }
+    return nullptr;
 }
 
 void NpcAI::performMeleeAttack(Npc* npc, Entity* target)
@@ -387,12 +423,8 @@ void NpcAI::performSpellCast(Npc* npc, Entity* target, int32_t spellId)
     buf << opcode;
     spellGo.pack(buf);
 
-    // Send to all players on the map
-    std::vector<Player*> players = sWorldManager.getPlayersOnMap(npc->getMapId());
-    for (Player* player : players)
-    {
-        player->sendPacket(buf);
-    }
+    // Send to the players that can see the NPC
+    sWorldManager.broadcastToVisible(npc, buf);
 
     // Consume mana
     int32_t npcLevel = npc->getVariable(ObjDefines::Variable::Level);
@@ -532,7 +564,11 @@ void NpcAI::updatePatrol(Npc* npc, float deltaTime)
         return;
     }
 
-    moveTowards(npc, wp.x, wp.y, deltaTime);
+    if (!moveTowards(npc, wp.x, wp.y, deltaTime))
+    {
+        // Waypoint inside a wall or cut off: skip it
+        npc->setCurrentWaypointIndex((index + 1) % static_cast<int32_t>(waypoints.size()));
+    }
 }
 
 void NpcAI::updateWander(Npc* npc, float deltaTime)
@@ -557,12 +593,31 @@ void NpcAI::updateWander(Npc* npc, float deltaTime)
         std::uniform_real_distribution<float> angleDist(0.0f, 6.283185f);
         std::uniform_real_distribution<float> radiusDist(0.0f, radius);
 
-        float angle = angleDist(rng);
-        float dist = radiusDist(rng);
+        // Only spots with room around them that can be walked to in a
+        // straight line, so wandering never needs a path search; a few
+        // tries, then wait and try again
+        const Map* map = npcMap(npc);
+        bool picked = false;
+        for (int attempt = 0; attempt < WANDER_ATTEMPTS && !picked; ++attempt)
+        {
+            float angle = angleDist(rng);
+            float dist = radiusDist(rng);
 
-        float targetX = npc->getHomeX() + std::cos(angle) * dist;
-        float targetY = npc->getHomeY() + std::sin(angle) * dist;
-        npc->setWanderTarget(targetX, targetY);
+            float targetX = npc->getHomeX() + std::cos(angle) * dist;
+            float targetY = npc->getHomeY() + std::sin(angle) * dist;
+            if (map && (!map->getClearance().isClear(targetX, targetY, WANDER_CLEARANCE) ||
+                        !map->getClearance().isSegmentClear(npc->getX(), npc->getY(), targetX, targetY)))
+                continue;
+
+            npc->setWanderTarget(targetX, targetY);
+            picked = true;
+        }
+
+        if (!picked)
+        {
+            npc->setWanderWaitTimer(1.5f);
+            return;
+        }
     }
 
     float distance = npc->distanceTo(npc->getWanderTargetX(), npc->getWanderTargetY());
@@ -573,7 +628,12 @@ void NpcAI::updateWander(Npc* npc, float deltaTime)
         return;
     }
 
-    moveTowards(npc, npc->getWanderTargetX(), npc->getWanderTargetY(), deltaTime);
+    if (!moveTowards(npc, npc->getWanderTargetX(), npc->getWanderTargetY(), deltaTime))
+    {
+        // Picked a spot it cannot reach; pick another after the pause
+        npc->clearWanderTarget();
+        npc->setWanderWaitTimer(1.5f);
+    }
 }
 
 void NpcAI::callForHelp(Npc* npc, Entity* target)
@@ -587,68 +647,120 @@ void NpcAI::callForHelp(Npc* npc, Entity* target)
     npc->setCalledForHelp(true);
 
     constexpr float helpRange = 3.0f;
-    std::vector<Npc*> npcs = sWorldManager.getNpcsOnMap(npc->getMapId());
-    for (Npc* ally : npcs)
-    {
-        if (!ally || ally == npc || ally->isDead())
-            continue;
-
-        if (ally->getAIState() != NpcAIState::Idle)
-            continue;
 
-        if (ally->getFaction() != npc->getFaction())
-            continue;
+    // Idle, living NPCs of the same faction within help range
+    SpatialFilter filter;
+    filter.types = SpatialFilter::Npcs;
+    filter.exclude = npc;
+    filter.aliveOnly = true;
+    filter.npcFaction = npc->getFaction();
 
-        if (!npc->isInRange(ally, helpRange))
+    static thread_local std::vector<SpatialHit> hits;
+    sWorldManager.queryRadius(npc->getMapId(), npc->getX(), npc->getY(), helpRange, filter, hits);
+    for (const SpatialHit& hit : hits)
+    {
+        Npc* ally = static_cast<Npc*>(hit.entity);
+        if (ally->getAIState() != NpcAIState::Idle)
             continue;
 
         ally->addThreat(target, 1);
     }
 }
 
-void NpcAI::moveTowards(Npc* npc, float targetX, float targetY, float deltaTime)
+bool NpcAI::moveTowards(Npc* npc, float targetX, float targetY, float deltaTime)
 {
     if (!npc)
-        return;
+        return false;
+
+    MoveSpline& spline = npc->getMoveSpline();
 
     float dx = targetX - npc->getX();
     float dy = targetY - npc->getY();
     float distance = std::sqrt(dx * dx + dy * dy);
 
-    if (distance < 1.0f)
-        return;  // Already at target
+    if (distance < 1.0f && !spline.isActive())
+        return true;  // Already at target
 
-    // Normalize direction
-    float dirX = dx / distance;
-    float dirY = dy / distance;
-
-    // Calculate movement amount
     float moveSpeed = NPC_MOVE_SPEED;
     if (npc->getAIState() == NpcAIState::Evading)
     {
         moveSpeed *= EVADE_SPEED_MULTIPLIER;
     }
 
-    float moveAmount = moveSpeed * deltaTime;
-    moveAmount = std::min(moveAmount, distance);  // Don't overshoot
+    // Only a new path (none yet or the last leg walked, speed changed, or the
+    // goal drifted, e.g. a chased target moved) is sent; viewers interpolate
+    // the rest
+    bool repath = !spline.isActive() || spline.getSpeed() != moveSpeed;
+    if (!repath)
+    {
+        MoveSpline::Point dest = spline.getGoal();
+        float driftX = targetX - dest.x;
+        float driftY = targetY - dest.y;
+        repath = driftX * driftX + driftY * driftY > REPATH_DISTANCE * REPATH_DISTANCE;
+    }
+
+    if (repath)
+    {
+        std::vector<MoveSpline::Point> path;
+        PathResult result = findNpcPath(npc, targetX, targetY, path);
+
+        if (result == PathResult::Deferred)
+        {
+            // Out of search budget this tick: keep walking the old path
+            if (!spline.isActive())
+                return true;
+        }
+        else
+        {
+            if (result == PathResult::NoPath)
+            {
+                if (npc->getAIState() != NpcAIState::Evading)
+                {
+                    stopMoving(npc);
+                    return false;
+                }
+                path.assign(1, {targetX, targetY});
+            }
 
-    // Update position
-    float newX = npc->getX() + dirX * moveAmount;
-    float newY = npc->getY() + dirY * moveAmount;
+            // Long paths come back a leg at a time; drift is measured
+            // against the real target
+            spline.start(npc->getX(), npc->getY(), std::move(path), moveSpeed);
+            spline.setGoal({targetX, targetY});
+            broadcastNpcMovement(npc);
+        }
+    }
+
+    // Walk the spline the viewers were sent
+    float oldX = npc->getX();
+    float oldY = npc->getY();
+    float newX = oldX;
+    float newY = oldY;
+    spline.advance(deltaTime, newX, newY);
     npc->setPosition(newX, newY);
+    sWorldManager.onNpcMoved(npc);
 
-    // Update orientation
-    float orientation = calculateOrientation(npc->getX(), npc->getY(), targetX, targetY);
-    npc->setOrientation(orientation);
+    if (newX != oldX || newY != oldY)
+        npc->setOrientation(calculateOrientation(oldX, oldY, newX, newY));
 
-    // Broadcast movement to nearby players
-    broadcastNpcMovement(npc, targetX, targetY);
+    // Per-tick broadcasting would have sent a one-point spline to every viewer
+    static const size_t tickSplineSize = []
+    {
+        GP_Server_UnitSpline packet;
+        packet.m_spline.push_back({0.0f, 0.0f});
+        StlBuffer buf;
+        uint16_t opcode = packet.getOpcode();
+        buf << opcode;
+        packet.pack(buf);
+        return buf.size();
+    }();
+    s_perTickBytes += tickSplineSize * npc->getVisibleTo().size();
+    return true;
 }
 
-void NpcAI::moveTowardsEntity(Npc* npc, Entity* target, float deltaTime)
+bool NpcAI::moveTowardsEntity(Npc* npc, Entity* target, float deltaTime)
 {
     if (!npc || !target)
-        return;
+        return false;
 
     // Stop at melee range, not exactly at target
     float stopDistance = npc->getMeleeRange() - 5.0f;
@@ -657,9 +769,12 @@ void NpcAI::moveTowardsEntity(Npc* npc, Entity* target, float deltaTime)
     float distance = std::sqrt(dx * dx + dy * dy);
 
     if (distance <= stopDistance)
-        return;  // Close enough
+    {
+        stopMoving(npc);  // Close enough
+        return true;
+    }
 
-    moveTowards(npc, target->getX(), target->getY(), deltaTime);
+    return moveTowards(npc, target->getX(), target->getY(), deltaTime);
 }
 
 void NpcAI::returnHome(Npc* npc, float deltaTime)
@@ -670,6 +785,28 @@ void NpcAI::returnHome(Npc* npc, float deltaTime)
     moveTowards(npc, npc->getHomeX(), npc->getHomeY(), deltaTime);
 }
 
+void NpcAI::stopMoving(Npc* npc)
+{
+    if (!npc || !npc->getMoveSpline().isActive())
+        return;
+
+    npc->getMoveSpline().stop();
+    broadcastNpcMovement(npc);
+}
+
+void NpcAI::logMovementStats()
+{
+    uint64_t splines = s_splinesSent.exchange(0);
+    uint64_t bytes = s_splineBytes.exchange(0);
+    uint64_t perTickBytes = s_perTickBytes.exchange(0);
+    if (splines == 0 && perTickBytes == 0)
+        return;
+
+    LOG_INFO("NPC movement: %llu splines, %.1f KB sent (%.1f KB with per-tick splines)",
+             static_cast<unsigned long long>(splines),
+             bytes / 1024.0, perTickBytes / 1024.0);
+}
+
 bool NpcAI::shouldLeash(Npc* npc)
 {
     if (!npc)
@@ -705,31 +842,38 @@ float NpcAI::calculateOrientation(float fromX, float fromY, float toX, float toY
     return std::atan2(dy, dx);
 }
 
-// Helper function to broadcast NPC movement
-static void broadcastNpcMovement(Npc* npc, float targetX, float targetY)
+// Helper function to broadcast the NPC's current spline (or a stop)
+static void broadcastNpcMovement(Npc* npc)
 {
     if (!npc)
         return;
 
-    // Use GP_Server_UnitSpline for movement
-    // Spline format: start position + list of waypoints
-    GP_Server_UnitSpline packet;
-    packet.m_guid = static_cast<uint32_t>(npc->getGuid());
-    packet.m_startX = npc->getX();
-    packet.m_startY = npc->getY();
-    packet.m_spline.push_back({targetX, targetY});
-    packet.m_slide = false;
-    packet.m_silent = false;
+    StlBuffer buf = sWorldManager.buildMoveSpline(npc);
+    size_t recipients = sWorldManager.broadcastToVisible(npc, buf);
 
-    StlBuffer buf;
-    uint16_t opcode = packet.getOpcode();
-    buf << opcode;
-    packet.pack(buf);
+    ++s_splinesSent;
+    s_splineBytes += buf.size() * recipients;
+}
 
-    // Send to all players on the map
-    std::vector<Player*> players = sWorldManager.getPlayersOnMap(npc->getMapId());
-    for (Player* player : players)
+// Helper function to get the collision data of an NPC's map
+static const Map* npcMap(Npc* npc)
+{
+    // NPCs only tick on loaded maps, so this never loads one
+    if (!npc->getMap())
+        npc->setMap(sMapManager.getMap(npc->getMapId()));
+    return npc->getMap();
+}
+
+// Helper function to path an NPC around its map's walls
+static PathResult findNpcPath(Npc* npc, float targetX, float targetY, std::vector<MoveSpline::Point>& path)
+{
+    const Map* map = npcMap(npc);
+    if (!map)
     {
-        player->sendPacket(buf);
+        // No collision data: walk straight as before
+        path.assign(1, {targetX, targetY});
+        return PathResult::Found;
     }
+
+    return Pathfinder::findPath(*map, npc->getX(), npc->getY(), targetX, targetY, path);
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -41,11 +42,22 @@ namespace NpcAI
     // Combat helpers
     void callForHelp(Npc* npc, Entity* target);
 
-    // Movement
-    void moveTowards(Npc* npc, float targetX, float targetY, float deltaTime);
-    void moveTowardsEntity(Npc* npc, Entity* target, float deltaTime);
+    // Movement along a path around walls. Returns false when the target
+    // cannot be reached (the NPC then stands still); evading NPCs fall back
+    // to a straight line so they always get home.
+    bool moveTowards(Npc* npc, float targetX, float targetY, float deltaTime);
+    bool moveTowardsEntity(Npc* npc, Entity* target, float deltaTime);
     void returnHome(Npc* npc, float deltaTime);
 
+    // Halt a walk in progress where the NPC is and tell viewers (no-op when
+    // standing). Movement is change-driven: a spline goes out when a path
+    // starts or changes, and clients interpolate in between.
+    void stopMoving(Npc* npc);
+
+    // Log and reset the NPC movement packet counters (called with the
+    // periodic stats)
+    void logMovementStats();
+
     // Leash check - returns true if NPC should evade
     bool shouldLeash(Npc* npc);
 
@@ -56,8 +68,12 @@ namespace NpcAI
     float calculateOrientation(float fromX, float fromY, float toX, float toY);
 
     // Configuration
-    constexpr float NPC_MOVE_SPEED = 100.0f;        // Pixels per second
+    constexpr float NPC_MOVE_SPEED = 1.5625f;       // Cells per second, half the player walk
     constexpr float MELEE_ATTACK_COOLDOWN = 2.0f;   // Seconds between melee attacks
     constexpr float EVADE_SPEED_MULTIPLIER = 2.0f;  // NPCs move faster when evading
-    constexpr float HOME_ARRIVAL_DISTANCE = 10.0f;  // Distance to consider "at home"
+    constexpr float HOME_ARRIVAL_DISTANCE = 1.0f;   // Distance (cells) to consider "at home"
+    constexpr float REPATH_DISTANCE = 2.0f;         // Destination drift (cells) that sends a new path
+    constexpr size_t AGGRO_CANDIDATES = 8;          // Nearest players tested for line of sight
+    constexpr int WANDER_ATTEMPTS = 4;              // Random spots tried per wander pick
+    constexpr float WANDER_CLEARANCE = 1.0f;        // Room (cells) a wander spot keeps from walls
 }
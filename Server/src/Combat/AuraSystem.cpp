@@ -519,6 +519,26 @@ void AuraManager::update(int32_t deltaTimeMs)
     }
 }
 
+void AuraManager::fastForward(int32_t elapsedMs)
+{
+    if (m_auras.empty() || elapsedMs <= 0)
+        return;
+
+    // Index loop: a periodic tick can kill the owner and clear the auras
+    for (size_t i = 0; i < m_auras.size(); ++i)
+    {
+        Aura& aura = m_auras[i];
+        int32_t span = aura.maxDurationMs > 0 ? std::min(elapsedMs, aura.getRemainingMs()) : elapsedMs;
+        processPeriodicEffects(aura, span);
+
+        if (i < m_auras.size() && aura.maxDurationMs > 0)
+            aura.elapsedMs += elapsedMs;
+    }
+
+    // Removes what expired and broadcasts the change
+    update(0);
+}
+
 void AuraManager::processPeriodicEffects(Aura& aura, int32_t deltaTimeMs)
 {
     if (!m_owner)
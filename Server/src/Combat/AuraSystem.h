@@ -188,6 +188,10 @@ public:
     // deltaTimeMs is time since last update in milliseconds
     void update(int32_t deltaTimeMs);
 
+    // Catch up after the owner slept: periodic effects tick for as long as
+    // each aura lasted, then expired auras are removed
+    void fastForward(int32_t elapsedMs);
+
     // ========================================================================
     // Client Sync
     // ========================================================================
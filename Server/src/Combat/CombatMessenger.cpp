@@ -7,6 +7,7 @@
 #include "World/Entity.h"
 #include "World/Player.h"
 #include "World/WorldManager.h"
+#include "Core/Config.h"
 #include "Core/Logger.h"
 #include "GamePacketServer.h"
 
@@ -88,27 +89,25 @@ void broadcastCombatMessage(Entity* attacker, Entity* victim,
         Player* centerPlayer = dynamic_cast<Player*>(broadcastCenter);
         if (centerPlayer)
         {
-            // broadcastToVisible excludes the source player
-            // We need to exclude both attacker and victim
-            auto nearbyPlayers = sWorldManager.getPlayersOnMap(centerPlayer->getMapId());
-
-            for (Player* nearby : nearbyPlayers)
+            // Combat text goes to the players who can see the fight, the same
+            // view distance broadcastToVisible uses; attacker and victim are
+            // skipped below
+            const float range = sConfig.getViewDistance(centerPlayer->getMapId());
+
+            SpatialFilter filter;
+            filter.types = SpatialFilter::Players;
+            static thread_local std::vector<SpatialHit> hits;
+            sWorldManager.queryRadius(centerPlayer->getMapId(), broadcastCenter->getX(), broadcastCenter->getY(),
+                                      range, filter, hits);
+
+            for (const SpatialHit& hit : hits)
             {
                 // Skip attacker and victim (already sent)
+                Player* nearby = static_cast<Player*>(hit.entity);
                 if (nearby == attackerPlayer || nearby == victimPlayer)
                     continue;
 
-                // Check visibility distance
-                float dx = nearby->getX() - broadcastCenter->getX();
-                float dy = nearby->getY() - broadcastCenter->getY();
-                float distSq = dx * dx + dy * dy;
-
-                // Use visibility range (assume ~1000 pixels, squared = 1000000)
-                constexpr float COMBAT_MSG_RANGE_SQ = 1000.0f * 1000.0f;
-                if (distSq <= COMBAT_MSG_RANGE_SQ)
-                {
-                    nearby->sendPacket(buf);
-                }
+                nearby->sendPacket(buf);
             }
         }
     }
@@ -11,11 +11,22 @@
 #include "World/Entity.h"
 #include "World/Player.h"
 #include "World/Map.h"
+#include "World/MapManager.h"
 #include "World/WorldManager.h"
 #include "Core/Logger.h"
 #include "ObjDefines.h"
 #include <cmath>
 
+// Collision data of the map an entity is on. NPCs only get their map when
+// they first need it, so it is looked up (never loaded: the entity is on it)
+// and kept here as in NpcAI.
+static const Map* collisionMap(Entity* entity)
+{
+    if (!entity->getMap())
+        entity->setMap(sMapManager.getMap(entity->getMapId()));
+    return entity->getMap();
+}
+
 // ============================================================================
 // Cast Result String Conversion
 // ============================================================================
@@ -422,41 +433,48 @@ std::vector<Entity*> SpellCaster::getTargets(Entity* caster, const SpellTemplate
                 continue;
             }
 
-            // Get all players in range from WorldManager
-            int mapId = caster->getMapId();
-            auto playersOnMap = sWorldManager.getPlayersOnMap(mapId);
-
+            // Players and NPCs in range, friendly or hostile as the effect needs
             bool isHostileEffect = (spell->effectPositive[i] == 0);
-            float radiusF = static_cast<float>(radius);
 
-            for (Player* player : playersOnMap)
+            SpatialFilter filter;
+            filter.exclude = isHostileEffect ? caster : nullptr;  // Skip self if not self-buff
+            filter.predicate = [caster, isHostileEffect](Entity* entity)
             {
-                // Check distance from center
-                float dx = player->getX() - centerX;
-                float dy = player->getY() - centerY;
-                float dist = std::sqrt(dx * dx + dy * dy);
-
-                if (dist > radiusF)
-                    continue;
-
-                // Skip self if not self-buff
-                if (player == caster && isHostileEffect)
-                    continue;
+                return isHostileEffect ? areHostile(caster, entity) : areFriendly(caster, entity);
+            };
+
+            static thread_local std::vector<SpatialHit> hits;
+            sWorldManager.queryRadius(caster->getMapId(), centerX, centerY,
+                                      static_cast<float>(radius), filter, hits);
+
+            // Walls shield what is behind them from the centre of the effect;
+            // every candidate is tested in one batch
+            static thread_local std::vector<float> hitX;
+            static thread_local std::vector<float> hitY;
+            static thread_local std::vector<uint8_t> inSight;
+            hitX.clear();
+            hitY.clear();
+            for (const SpatialHit& hit : hits)
+            {
+                hitX.push_back(hit.entity->getX());
+                hitY.push_back(hit.entity->getY());
+            }
+            inSight.assign(hits.size(), 1);
+            if (const Map* map = collisionMap(caster))
+                map->getSightLayer().segmentsClear(centerX, centerY, hitX.data(), hitY.data(),
+                                                   hits.size(), inSight.data());
 
-                // Check friendly/hostile
-                if (isHostileEffect && !areHostile(caster, player))
-                    continue;
-                if (!isHostileEffect && !areFriendly(caster, player))
+            for (size_t h = 0; h < hits.size(); ++h)
+            {
+                if (!inSight[h])
                     continue;
 
                 // Add to targets if not already present
-                if (std::find(targets.begin(), targets.end(), static_cast<Entity*>(player)) == targets.end())
+                if (std::find(targets.begin(), targets.end(), hits[h].entity) == targets.end())
                 {
-                    targets.push_back(player);
+                    targets.push_back(hits[h].entity);
                 }
             }
-
-            // TODO: Also check NPCs when NPC system is implemented (Task 5.13)
         }
     }
 
@@ -475,11 +493,15 @@ std::vector<Entity*> SpellCaster::getTargets(Entity* caster, const SpellTemplate
 
 bool SpellCaster::hasLineOfSight(Entity* caster, Entity* target)
 {
-    // TODO: Implement line of sight checking using map collision data
-    // For now, always return true
-    (void)caster;
-    (void)target;
-    return true;
+    if (!caster || !target || caster == target)
+        return true;
+
+    // Without collision data for the map nothing blocks
+    const Map* map = collisionMap(caster);
+    if (!map)
+        return true;
+
+    return map->hasLineOfSight(caster->getX(), caster->getY(), target->getX(), target->getY());
 }
 
 float SpellCaster::getDistance(Entity* a, Entity* b)
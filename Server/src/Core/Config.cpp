@@ -89,6 +89,46 @@ bool Config::load(const std::string& filename)
                 m_serverDbPath = value;
             }
         }
+        else if (currentSection == "Network") {
+            if (key == "Backend") {
+                m_networkBackend = value;
+                std::transform(m_networkBackend.begin(), m_networkBackend.end(),
+                               m_networkBackend.begin(), ::tolower);
+            } else if (key == "SendQueueLimitKB") {
+                m_sendQueueLimitKB = static_cast<size_t>(std::stoul(value));
+            } else if (key == "IoThreads") {
+                m_ioThreads = std::max(0, std::stoi(value));
+            } else if (key == "EntityUpdates") {
+                m_entityUpdates = value;
+                std::transform(m_entityUpdates.begin(), m_entityUpdates.end(),
+                               m_entityUpdates.begin(), ::tolower);
+            }
+        }
+        else if (currentSection == "World") {
+            if (key == "ViewDistance") {
+                m_viewDistance = std::max(0.0f, std::stof(value));
+            } else if (key.rfind("ViewDistance.", 0) == 0) {
+                int mapId = std::stoi(key.substr(13));
+                m_mapViewDistance[mapId] = std::max(0.0f, std::stof(value));
+            } else if (key == "MapThreads") {
+                m_mapThreads = std::max(0, std::stoi(value));
+            } else if (key == "ActivationDistance") {
+                m_activationDistance = std::max(0.0f, std::stof(value));
+            } else if (key == "PathBudget") {
+                m_pathBudget = static_cast<uint32_t>(std::max(0L, std::stol(value)));
+            } else if (key == "PreloadMaps") {
+                m_preloadMaps = std::stoi(value) != 0;
+            } else if (key == "MapLoadThreads") {
+                m_mapLoadThreads = std::max(0, std::stoi(value));
+            } else if (key == "MapIdleUnload") {
+                m_mapIdleUnload = std::max(0.0f, std::stof(value));
+            }
+        }
+        else if (currentSection == "Capture") {
+            if (key == "File") {
+                m_captureFile = value;
+            }
+        }
         else if (currentSection == "Logging") {
             if (key == "Level") {
                 m_logLevel = value;
@@ -102,3 +142,9 @@ bool Config::load(const std::string& filename)
     LOG_INFO("Loaded configuration from %s", filename.c_str());
     return true;
 }
+
+float Config::getViewDistance(int mapId) const
+{
+    auto it = m_mapViewDistance.find(mapId);
+    return it != m_mapViewDistance.end() ? it->second : m_viewDistance;
+}
@@ -4,7 +4,9 @@
 #pragma once
 
 #include <string>
+#include <cstddef>
 #include <cstdint>
+#include <unordered_map>
 
 class Config
 {
@@ -22,6 +24,42 @@ public:
     const std::string& getServerDbPath() const { return m_serverDbPath; }
     const std::string& getMapsPath() const { return m_mapsPath; }
 
+    // Network ("epoll" on Linux, "sfml" selector fallback elsewhere)
+    const std::string& getNetworkBackend() const { return m_networkBackend; }
+    size_t getSendQueueLimit() const { return m_sendQueueLimitKB * 1024; }
+    int getIoThreads() const { return m_ioThreads; }  // 0 = socket I/O on the tick thread
+
+    // Entity variable updates: "batched" (one snapshot per entity per tick),
+    // "immediate" (snapshot per change) or "delta" (GP_Server_ObjectVariable)
+    const std::string& getEntityUpdates() const { return m_entityUpdates; }
+
+    // World: view distance in map cells for a map (ViewDistance.<mapId>
+    // overrides ViewDistance; 0 = the whole map is visible)
+    float getViewDistance(int mapId) const;
+
+    // World: threads that tick maps in parallel (0 = maps tick on the tick thread)
+    int getMapThreads() const { return m_mapThreads; }
+
+    // World: idle NPCs with no player within this many map cells sleep
+    // (0 = every NPC updates every tick)
+    float getActivationDistance() const { return m_activationDistance; }
+
+    // World: pathfinding node expansions one map may spend per tick; NPCs
+    // that find it spent retry next tick (0 = unlimited)
+    uint32_t getPathBudget() const { return m_pathBudget; }
+
+    // World: load every map at startup instead of on first entry, on this
+    // many threads (0 = one per core)
+    bool getPreloadMaps() const { return m_preloadMaps; }
+    int getMapLoadThreads() const { return m_mapLoadThreads; }
+
+    // World: unload a map and its NPCs after this many seconds without
+    // players (0 = never; the default start map always stays)
+    float getMapIdleUnload() const { return m_mapIdleUnload; }
+
+    // Inbound packet capture file (empty = off)
+    const std::string& getCaptureFile() const { return m_captureFile; }
+
     // Logging
     const std::string& getLogLevel() const { return m_logLevel; }
 
@@ -34,6 +72,23 @@ private:
     std::string m_mapsPath = "../game/maps";
     std::string m_serverDbPath = "data/server.db";
     std::string m_logLevel = "info";
+    size_t m_sendQueueLimitKB = 256;
+    int m_ioThreads = 2;
+    std::string m_entityUpdates = "batched";
+    std::string m_captureFile;
+    float m_viewDistance = 20.0f;
+    std::unordered_map<int, float> m_mapViewDistance;
+    int m_mapThreads = 2;
+    float m_activationDistance = 28.0f;
+    uint32_t m_pathBudget = 20000;
+    bool m_preloadMaps = true;
+    int m_mapLoadThreads = 0;
+    float m_mapIdleUnload = 0.0f;
+#if defined(__linux__)
+    std::string m_networkBackend = "epoll";
+#else
+    std::string m_networkBackend = "sfml";
+#endif
 };
 
 #define sConfig Config::instance()
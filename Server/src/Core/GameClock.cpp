@@ -4,6 +4,7 @@
 #include "stdafx.h"
 #include "Core/GameClock.h"
 #include "Core/Logger.h"
+#include <cmath>
 
 GameClock& GameClock::instance()
 {
@@ -15,6 +16,7 @@ void GameClock::start()
 {
     m_startTime = Clock::now();
     m_lastTickTime = m_startTime;
+    m_lastUpdateTime = m_startTime;
     m_currentTime = m_startTime;
     m_tickCount = 0;
     m_accumulator = 0.0f;
@@ -32,9 +34,19 @@ bool GameClock::tick()
 
     m_currentTime = Clock::now();
 
-    // Calculate time since last frame
-    auto elapsed = std::chrono::duration<float>(m_currentTime - m_lastTickTime);
+    if (m_fixedStep) {
+        m_lastUpdateTime = m_currentTime;
+        m_lastTickTime = m_currentTime;
+        m_deltaTime = m_tickInterval;
+        m_tickCount++;
+        return true;
+    }
+
+    // Calculate time since the previous call (not the previous tick, which
+    // would count the same interval again on every call between ticks)
+    auto elapsed = std::chrono::duration<float>(m_currentTime - m_lastUpdateTime);
     float frameTime = elapsed.count();
+    m_lastUpdateTime = m_currentTime;
 
     // Cap frame time to prevent spiral of death
     const float maxFrameTime = 0.25f; // 250ms max
@@ -62,6 +74,22 @@ bool GameClock::tick()
     return false;
 }
 
+int GameClock::getMillisecondsUntilNextTick() const
+{
+    if (!m_started || m_fixedStep) {
+        return 0;
+    }
+
+    auto sinceUpdate = std::chrono::duration<float>(Clock::now() - m_lastUpdateTime).count();
+    float remaining = m_tickInterval - m_accumulator - sinceUpdate;
+    if (remaining <= 0.0f) {
+        return 0;
+    }
+
+    // Round up so callers never spin on a 0ms wait just before the tick
+    return static_cast<int>(std::ceil(remaining * 1000.0f));
+}
+
 double GameClock::getElapsedTime() const
 {
     auto elapsed = std::chrono::duration<double>(Clock::now() - m_startTime);
@@ -17,6 +17,10 @@ public:
     // Update the clock and return true if a tick has passed
     bool tick();
 
+    // Milliseconds until the next tick is due (0 if already due), for sleeping
+    // between ticks
+    int getMillisecondsUntilNextTick() const;
+
     // Get delta time since last tick (in seconds)
     float getDeltaTime() const { return m_deltaTime; }
 
@@ -34,6 +38,10 @@ public:
     int getTickRate() const { return m_tickRate; }
     float getTickInterval() const { return m_tickInterval; }
 
+    // Fixed step: every tick() call is a tick of exactly one interval,
+    // regardless of wall time (max-speed replay)
+    void setFixedStep(bool fixedStep) { m_fixedStep = fixedStep; }
+
     // Check for lag (tick took longer than expected)
     bool wasLagging() const { return m_wasLagging; }
     float getLagAmount() const { return m_lagAmount; }
@@ -49,6 +57,7 @@ private:
 
     TimePoint m_startTime;
     TimePoint m_lastTickTime;
+    TimePoint m_lastUpdateTime;     // Previous tick() call
     TimePoint m_currentTime;
 
     float m_deltaTime = 0.0f;       // Time since last tick (seconds)
@@ -62,6 +71,7 @@ private:
     float m_lagAmount = 0.0f;
 
     bool m_started = false;
+    bool m_fixedStep = false;
 };
 
 #define sGameClock GameClock::instance()
@@ -17,6 +17,9 @@ void Logger::log(LogLevel level, const char* format, ...)
     if (level < m_level)
         return;
 
+    // One line at a time; localtime() is not reentrant either
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     // Get timestamp
     time_t now = time(nullptr);
     struct tm* tm_info = localtime(&now);
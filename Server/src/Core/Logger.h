@@ -5,6 +5,7 @@
 
 #include <string>
 #include <cstdio>
+#include <mutex>
 
 enum class LogLevel
 {
@@ -25,6 +26,7 @@ public:
 private:
     Logger() = default;
     LogLevel m_level = LogLevel::Info;
+    std::mutex m_mutex;  // Map threads log too
 };
 
 #define sLogger Logger::instance()
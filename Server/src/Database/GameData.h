@@ -279,6 +279,7 @@ public:
     const QuestTemplate* getQuest(int32_t entry) const;
     const std::unordered_map<int32_t, QuestTemplate>& getAllQuests() const { return m_quests; }
     const MapTemplate* getMap(int32_t id) const;
+    const std::unordered_map<int32_t, MapTemplate>& getAllMaps() const { return m_maps; }
     const GameObjectTemplate* getGameObject(int32_t entry) const;
     const ExpLevelInfo* getExpLevel(int32_t level) const;
     const ClassLevelStats* getClassStats(int32_t classId, int32_t level) const;
@@ -85,12 +85,13 @@ static void buildPlayerPacket(GP_Server_Player& packet, const Player* player)
         const auto& item = equipSlots[slot];
         if (!item.isEmpty())
         {
-            packet.m_equipment[slot] = item.itemId;
+            packet.m_equipment.emplace_back(slot, item.itemId);
         }
     }
 
     // Add current variables (health, stats, progression, etc.)
-    packet.m_variables = player->getVariables();
+    const auto& variables = player->getVariables();
+    packet.m_variables.assign(variables.begin(), variables.end());
 }
 
 // ============================================================================
@@ -190,6 +191,7 @@ void sendPlayerSelf(Session& session)
 
     StlBuffer buf;
     uint16_t opcode = packet.getOpcode();
+    buf.reserve(sizeof(opcode) + packet.sizeHint());
     buf << opcode;
     packet.pack(buf);
     session.sendPacket(buf);
@@ -562,16 +564,14 @@ void handleRequestMove(Session& session, StlBuffer& data)
     float destX = packet.m_destX;
     float destY = packet.m_destY;
 
-    // Store old position for visibility updates
-    float oldX = player->getX();
-    float oldY = player->getY();
-
     // Basic validation - check if destination is within reasonable range
     float distance = player->distanceTo(destX, destY);
 
     // Anti-hack: Reject moves that are too far (teleport attempt)
     // Allow larger distances since client sends click destination, not next step
     constexpr float MAX_MOVE_DISTANCE = 2000.0f;  // Max click distance
+    constexpr float MOVE_WALL_MARGIN = 0.05f;     // Gap (cells) left before a wall
+    constexpr float MIN_MOVE_DISTANCE = 0.1f;     // Shorter moves are dropped
     if (distance > MAX_MOVE_DISTANCE)
     {
         LOG_WARN("Session %u: Player '%s' move rejected - distance %.1f exceeds max %.1f",
@@ -579,25 +579,61 @@ void handleRequestMove(Session& session, StlBuffer& data)
         return;
     }
 
-    // TODO: Add collision detection against map data
-    // For now, trust the client's destination
+    // Walls: the player walks a straight line, so it only gets as far as
+    // the line is clear. A player standing in a wall (old save, bad spawn)
+    // may walk out of it to any open spot.
+    if (const Map* map = player->getMap())
+    {
+        const ClearanceField& clearance = map->getClearance();
+        if (!clearance.isClear(player->getX(), player->getY()))
+        {
+            if (!clearance.isClear(destX, destY))
+            {
+                LOG_DEBUG("Session %u: Player '%s' move rejected - destination (%.1f, %.1f) is blocked",
+                          session.getId(), player->getName().c_str(), destX, destY);
+                return;
+            }
+        }
+        else
+        {
+            float clearLength = clearance.clearLength(player->getX(), player->getY(), destX, destY);
+            if (clearLength < distance)
+            {
+                // Stop just short of the first blocked cell
+                float allowed = clearLength - MOVE_WALL_MARGIN;
+                if (allowed < MIN_MOVE_DISTANCE)
+                {
+                    LOG_DEBUG("Session %u: Player '%s' move rejected - wall in the way",
+                              session.getId(), player->getName().c_str());
+                    return;
+                }
+                destX = player->getX() + (destX - player->getX()) * (allowed / distance);
+                destY = player->getY() + (destY - player->getY()) * (allowed / distance);
+                distance = allowed;
+            }
+        }
+    }
+
+    // Clients repeat the request while the button is held; the path only
+    // changes (and is only re-broadcast) when the destination does
+    if (player->isMoving())
+    {
+        MoveSpline::Point current = player->getMoveSpline().getDestination();
+        if (std::abs(current.x - destX) < 1.0f && std::abs(current.y - destY) < 1.0f)
+            return;
+    }
 
     // Update orientation to face movement direction (Task 4.9)
     player->updateOrientationFromMovement(destX, destY);
 
-    // Update player's target destination (actual position update happens over time)
-    // For simplicity, we'll update position immediately since we don't have
-    // server-side movement interpolation yet
-    player->setPosition(destX, destY);
-    player->setMoving(true);
-    player->markDirty();  // Position changed, needs save
+    // Walk there from where the player is now. Player::update advances the
+    // position each tick, so visibility, aggro and range checks see the
+    // player where it actually is.
+    player->moveTo(destX, destY);
 
     // Broadcast movement to all players who can see this player
     broadcastMovement(player, destX, destY);
 
-    // Update visibility based on new position
-    sWorldManager.onPlayerMoved(player, oldX, oldY);
-
     LOG_DEBUG("Session %u: Player '%s' moving to (%.1f, %.1f), distance=%.1f",
               session.getId(), player->getName().c_str(), destX, destY, distance);
 }
@@ -613,8 +649,12 @@ void handleRequestStop(Session& session, StlBuffer& data)
         return;
     }
 
-    // Player stopped moving
-    player->setMoving(false);
+    // Already standing: nothing changed, nothing to re-broadcast
+    if (!player->isMoving())
+        return;
+
+    // Player stopped moving, at the position walked so far
+    player->stopMoving();
 
     // Broadcast stop to visible players
     broadcastStop(player);
@@ -779,12 +819,9 @@ void sendSpellGo(Player* caster, int32_t spellId, const std::vector<std::pair<En
     caster->sendPacket(buf);
 
     // Send to all visible players
-    for (Entity* viewer : caster->getVisibleTo())
+    for (Player* viewer : sWorldManager.resolvePlayers(caster->getVisibleTo()))
     {
-        if (Player* viewerPlayer = dynamic_cast<Player*>(viewer))
-        {
-            viewerPlayer->sendPacket(buf);
-        }
+        viewer->sendPacket(buf);
     }
 }
 
@@ -827,16 +864,17 @@ void handleSetSelected(Session& session, StlBuffer& data)
                     const auto* item = equipment.getItem(static_cast<UnitDefines::EquipSlot>(slot));
                     if (item && !item->isEmpty())
                     {
-                        inspectPacket.m_equipment[slot] = item->itemId;
+                        inspectPacket.m_equipment.emplace_back(slot, item->itemId);
                     }
                 }
 
                 // Add key variables for display
-                inspectPacket.m_variables[static_cast<int32_t>(ObjDefines::Variable::Level)] = target->getLevel();
-                inspectPacket.m_variables[static_cast<int32_t>(ObjDefines::Variable::MaxHealth)] = target->getMaxHealth();
-                inspectPacket.m_variables[static_cast<int32_t>(ObjDefines::Variable::MaxMana)] = target->getMaxMana();
-                inspectPacket.m_variables[static_cast<int32_t>(ObjDefines::Variable::Health)] = target->getHealth();
-                inspectPacket.m_variables[static_cast<int32_t>(ObjDefines::Variable::Mana)] = target->getMana();
+                inspectPacket.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::Level), target->getLevel());
+                inspectPacket.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::MaxHealth), target->getMaxHealth());
+                inspectPacket.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::MaxMana), target->getMaxMana());
+                inspectPacket.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::Health), target->getHealth());
+                inspectPacket.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::Mana), target->getMana());
+                sortPacketPairs(inspectPacket.m_variables);
 
                 // Send to inspector
                 StlBuffer buf;
@@ -1294,7 +1332,7 @@ void handleCastSpell(Session& session, StlBuffer& data)
                         if (npc->getAIState() != NpcAIState::Combat)
                             continue;
 
-                        if (npc->getTarget() == healedPlayer ||
+                        if (npc->getTargetGuid() == healedPlayer->getGuid() ||
                             npc->getThreatManager().getThreat(healedPlayer) > 0)
                         {
                             npc->addThreat(caster, heal.finalHeal);
@@ -1481,7 +1519,7 @@ void executePendingCast(Player* caster, int32_t spellId, uint32_t targetGuid)
                     if (npc->getAIState() != NpcAIState::Combat)
                         continue;
 
-                    if (npc->getTarget() == healedPlayer ||
+                    if (npc->getTargetGuid() == healedPlayer->getGuid() ||
                         npc->getThreatManager().getThreat(healedPlayer) > 0)
                     {
                         npc->addThreat(caster, heal.finalHeal);
@@ -2378,6 +2416,7 @@ void sendBank(Session& session)
 
     StlBuffer buf;
     uint16_t opcode = bankPacket.getOpcode();
+    buf.reserve(sizeof(opcode) + bankPacket.sizeHint());
     buf << opcode;
     bankPacket.pack(buf);
     player->sendPacket(buf);
@@ -3093,8 +3132,9 @@ void handleQueryWaypoints(Session& session, StlBuffer& data)
         while (waypointStmt.step())
         {
             const int32_t waypointId = waypointStmt.getInt(0);
-            if (discovered.find(waypointId) != discovered.end())
-                response.m_guids.push_back(waypointId);
+            if (discovered.find(waypointId) == discovered.end())
+                continue;
+            response.m_guids.push_back(waypointId);
         }
     }
 
@@ -56,10 +56,11 @@ void broadcastMovement(Player* player, float destX, float destY);
 // Helper: Broadcast stop to all visible players
 void broadcastStop(Player* player);
 
-// Movement constants
-constexpr float DEFAULT_MOVE_SPEED = 200.0f;  // Pixels per second
-constexpr float MAX_MOVE_SPEED = 400.0f;      // Anti-hack limit
-constexpr float POSITION_TOLERANCE = 50.0f;   // Allowed desync distance
+// Movement constants (world positions are map cells; the client walks
+// 200 px/s over 64 px cells)
+constexpr float DEFAULT_MOVE_SPEED = 3.125f;  // Cells per second
+constexpr float MAX_MOVE_SPEED = 6.25f;       // Anti-hack limit
+constexpr float POSITION_TOLERANCE = 0.75f;   // Allowed desync distance (cells)
 
 // ============================================================================
 // Respawn Handler (Task 5.12)
@@ -0,0 +1,176 @@
+// Epoll Reactor - Linux edge-triggered readiness backend
+
+#include "stdafx.h"
+#include "Network/EpollReactor.h"
+
+#if defined(__linux__)
+
+#include "Network/Session.h"
+#include "Core/Logger.h"
+#include "SfSocket.h"
+#include <SFML/Network/TcpListener.hpp>
+#include <sys/eventfd.h>
+#include <cerrno>
+#include <unistd.h>
+
+EpollReactor::EpollReactor()
+    : m_events(INITIAL_EVENT_CAPACITY)
+{
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epollFd < 0)
+    {
+        LOG_ERROR("epoll_create1 failed: %s", std::strerror(errno));
+        return;
+    }
+
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wakeFd < 0)
+    {
+        LOG_ERROR("eventfd failed: %s", std::strerror(errno));
+        return;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = WAKEUP_TOKEN;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &ev) < 0)
+    {
+        LOG_ERROR("epoll_ctl(ADD eventfd) failed: %s", std::strerror(errno));
+        ::close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+}
+
+EpollReactor::~EpollReactor()
+{
+    if (m_wakeFd >= 0)
+    {
+        ::close(m_wakeFd);
+    }
+    if (m_epollFd >= 0)
+    {
+        ::close(m_epollFd);
+    }
+}
+
+void EpollReactor::wakeup()
+{
+    uint64_t one = 1;
+    ssize_t written = ::write(m_wakeFd, &one, sizeof(one));
+    (void)written;  // EAGAIN means a wakeup is already pending
+}
+
+bool EpollReactor::onListen()
+{
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLET;
+    ev.data.u64 = LISTENER_TOKEN;
+
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, SfSocket::getNativeHandle(*m_listener), &ev) < 0)
+    {
+        LOG_ERROR("epoll_ctl(ADD listener) failed: %s", std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void EpollReactor::onClose()
+{
+    epoll_ctl(m_epollFd, EPOLL_CTL_DEL, SfSocket::getNativeHandle(*m_listener), nullptr);
+}
+
+bool EpollReactor::watch(Session& session)
+{
+    SfSocket* socket = session.getSocket();
+    if (!socket)
+        return false;
+
+    // Edge-triggered: SfSocket::receive drains the socket until it would block,
+    // and EPOLLOUT only fires when a full send buffer drains again
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    ev.data.u64 = session.getId();
+
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, socket->getNativeHandle(), &ev) < 0)
+    {
+        LOG_ERROR("Session %u: epoll_ctl(ADD) failed: %s", session.getId(), std::strerror(errno));
+        return false;
+    }
+
+    m_watched[session.getId()] = &session;
+    return true;
+}
+
+void EpollReactor::unwatch(Session& session)
+{
+    if (m_watched.erase(session.getId()) == 0)
+        return;
+
+    // A closed socket has already left the epoll set; its handle is invalid
+    SfSocket* socket = session.getSocket();
+    if (!socket)
+        return;
+
+    int fd = socket->getNativeHandle();
+    if (fd >= 0)
+    {
+        epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+}
+
+void EpollReactor::poll(int timeoutMs, Events& events)
+{
+    events.clear();
+
+    int count = epoll_wait(m_epollFd, m_events.data(), static_cast<int>(m_events.size()), timeoutMs);
+    if (count < 0)
+    {
+        if (errno != EINTR)
+            LOG_ERROR("epoll_wait failed: %s", std::strerror(errno));
+        return;
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        const epoll_event& ev = m_events[i];
+
+        if (ev.data.u64 == LISTENER_TOKEN)
+        {
+            // Drain the whole accept backlog - edge-triggered won't report it again
+            acceptPending(events.accepted);
+            continue;
+        }
+
+        if (ev.data.u64 == WAKEUP_TOKEN)
+        {
+            // Level-triggered: reset the counter so the next wait blocks again
+            uint64_t count;
+            ssize_t got = ::read(m_wakeFd, &count, sizeof(count));
+            (void)got;
+            continue;
+        }
+
+        // Session may already be unwatched if it was removed after the event was queued
+        auto it = m_watched.find(static_cast<uint32_t>(ev.data.u64));
+        if (it == m_watched.end())
+            continue;
+
+        Session* session = it->second;
+        if (ev.events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+        {
+            events.readable.push_back(session);
+        }
+        if ((ev.events & EPOLLOUT) && session->hasPendingOutput())
+        {
+            events.writable.push_back(session);
+        }
+    }
+
+    // A full batch suggests more events are pending; widen the next wait
+    if (static_cast<size_t>(count) == m_events.size())
+    {
+        m_events.resize(m_events.size() * 2);
+    }
+}
+
+#endif // __linux__
@@ -0,0 +1,50 @@
+// Epoll Reactor - Linux edge-triggered readiness backend
+// Each wakeup costs O(ready sockets): epoll hands back the session id stored
+// with the fd, so idle connections are never scanned. An eventfd in the set
+// lets other threads interrupt epoll_wait (see wakeup()).
+
+#pragma once
+
+#if defined(__linux__)
+
+#include "Network/NetReactor.h"
+#include <sys/epoll.h>
+#include <unordered_map>
+
+class EpollReactor : public NetReactor
+{
+public:
+    EpollReactor();
+    ~EpollReactor() override;
+
+    // False if epoll_create1 or eventfd failed
+    bool isValid() const { return m_epollFd >= 0 && m_wakeFd >= 0; }
+
+    const char* getName() const override { return "epoll"; }
+
+    void poll(int timeoutMs, Events& events) override;
+    bool watch(Session& session) override;
+    void unwatch(Session& session) override;
+
+    bool canWakeup() const override { return true; }
+    void wakeup() override;
+
+protected:
+    bool onListen() override;
+    void onClose() override;
+
+private:
+    // Event tokens for the listener and wakeup eventfd; session ids start at 1
+    static constexpr uint64_t LISTENER_TOKEN = 0;
+    static constexpr uint64_t WAKEUP_TOKEN = ~0ULL;
+
+    // Initial epoll_wait batch size (grows when a wakeup fills it)
+    static constexpr size_t INITIAL_EVENT_CAPACITY = 256;
+
+    int m_epollFd = -1;
+    int m_wakeFd = -1;
+    std::vector<epoll_event> m_events;
+    std::unordered_map<uint32_t, Session*> m_watched;
+};
+
+#endif // __linux__
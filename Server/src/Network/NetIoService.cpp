@@ -0,0 +1,631 @@
+// Network I/O Service - Socket reads and writes off the tick thread
+
+#include "stdafx.h"
+#include "Network/NetIoService.h"
+#include "Network/NetReactor.h"
+#include "Network/PacketCapture.h"
+#include "Network/PacketRouter.h"
+#include "Network/Session.h"
+#include "Network/SessionManager.h"
+#include "Core/GameClock.h"
+#include "Core/Logger.h"
+#include "SfSocket.h"
+#include "StlBuffer.h"
+#include <thread>
+#include <unordered_set>
+
+// ============================================================================
+// NetIoWorker - one I/O thread (or the tick thread in inline mode) and the
+// sessions it owns. Only this worker touches those sessions' sockets.
+// ============================================================================
+
+class NetIoWorker
+{
+public:
+    NetIoWorker(uint32_t index, std::unique_ptr<NetReactor> reactor)
+        : m_index(index)
+        , m_reactor(std::move(reactor))
+    {
+    }
+
+    NetReactor& getReactor() { return *m_reactor; }
+
+    void startThread();
+    void stopThread();
+
+    // One round of socket I/O: wait up to timeoutMs for readiness, then read
+    // and write the sessions that are ready
+    void runOnce(int timeoutMs);
+
+    // Thread-safe: queue work for this worker and wake it
+    void postAdopt(Session& session);
+    void postOutput(const std::vector<Session*>& sessions);
+    void postRelease(Session& session);
+
+    // Apply posted commands. Called by the owning thread (or by the tick
+    // thread in inline mode, where that is the same thing).
+    void processCommands();
+
+private:
+    enum class CommandType { Adopt, Output, Release };
+
+    struct Command
+    {
+        CommandType type;
+        Session* session;
+    };
+
+    // Poll timeout when idle; backends that cannot be woken poll quickly so
+    // posted output is not left waiting
+    static constexpr int IDLE_POLL_MS = 100;
+    static constexpr int NO_WAKEUP_POLL_MS = 1;
+
+    void run();
+    void post(CommandType type, Session& session);
+
+    void adopt(Session& session);
+    void release(Session& session);
+    void readInput(Session& session);
+    void writeOutput(Session& session);
+    bool queueBatch(SfSocket& socket, const PacketBatch& batch);
+    void stall(Session& session);
+
+    uint32_t m_index;
+    std::unique_ptr<NetReactor> m_reactor;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+
+    std::mutex m_commandMutex;
+    std::vector<Command> m_commands;
+    std::vector<Command> m_processing;
+
+    NetReactor::Events m_events;
+    std::vector<SfSocket::PacketView> m_packets;
+
+    // Sessions whose inbound queue was full; retried every round
+    std::vector<Session*> m_stalled;
+    std::vector<Session*> m_retry;
+
+    // A release can overtake the adopt for a brand-new session; remember it
+    // until the adopt arrives so the session is never touched after release
+    std::unordered_set<Session*> m_adopted;
+    std::unordered_set<Session*> m_releasedEarly;
+};
+
+void NetIoWorker::startThread()
+{
+    m_running = true;
+    m_thread = std::thread(&NetIoWorker::run, this);
+}
+
+void NetIoWorker::stopThread()
+{
+    if (!m_running.exchange(false))
+        return;
+
+    m_reactor->wakeup();
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+void NetIoWorker::run()
+{
+    const int timeoutMs = m_reactor->canWakeup() ? IDLE_POLL_MS : NO_WAKEUP_POLL_MS;
+
+    while (m_running.load(std::memory_order_acquire)) {
+        try {
+            runOnce(timeoutMs);
+        } catch (const std::exception& e) {
+            LOG_ERROR("I/O thread %u exception: %s", m_index, e.what());
+        } catch (...) {
+            LOG_ERROR("I/O thread %u: unknown exception", m_index);
+        }
+    }
+
+    // Apply anything posted while shutting down (e.g. releases)
+    processCommands();
+}
+
+void NetIoWorker::runOnce(int timeoutMs)
+{
+    processCommands();
+
+    if (!m_stalled.empty())
+        timeoutMs = std::min(timeoutMs, NO_WAKEUP_POLL_MS);
+
+    m_reactor->poll(timeoutMs, m_events);
+
+    // Only worker 0 listens; it deals new sessions out to their owners
+    for (Session* session : m_events.accepted) {
+        sNetIo.assignSession(*session);
+    }
+    if (!m_events.accepted.empty())
+        processCommands();
+
+    for (Session* session : m_events.readable) {
+        readInput(*session);
+    }
+
+    for (Session* session : m_events.writable) {
+        writeOutput(*session);
+    }
+
+    // Retry sessions the tick thread was behind on
+    if (!m_stalled.empty()) {
+        m_retry.swap(m_stalled);
+        m_stalled.clear();
+        for (Session* session : m_retry) {
+            readInput(*session);
+        }
+        m_retry.clear();
+    }
+}
+
+void NetIoWorker::post(CommandType type, Session& session)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_commandMutex);
+        m_commands.push_back(Command{type, &session});
+    }
+    if (m_running.load(std::memory_order_relaxed))
+        m_reactor->wakeup();
+}
+
+void NetIoWorker::postAdopt(Session& session)
+{
+    post(CommandType::Adopt, session);
+}
+
+void NetIoWorker::postRelease(Session& session)
+{
+    post(CommandType::Release, session);
+}
+
+void NetIoWorker::postOutput(const std::vector<Session*>& sessions)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_commandMutex);
+        for (Session* session : sessions) {
+            m_commands.push_back(Command{CommandType::Output, session});
+        }
+    }
+    if (m_running.load(std::memory_order_relaxed))
+        m_reactor->wakeup();
+}
+
+void NetIoWorker::processCommands()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_commandMutex);
+        if (m_commands.empty())
+            return;
+        m_processing.swap(m_commands);
+    }
+
+    for (const Command& command : m_processing) {
+        switch (command.type) {
+            case CommandType::Adopt:   adopt(*command.session); break;
+            case CommandType::Output:  writeOutput(*command.session); break;
+            case CommandType::Release: release(*command.session); break;
+        }
+    }
+    m_processing.clear();
+}
+
+void NetIoWorker::adopt(Session& session)
+{
+    if (m_releasedEarly.erase(&session)) {
+        session.closeSocket();
+        session.getChannel().released.store(true, std::memory_order_release);
+        return;
+    }
+
+    m_adopted.insert(&session);
+    if (!m_reactor->watch(session)) {
+        session.closeSocket();
+        return;
+    }
+
+    // Anything that arrived between accept and watch
+    readInput(session);
+}
+
+void NetIoWorker::release(Session& session)
+{
+    if (!m_adopted.erase(&session)) {
+        m_releasedEarly.insert(&session);
+        return;
+    }
+
+    // Last chance for queued output (e.g. a kick reason)
+    writeOutput(session);
+
+    m_reactor->unwatch(session);
+    m_stalled.erase(std::remove(m_stalled.begin(), m_stalled.end(), &session), m_stalled.end());
+    session.closeSocket();
+
+    // After this store the tick thread may destroy the session
+    session.getChannel().released.store(true, std::memory_order_release);
+}
+
+void NetIoWorker::stall(Session& session)
+{
+    if (std::find(m_stalled.begin(), m_stalled.end(), &session) == m_stalled.end())
+        m_stalled.push_back(&session);
+}
+
+void NetIoWorker::readInput(Session& session)
+{
+    SessionChannel& channel = session.getChannel();
+    SfSocket* socket = session.getSocket();
+    if (!socket || !channel.open.load(std::memory_order_relaxed))
+        return;
+
+    do {
+        if (!channel.inbound.canPush()) {
+            // Tick thread is behind; leave the rest in the socket for now
+            stall(session);
+            return;
+        }
+
+        m_packets.clear();
+        socket->receive(m_packets);
+
+        if (!m_packets.empty()) {
+            // Reuse a buffer the tick thread has finished with when one is back
+            PacketBatch batch;
+            channel.inboundFree.pop(batch);
+            batch.clear();
+
+            // [4 bytes: size (native order, never leaves the process)] [packet]
+            for (const SfSocket::PacketView& packet : m_packets) {
+                uint32_t size = static_cast<uint32_t>(packet.size);
+                const uint8_t* sizeBytes = reinterpret_cast<const uint8_t*>(&size);
+                batch.bytes.insert(batch.bytes.end(), sizeBytes, sizeBytes + sizeof(size));
+                batch.bytes.insert(batch.bytes.end(), packet.data, packet.data + packet.size);
+            }
+            batch.count = static_cast<uint32_t>(m_packets.size());
+            batch.receivedAt = std::chrono::steady_clock::now();
+
+            channel.inbound.push(std::move(batch));
+        }
+
+        // SessionManager::update() removes the session on the next tick
+        if (!socket->isConnected()) {
+            channel.open.store(false, std::memory_order_release);
+            return;
+        }
+    } while (socket->hasUnreadInput());
+}
+
+bool NetIoWorker::queueBatch(SfSocket& socket, const PacketBatch& batch)
+{
+    if (batch.shared.empty())
+        return socket.queueFrames(batch.bytes.data(), batch.bytes.size(), batch.count);
+
+    // Copied frames go in as runs between the shared ones
+    uint32_t copiedFrames = batch.count - static_cast<uint32_t>(batch.shared.size());
+    size_t offset = 0;
+    for (const PacketBatch::SharedRef& ref : batch.shared) {
+        if (ref.offset > offset) {
+            if (!socket.queueFrames(batch.bytes.data() + offset, ref.offset - offset, copiedFrames))
+                return false;
+            copiedFrames = 0;
+            offset = ref.offset;
+        }
+        if (!socket.queueShared(ref.packet, ref.packet->data(), ref.packet->size()))
+            return false;
+    }
+
+    if (offset < batch.bytes.size())
+        return socket.queueFrames(batch.bytes.data() + offset, batch.bytes.size() - offset, copiedFrames);
+    return true;
+}
+
+void NetIoWorker::writeOutput(Session& session)
+{
+    SessionChannel& channel = session.getChannel();
+    SfSocket* socket = session.getSocket();
+
+    uint64_t writesBefore = socket ? socket->getSendQueue().getStats().writeCalls : 0;
+    uint64_t frames = 0;
+
+    PacketBatch batch;
+    while (channel.outbound.pop(batch)) {
+        frames += batch.count;
+        if (socket && channel.open.load(std::memory_order_relaxed) && !queueBatch(*socket, batch)) {
+            // The client is not draining its socket
+            LOG_WARN("Session %u: Send queue full (%zu bytes), dropping slow consumer",
+                     session.getId(), socket->getSendQueue().size());
+            session.closeSocket();
+        }
+
+        batch.clear();
+        channel.outboundFree.push(std::move(batch));
+    }
+
+    if (!socket || !channel.open.load(std::memory_order_relaxed))
+        return;
+
+    if (!socket->flush()) {
+        channel.open.store(false, std::memory_order_release);
+    }
+    sNetIo.recordWrites(frames, socket->getSendQueue().getStats().writeCalls - writesBefore);
+
+    channel.bytesSent.store(socket->getSendQueue().getStats().bytesSent, std::memory_order_relaxed);
+    channel.sendQueueDepth.store(socket->getSendQueue().size(), std::memory_order_relaxed);
+}
+
+// ============================================================================
+// NetIoService
+// ============================================================================
+
+NetIoService& NetIoService::instance()
+{
+    static NetIoService instance;
+    return instance;
+}
+
+NetIoService::NetIoService() = default;
+
+NetIoService::~NetIoService()
+{
+    stop();
+}
+
+bool NetIoService::start(uint16_t port, const std::string& backend, int threadCount)
+{
+    m_threaded = threadCount > 0;
+    size_t workerCount = m_threaded ? static_cast<size_t>(threadCount) : 1;
+
+    for (size_t i = 0; i < workerCount; ++i) {
+        m_workers.push_back(std::make_unique<NetIoWorker>(
+            static_cast<uint32_t>(i), NetReactor::create(backend)));
+    }
+
+    if (!m_workers[0]->getReactor().listen(port)) {
+        m_workers.clear();
+        return false;
+    }
+
+    m_outputByWorker.resize(workerCount);
+    m_running = true;
+
+    if (m_threaded) {
+        for (auto& worker : m_workers) {
+            worker->startThread();
+        }
+        LOG_INFO("Network: %zu I/O thread(s), %s backend", workerCount, getBackendName());
+    } else {
+        LOG_INFO("Network: I/O on tick thread, %s backend", getBackendName());
+    }
+    return true;
+}
+
+void NetIoService::stop()
+{
+    if (!m_running)
+        return;
+
+    m_workers[0]->getReactor().close();
+
+    for (auto& worker : m_workers) {
+        worker->stopThread();
+    }
+    if (!m_threaded) {
+        m_workers[0]->processCommands();
+    }
+
+    m_running = false;
+    m_workers.clear();
+}
+
+const char* NetIoService::getBackendName() const
+{
+    return m_workers.empty() ? "none" : m_workers[0]->getReactor().getName();
+}
+
+NetIoWorker& NetIoService::workerFor(const Session& session)
+{
+    return *m_workers[session.getId() % m_workers.size()];
+}
+
+void NetIoService::poll(int timeoutMs)
+{
+    if (!m_running)
+        return;
+
+    if (m_threaded) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+    } else {
+        m_workers[0]->runOnce(timeoutMs);
+    }
+}
+
+void NetIoService::assignSession(Session& session)
+{
+    workerFor(session).postAdopt(session);
+}
+
+void NetIoService::processInput()
+{
+    // Sessions are only destroyed on this thread, so the pointers stay valid
+    // while handlers run outside the session lock
+    m_inputSessions.clear();
+    sSessionManager.forEachSession([this](Session& session) {
+        if (!session.getChannel().inbound.empty())
+            m_inputSessions.push_back(&session);
+    });
+
+    StlBuffer packet;
+    for (Session* session : m_inputSessions) {
+        SessionChannel& channel = session->getChannel();
+
+        try {
+            PacketBatch batch;
+            while (channel.inbound.pop(batch)) {
+                auto waited = std::chrono::steady_clock::now() - batch.receivedAt;
+                uint64_t waitedUs = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(waited).count());
+
+                const uint8_t* cursor = batch.bytes.data();
+                const uint8_t* end = cursor + batch.bytes.size();
+                while (cursor < end) {
+                    uint32_t size;
+                    std::memcpy(&size, cursor, sizeof(size));
+                    cursor += sizeof(size);
+
+                    m_inputLatency.record(waitedUs);
+
+                    // SfSocket only frames packets of 2+ bytes (the opcode)
+                    packet.setView(cursor, size);
+                    cursor += size;
+
+                    if (sPacketCapture.isOpen()) {
+                        sPacketCapture.recordPacket(session->getId(), sGameClock.getTickCount(),
+                                                    batch.receivedAt, cursor - size, size);
+                    }
+
+                    uint16_t opcode;
+                    packet >> opcode;
+                    sPacketRouter.dispatch(*session, opcode, packet);
+                }
+
+                batch.clear();
+                channel.inboundFree.push(std::move(batch));
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("Session %u: Network error: %s", session->getId(), e.what());
+            session->markForRemoval();
+        } catch (...) {
+            LOG_ERROR("Session %u: Unknown network error", session->getId());
+            session->markForRemoval();
+        }
+    }
+}
+
+bool NetIoService::queueOutput(Session& session)
+{
+    SessionChannel& channel = session.getChannel();
+    if (channel.staging.empty())
+        return true;
+
+    // Nobody left to deliver to
+    if (!m_running || !channel.open.load(std::memory_order_acquire)) {
+        channel.staging.clear();
+        return true;
+    }
+
+    uint32_t frames = channel.staging.count;
+    if (!channel.outbound.push(std::move(channel.staging)))
+        return false;
+
+    // Everything this session was sent during the tick goes out as one batch
+    ++m_outputFlushes;
+    m_outputFrames += frames;
+
+    // Stage the next tick's output in a buffer the I/O thread has returned
+    if (!channel.outboundFree.pop(channel.staging))
+        channel.staging = PacketBatch();
+    channel.staging.clear();
+
+    m_outputByWorker[session.getId() % m_workers.size()].push_back(&session);
+    return true;
+}
+
+void NetIoService::commitOutput()
+{
+    for (size_t i = 0; i < m_outputByWorker.size(); ++i) {
+        if (m_outputByWorker[i].empty())
+            continue;
+        m_workers[i]->postOutput(m_outputByWorker[i]);
+        m_outputByWorker[i].clear();
+    }
+
+    // Inline mode: write now, in the flush phase
+    if (m_running && !m_threaded) {
+        m_workers[0]->processCommands();
+    }
+}
+
+void NetIoService::releaseSession(Session& session)
+{
+    SessionChannel& channel = session.getChannel();
+
+    if (!m_running) {
+        // No I/O threads left to hand the socket back to
+        session.closeSocket();
+        channel.released.store(true, std::memory_order_release);
+        return;
+    }
+
+    // Output must reach the worker before the release does
+    {
+        std::lock_guard<std::mutex> lock(channel.stagingMutex);
+        queueOutput(session);
+    }
+    commitOutput();
+
+    workerFor(session).postRelease(session);
+    if (!m_threaded) {
+        m_workers[0]->processCommands();
+    }
+}
+
+void NetIoService::recordWrites(uint64_t frames, uint64_t writes)
+{
+    m_framesWritten.fetch_add(frames, std::memory_order_relaxed);
+    m_writeCalls.fetch_add(writes, std::memory_order_relaxed);
+}
+
+void NetIoService::logStats()
+{
+    uint64_t framesWritten = m_framesWritten.exchange(0, std::memory_order_relaxed);
+    uint64_t writeCalls = m_writeCalls.exchange(0, std::memory_order_relaxed);
+    if (m_outputFlushes > 0) {
+        LOG_INFO("Network output: %llu frames in %llu session flushes (%.1f frames/flush), %llu writes (%.1f frames/write)",
+                 static_cast<unsigned long long>(m_outputFrames),
+                 static_cast<unsigned long long>(m_outputFlushes),
+                 static_cast<double>(m_outputFrames) / m_outputFlushes,
+                 static_cast<unsigned long long>(writeCalls),
+                 writeCalls > 0 ? static_cast<double>(framesWritten) / writeCalls : 0.0);
+        m_outputFlushes = 0;
+        m_outputFrames = 0;
+    }
+
+    if (m_inputLatency.count == 0)
+        return;
+
+    LOG_INFO("Network input: %llu packets, socket-to-handler avg %.2fms, p50 %.2fms, p99 %.2fms, max %.2fms",
+             static_cast<unsigned long long>(m_inputLatency.count),
+             m_inputLatency.totalUs / 1000.0 / m_inputLatency.count,
+             m_inputLatency.percentile(0.50) / 1000.0,
+             m_inputLatency.percentile(0.99) / 1000.0,
+             m_inputLatency.maxUs / 1000.0);
+    m_inputLatency.reset();
+}
+
+void NetIoService::LatencyStats::record(uint64_t us)
+{
+    // Bucket b holds [2^(b-1), 2^b) microseconds; bucket 0 is < 1us
+    size_t bucket = 0;
+    for (uint64_t v = us; v != 0 && bucket < BUCKETS - 1; v >>= 1)
+        ++bucket;
+
+    ++buckets[bucket];
+    ++count;
+    totalUs += us;
+    maxUs = std::max(maxUs, us);
+}
+
+uint64_t NetIoService::LatencyStats::percentile(double p) const
+{
+    uint64_t target = static_cast<uint64_t>(p * static_cast<double>(count));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen > target)
+            return std::min<uint64_t>(1ULL << i, maxUs);
+    }
+    return maxUs;
+}
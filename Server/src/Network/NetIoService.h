@@ -0,0 +1,111 @@
+// Network I/O Service - Socket reads and writes off the tick thread
+// [Network] IoThreads=N starts N I/O threads, each running its own reactor.
+// Thread 0 also owns the listener and deals new sessions out by id. The I/O
+// threads read and frame packets, then pass them to the tick thread through
+// each session's SessionChannel; the tick thread dispatches them in
+// processInput() and hands its output back in flushOutput().
+// IoThreads=0 runs the same code on the tick thread: poll() does the socket
+// work between ticks.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Session;
+class NetIoWorker;
+
+class NetIoService
+{
+public:
+    static NetIoService& instance();
+
+    // Create reactors, bind the listener and start the I/O threads
+    bool start(uint16_t port, const std::string& backend, int threadCount);
+
+    // Close the listener and join the I/O threads. Sockets still open are
+    // left to SessionManager::disconnectAll().
+    void stop();
+
+    bool isThreaded() const { return m_threaded; }
+    const char* getBackendName() const;
+    size_t getThreadCount() const { return m_threaded ? m_workers.size() : 0; }
+
+    // Main loop wait. Inline mode does socket I/O for up to timeoutMs; with
+    // I/O threads the tick thread just sleeps.
+    void poll(int timeoutMs);
+
+    // ---- Tick thread phases ----
+
+    // Dispatch every packet received since the last call
+    void processInput();
+
+    // Hand a session's staged output to its I/O thread. Returns false if the
+    // channel is full (retry next tick). Caller holds the channel's
+    // stagingMutex.
+    bool queueOutput(Session& session);
+
+    // Wake the I/O threads that were handed output since the last call
+    void commitOutput();
+
+    // Called when a session is removed: its I/O thread flushes what it can,
+    // closes the socket and then sets the channel's `released` flag. The
+    // session must stay alive until then.
+    void releaseSession(Session& session);
+
+    // Log socket-to-handler latency and output coalescing since the previous call
+    void logStats();
+
+    // ---- I/O thread side ----
+
+    // Route a newly accepted session to the I/O thread that will own it
+    void assignSession(Session& session);
+
+    // Count frames handed to a socket and the write syscalls spent on them
+    void recordWrites(uint64_t frames, uint64_t writes);
+
+private:
+    NetIoService();
+    ~NetIoService();
+
+    NetIoWorker& workerFor(const Session& session);
+
+    // Socket-to-handler latency (tick thread only): log2 microsecond buckets
+    struct LatencyStats
+    {
+        static constexpr size_t BUCKETS = 32;
+        std::array<uint64_t, BUCKETS> buckets{};
+        uint64_t count = 0;
+        uint64_t totalUs = 0;
+        uint64_t maxUs = 0;
+
+        void record(uint64_t us);
+        uint64_t percentile(double p) const;  // Upper bound of the bucket
+        void reset() { *this = LatencyStats(); }
+    };
+
+    std::vector<std::unique_ptr<NetIoWorker>> m_workers;
+    bool m_threaded = false;
+    bool m_running = false;
+
+    // Sessions handed output this tick, per worker
+    std::vector<std::vector<Session*>> m_outputByWorker;
+
+    // processInput() scratch
+    std::vector<Session*> m_inputSessions;
+
+    LatencyStats m_inputLatency;
+
+    // Output coalescing: frames per session flush (tick thread) and frames
+    // per write syscall (I/O threads)
+    uint64_t m_outputFlushes = 0;
+    uint64_t m_outputFrames = 0;
+    std::atomic<uint64_t> m_framesWritten{0};
+    std::atomic<uint64_t> m_writeCalls{0};
+};
+
+#define sNetIo NetIoService::instance()
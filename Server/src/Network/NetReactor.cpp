@@ -0,0 +1,108 @@
+// Network Reactor - Waits for socket readiness and accepts connections
+// Backends: epoll (Linux, edge-triggered) and sf::SocketSelector (portable fallback)
+
+#include "stdafx.h"
+#include "Network/NetReactor.h"
+#include "Network/EpollReactor.h"
+#include "Network/SfmlReactor.h"
+#include "Network/Session.h"
+#include "Network/SessionManager.h"
+#include "Core/Logger.h"
+#include "SfSocket.h"
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+
+NetReactor::NetReactor() = default;
+
+NetReactor::~NetReactor() = default;
+
+std::unique_ptr<NetReactor> NetReactor::create(const std::string& backend)
+{
+    if (backend == "epoll")
+    {
+#if defined(__linux__)
+        auto reactor = std::make_unique<EpollReactor>();
+        if (reactor->isValid())
+            return reactor;
+        LOG_WARN("epoll backend failed to initialize, falling back to sfml");
+#else
+        LOG_WARN("epoll backend is only available on Linux, falling back to sfml");
+#endif
+    }
+    else if (backend != "sfml")
+    {
+        LOG_WARN("Unknown network backend '%s', falling back to sfml", backend.c_str());
+    }
+
+    return std::make_unique<SfmlReactor>();
+}
+
+bool NetReactor::listen(uint16_t port)
+{
+    m_listener = std::make_unique<sf::TcpListener>();
+    m_listener->setBlocking(false);
+
+    if (m_listener->listen(port) != sf::Socket::Done)
+    {
+        m_listener.reset();
+        return false;
+    }
+
+    if (!onListen())
+    {
+        m_listener->close();
+        m_listener.reset();
+        return false;
+    }
+
+    m_listening = true;
+    return true;
+}
+
+void NetReactor::close()
+{
+    if (!m_listening)
+        return;
+
+    onClose();
+    m_listener->close();
+    m_listening = false;
+}
+
+void NetReactor::acceptPending(std::vector<Session*>& accepted)
+{
+    if (!m_listening)
+        return;
+
+    // The listener is non-blocking, so accept() reports NotReady once the
+    // backlog is empty
+    while (true)
+    {
+        auto socket = std::make_unique<SfSocket>(SfSocket::Type::ServerSide);
+        sf::TcpSocket* rawSocket = socket->getSocket();
+
+        sf::Socket::Status status = m_listener->accept(*rawSocket);
+        if (status != sf::Socket::Done)
+        {
+            if (status != sf::Socket::NotReady)
+                LOG_WARN("Failed to accept connection");
+            break;
+        }
+
+        rawSocket->setBlocking(false);
+        socket->setNoDelay(true);
+        std::string address = rawSocket->getRemoteAddress().toString();
+
+        // The session is only published once it owns its socket
+        Session* session = sSessionManager.createSession(std::move(socket));
+        if (!session)
+        {
+            // Dropping the socket closes the connection
+            LOG_WARN("Connection rejected (server full)");
+            continue;
+        }
+
+        LOG_INFO("Session %u connected from %s", session->getId(), address.c_str());
+        accepted.push_back(session);
+    }
+}
@@ -0,0 +1,81 @@
+// Network Reactor - Waits for socket readiness and accepts connections
+// Backends: epoll (Linux, edge-triggered) and sf::SocketSelector (portable fallback)
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sf { class TcpListener; }
+
+class Session;
+
+class NetReactor
+{
+public:
+    // Results of one poll()
+    struct Events
+    {
+        std::vector<Session*> accepted;  // New sessions, not yet watched
+        std::vector<Session*> readable;  // Input pending or peer closed
+        std::vector<Session*> writable;  // Queued output can be written again
+
+        void clear()
+        {
+            accepted.clear();
+            readable.clear();
+            writable.clear();
+        }
+    };
+
+    virtual ~NetReactor();
+
+    // Create a reactor for the configured backend ("epoll" or "sfml").
+    // Falls back to "sfml" when the requested backend is unavailable.
+    static std::unique_ptr<NetReactor> create(const std::string& backend);
+
+    // Backend name for logging
+    virtual const char* getName() const = 0;
+
+    // Start listening for connections
+    bool listen(uint16_t port);
+
+    // Stop accepting new connections
+    void close();
+
+    // Wait up to timeoutMs for network activity. Every pending connection is
+    // accepted (a Session is created for each and listed in `accepted`; the
+    // caller decides which reactor watches it). `readable` lists watched
+    // sessions whose sockets have input or were closed by the peer, and
+    // `writable` those with queued output whose socket can take more data
+    // again (backends without write readiness leave it empty and rely on the
+    // per-tick flush).
+    virtual void poll(int timeoutMs, Events& events) = 0;
+
+    // Start/stop watching a session's socket. unwatch must be called before
+    // the session's socket is destroyed.
+    virtual bool watch(Session& session) = 0;
+    virtual void unwatch(Session& session) = 0;
+
+    // Make a poll() blocked on another thread return early. Backends that
+    // cannot be interrupted return false from canWakeup() and should be
+    // polled with a short timeout instead.
+    virtual bool canWakeup() const { return false; }
+    virtual void wakeup() {}
+
+protected:
+    NetReactor();
+
+    // Backend hooks
+    virtual bool onListen() = 0;
+    virtual void onClose() = 0;
+
+    // Accept every connection waiting on the listener. New sessions are
+    // appended to `accepted`.
+    void acceptPending(std::vector<Session*>& accepted);
+
+    std::unique_ptr<sf::TcpListener> m_listener;
+    bool m_listening = false;
+};
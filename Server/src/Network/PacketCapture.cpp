@@ -0,0 +1,135 @@
+// Packet Capture - Records inbound packets for offline replay
+
+#include "stdafx.h"
+#include "Network/PacketCapture.h"
+#include "Core/Logger.h"
+
+// Large stdio buffer: one write() per megabyte of capture
+static constexpr size_t CAPTURE_BUFFER_SIZE = 1024 * 1024;
+
+PacketCapture& PacketCapture::instance()
+{
+    static PacketCapture instance;
+    return instance;
+}
+
+PacketCapture::~PacketCapture()
+{
+    close();
+}
+
+void PacketCapture::appendVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool PacketCapture::open(const std::string& path, int tickRate, uint64_t tick)
+{
+    close();
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        LOG_ERROR("Capture: cannot open '%s' for writing", path.c_str());
+        return false;
+    }
+    std::setvbuf(m_file, nullptr, _IOFBF, CAPTURE_BUFFER_SIZE);
+
+    m_path = path;
+    m_startTick = tick;
+    m_startTime = std::chrono::steady_clock::now();
+    m_openSessions.clear();
+    m_packets = 0;
+    m_bytes = 0;
+
+    uint64_t unixMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+
+    uint8_t header[HEADER_SIZE] = {};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    header[4] = VERSION;
+    header[6] = static_cast<uint8_t>(tickRate & 0xFF);
+    header[7] = static_cast<uint8_t>((tickRate >> 8) & 0xFF);
+    for (int i = 0; i < 8; ++i) {
+        header[8 + i] = static_cast<uint8_t>((unixMs >> (8 * i)) & 0xFF);
+    }
+    std::fwrite(header, 1, sizeof(header), m_file);
+
+    LOG_INFO("Capture: recording inbound packets to %s", path.c_str());
+    return true;
+}
+
+void PacketCapture::close()
+{
+    if (!m_file)
+        return;
+
+    std::fclose(m_file);
+    m_file = nullptr;
+    LOG_INFO("Capture: wrote %llu packets (%llu bytes) to %s",
+             static_cast<unsigned long long>(m_packets),
+             static_cast<unsigned long long>(m_bytes), m_path.c_str());
+}
+
+void PacketCapture::flush()
+{
+    if (m_file) {
+        std::fflush(m_file);
+    }
+}
+
+void PacketCapture::beginRecord(RecordType type, uint32_t sessionId, uint64_t tick,
+                                std::chrono::steady_clock::time_point time)
+{
+    // Packets read before the capture opened count as time 0
+    int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(time - m_startTime).count();
+
+    m_record.clear();
+    m_record.push_back(static_cast<uint8_t>(type));
+    appendVarint(m_record, sessionId);
+    appendVarint(m_record, tick >= m_startTick ? tick - m_startTick : 0);
+    appendVarint(m_record, us > 0 ? static_cast<uint64_t>(us) : 0);
+}
+
+void PacketCapture::writeRecord()
+{
+    if (std::fwrite(m_record.data(), 1, m_record.size(), m_file) != m_record.size()) {
+        LOG_ERROR("Capture: write to %s failed, stopping capture", m_path.c_str());
+        close();
+    }
+}
+
+void PacketCapture::recordPacket(uint32_t sessionId, uint64_t tick,
+                                 std::chrono::steady_clock::time_point receivedAt,
+                                 const uint8_t* data, size_t size)
+{
+    if (!m_file)
+        return;
+
+    if (m_openSessions.insert(sessionId).second) {
+        beginRecord(RecordType::Open, sessionId, tick, receivedAt);
+        writeRecord();
+        if (!m_file)
+            return;
+    }
+
+    beginRecord(RecordType::Packet, sessionId, tick, receivedAt);
+    appendVarint(m_record, size);
+    m_record.insert(m_record.end(), data, data + size);
+    writeRecord();
+
+    ++m_packets;
+    m_bytes += size;
+}
+
+void PacketCapture::recordClose(uint32_t sessionId, uint64_t tick)
+{
+    if (!m_file || m_openSessions.erase(sessionId) == 0)
+        return;
+
+    beginRecord(RecordType::Close, sessionId, tick, std::chrono::steady_clock::now());
+    writeRecord();
+}
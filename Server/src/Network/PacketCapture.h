@@ -0,0 +1,77 @@
+// Packet Capture - Records inbound packets for offline replay
+// Enabled with [Capture] File=... in server.ini or --capture <file>. Every
+// packet is written as the tick thread dispatches it, tagged with its session,
+// tick and receive time, so PacketReplay can feed the same input back into a
+// headless server on the same ticks.
+//
+// File layout (integers little-endian, "varint" = unsigned LEB128):
+//   Header:  "DMCP" | u8 version | u8 reserved | u16 tick rate | u64 start (unix ms)
+//   Record:  u8 type | varint session | varint tick | varint time (us)
+//            Packet records add: varint size | size bytes (opcode + payload)
+// Ticks and times are relative to when the capture was opened. A session's
+// Open record precedes its first packet; Close is written when it is removed.
+//
+// Captures contain everything clients sent, including login credentials.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+class PacketCapture
+{
+public:
+    static PacketCapture& instance();
+
+    enum class RecordType : uint8_t
+    {
+        Open = 1,
+        Packet = 2,
+        Close = 3
+    };
+
+    static constexpr char MAGIC[4] = {'D', 'M', 'C', 'P'};
+    static constexpr uint8_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 16;
+
+    // Start writing to `path`; `tick` becomes tick 0 of the capture
+    bool open(const std::string& path, int tickRate, uint64_t tick);
+    void close();
+    bool isOpen() const { return m_file != nullptr; }
+
+    // Tick thread only
+    void recordPacket(uint32_t sessionId, uint64_t tick,
+                      std::chrono::steady_clock::time_point receivedAt,
+                      const uint8_t* data, size_t size);
+    void recordClose(uint32_t sessionId, uint64_t tick);
+
+    // Push buffered records to disk
+    void flush();
+
+    static void appendVarint(std::vector<uint8_t>& out, uint64_t value);
+
+private:
+    PacketCapture() = default;
+    ~PacketCapture();
+
+    void beginRecord(RecordType type, uint32_t sessionId, uint64_t tick,
+                     std::chrono::steady_clock::time_point time);
+    void writeRecord();
+
+    std::FILE* m_file = nullptr;
+    std::string m_path;
+    uint64_t m_startTick = 0;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    std::vector<uint8_t> m_record;               // Record being built
+    std::unordered_set<uint32_t> m_openSessions;  // Sessions with an Open record
+
+    uint64_t m_packets = 0;
+    uint64_t m_bytes = 0;
+};
+
+#define sPacketCapture PacketCapture::instance()
@@ -0,0 +1,213 @@
+// Packet Replay - Feeds a PacketCapture file back into a headless server
+
+#include "stdafx.h"
+#include "Network/PacketReplay.h"
+#include "Network/PacketCapture.h"
+#include "Network/PacketRouter.h"
+#include "Network/Session.h"
+#include "Network/SessionManager.h"
+#include "Core/Logger.h"
+#include "SfSocket.h"
+
+PacketReplay& PacketReplay::instance()
+{
+    static PacketReplay instance;
+    return instance;
+}
+
+PacketReplay::~PacketReplay()
+{
+    if (m_file) {
+        std::fclose(m_file);
+    }
+}
+
+bool PacketReplay::open(const std::string& path, Speed speed)
+{
+    m_file = std::fopen(path.c_str(), "rb");
+    if (!m_file) {
+        LOG_ERROR("Replay: cannot open '%s'", path.c_str());
+        return false;
+    }
+
+    uint8_t header[PacketCapture::HEADER_SIZE];
+    if (std::fread(header, 1, sizeof(header), m_file) != sizeof(header) ||
+        std::memcmp(header, PacketCapture::MAGIC, sizeof(PacketCapture::MAGIC)) != 0 ||
+        header[4] != PacketCapture::VERSION)
+    {
+        LOG_ERROR("Replay: '%s' is not a version %u packet capture", path.c_str(), PacketCapture::VERSION);
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+
+    m_path = path;
+    m_speed = speed;
+    m_tickRate = header[6] | (header[7] << 8);
+    m_active = true;
+    m_hasNext = readRecord(m_next);
+
+    LOG_INFO("Replay: %s at %s speed (captured at %d ticks/sec)", path.c_str(),
+             speed == Speed::Max ? "max" : "recorded", m_tickRate);
+    return true;
+}
+
+bool PacketReplay::readVarint(uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = std::fgetc(m_file);
+        if (byte == EOF)
+            return false;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+bool PacketReplay::readRecord(Record& record)
+{
+    int type = std::fgetc(m_file);
+    if (type == EOF)
+        return false;
+
+    uint64_t session, size;
+    if (!readVarint(session) || !readVarint(record.tick) || !readVarint(record.timeUs)) {
+        LOG_WARN("Replay: truncated record in %s", m_path.c_str());
+        return false;
+    }
+    record.type = static_cast<uint8_t>(type);
+    record.session = static_cast<uint32_t>(session);
+    record.data.clear();
+
+    if (record.type == static_cast<uint8_t>(PacketCapture::RecordType::Packet)) {
+        if (!readVarint(size) || size < 2 || size > SfSocket::MAX_PACKET_SIZE) {
+            LOG_WARN("Replay: bad packet record in %s", m_path.c_str());
+            return false;
+        }
+        record.data.resize(static_cast<size_t>(size));
+        if (std::fread(record.data.data(), 1, record.data.size(), m_file) != record.data.size()) {
+            LOG_WARN("Replay: truncated packet in %s", m_path.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+void PacketReplay::processInput(uint64_t tick)
+{
+    if (!m_file)
+        return;
+
+    if (!m_started) {
+        m_started = true;
+        m_firstTick = tick;
+        m_startTime = std::chrono::steady_clock::now();
+    }
+
+    uint64_t captureTick = tick - m_firstTick;
+    while (m_hasNext && m_next.tick <= captureTick) {
+        apply(m_next);
+        m_hasNext = readRecord(m_next);
+    }
+
+    if (!m_hasNext) {
+        finish();
+    }
+}
+
+void PacketReplay::apply(const Record& record)
+{
+    using RecordType = PacketCapture::RecordType;
+
+    switch (static_cast<RecordType>(record.type)) {
+        case RecordType::Open: {
+            // No socket: output is staged as usual and dropped at flush time
+            Session* session = sSessionManager.createSession(nullptr);
+            session->getChannel().open.store(true, std::memory_order_release);
+            m_sessions[record.session] = session->getId();
+            ++m_sessionCount;
+            break;
+        }
+
+        case RecordType::Packet: {
+            auto it = m_sessions.find(record.session);
+            Session* session = it != m_sessions.end() ? sSessionManager.getSession(it->second) : nullptr;
+            if (!session || session->shouldRemove()) {
+                ++m_dropped;
+                break;
+            }
+
+            StlBuffer packet = StlBuffer::view(record.data.data(), record.data.size());
+            uint16_t opcode;
+            packet >> opcode;
+            try {
+                sPacketRouter.dispatch(*session, opcode, packet);
+            } catch (const std::exception& e) {
+                LOG_ERROR("Session %u: Replayed packet error: %s", session->getId(), e.what());
+                session->markForRemoval();
+            }
+            ++m_packets;
+            break;
+        }
+
+        case RecordType::Close: {
+            auto it = m_sessions.find(record.session);
+            if (it != m_sessions.end()) {
+                sSessionManager.removeSession(it->second);
+                m_sessions.erase(it);
+            }
+            break;
+        }
+
+        default:
+            LOG_WARN("Replay: skipping unknown record type %u", record.type);
+            break;
+    }
+}
+
+void PacketReplay::finish()
+{
+    std::fclose(m_file);
+    m_file = nullptr;
+    m_finished = true;
+    m_endTime = std::chrono::steady_clock::now();
+}
+
+void PacketReplay::recordTickTime(std::chrono::steady_clock::duration duration)
+{
+    if (!m_started || m_finished)
+        return;
+
+    m_tickUs.push_back(static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+}
+
+void PacketReplay::logSummary() const
+{
+    auto end = m_finished ? m_endTime : std::chrono::steady_clock::now();
+    double seconds = m_started ? std::chrono::duration<double>(end - m_startTime).count() : 0.0;
+
+    LOG_INFO("Replay: %llu packets over %zu ticks from %llu sessions in %.2fs (%llu dropped)",
+             static_cast<unsigned long long>(m_packets), m_tickUs.size(),
+             static_cast<unsigned long long>(m_sessionCount), seconds,
+             static_cast<unsigned long long>(m_dropped));
+
+    if (m_tickUs.empty())
+        return;
+
+    std::vector<uint32_t> sorted = m_tickUs;
+    std::sort(sorted.begin(), sorted.end());
+    auto at = [&sorted](double p) {
+        return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))] / 1000.0;
+    };
+
+    uint64_t total = 0;
+    for (uint32_t us : sorted) {
+        total += us;
+    }
+
+    LOG_INFO("Replay tick time: mean %.3fms, p50 %.3fms, p99 %.3fms, p999 %.3fms, max %.3fms",
+             total / 1000.0 / sorted.size(), at(0.50), at(0.99), at(0.999), sorted.back() / 1000.0);
+}
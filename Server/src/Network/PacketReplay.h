@@ -0,0 +1,94 @@
+// Packet Replay - Feeds a PacketCapture file back into a headless server
+// Started with --replay <file> [--replay-speed recorded|max]. The server does
+// not listen; each captured session becomes a socketless Session and its
+// packets are dispatched on the same tick (relative to the start) as when
+// they were recorded. Output is built as usual and then dropped.
+//
+// "recorded" runs ticks at the normal rate; "max" runs them back to back.
+// Either way the input lines up tick for tick, so the tick-time summary
+// logged at the end can be compared across builds. Max speed compresses
+// wall-clock timers (session timeouts and the like).
+//
+// Handlers write to the server database as they would live, so replay against
+// a copy of the database the capture started from.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Session;
+
+class PacketReplay
+{
+public:
+    static PacketReplay& instance();
+
+    enum class Speed
+    {
+        Recorded,
+        Max
+    };
+
+    bool open(const std::string& path, Speed speed);
+    bool isActive() const { return m_active; }
+    Speed getSpeed() const { return m_speed; }
+    int getTickRate() const { return m_tickRate; }
+
+    // Tick thread input phase: dispatch every record due by this tick
+    void processInput(uint64_t tick);
+
+    // All records have been replayed
+    bool isFinished() const { return m_finished; }
+
+    // Time spent in one tick's update phases
+    void recordTickTime(std::chrono::steady_clock::duration duration);
+
+    void logSummary() const;
+
+private:
+    PacketReplay() = default;
+    ~PacketReplay();
+
+    struct Record
+    {
+        uint8_t type = 0;
+        uint32_t session = 0;
+        uint64_t tick = 0;
+        uint64_t timeUs = 0;
+        std::vector<uint8_t> data;
+    };
+
+    bool readRecord(Record& record);
+    bool readVarint(uint64_t& value);
+    void apply(const Record& record);
+    void finish();
+
+    std::FILE* m_file = nullptr;
+    std::string m_path;
+    Speed m_speed = Speed::Recorded;
+    int m_tickRate = 0;
+
+    bool m_active = false;
+    Record m_next;
+    bool m_hasNext = false;
+    bool m_finished = false;
+    bool m_started = false;
+    uint64_t m_firstTick = 0;  // Server tick that replays capture tick 0
+
+    // Captured session id -> live session id
+    std::unordered_map<uint32_t, uint32_t> m_sessions;
+
+    uint64_t m_packets = 0;
+    uint64_t m_dropped = 0;  // Packets for sessions the server already removed
+    uint64_t m_sessionCount = 0;
+    std::chrono::steady_clock::time_point m_startTime;
+    std::chrono::steady_clock::time_point m_endTime;
+    std::vector<uint32_t> m_tickUs;
+};
+
+#define sPacketReplay PacketReplay::instance()
@@ -239,6 +239,10 @@ void PacketRouter::dispatch(Session& session, uint16_t opcode, StlBuffer& data)
     // Call the handler with comprehensive error handling
     try {
         info.handler(session, data);
+        if (data.hasError()) {
+            LOG_WARN("Session %u: Truncated %s packet (size=%zu)",
+                     session.getId(), info.name.c_str(), data.size());
+        }
     } catch (const std::exception& e) {
         LOG_ERROR("Session %u: Exception in handler %s: %s",
                   session.getId(), info.name.c_str(), e.what());
@@ -67,11 +67,9 @@ StlBuffer buildPacket(uint16_t opcode)
 StlBuffer buildPacket(uint16_t opcode, const StlBuffer& data)
 {
     StlBuffer buf;
+    buf.reserve(sizeof(opcode) + data.size());
     buf << opcode;
-    // Copy data byte by byte (StlBuffer doesn't have append)
-    for (size_t i = 0; i < data.size(); ++i) {
-        buf << data.data()[i];
-    }
+    buf.write(reinterpret_cast<const char*>(data.data()), data.size());
     return buf;
 }
 
@@ -3,7 +3,9 @@
 
 #include "stdafx.h"
 #include "Network/Session.h"
+#include "Network/SessionManager.h"
 #include "SfSocket.h"
+#include "Core/Config.h"
 #include "Core/Logger.h"
 #include "World/Player.h"
 #include "World/WorldManager.h"
@@ -42,11 +44,25 @@ Session::~Session()
 void Session::setSocket(std::unique_ptr<SfSocket> socket)
 {
     m_socket = std::move(socket);
+    m_sendLimit = sConfig.getSendQueueLimit();
+    if (m_socket) {
+        m_socket->setSendQueueLimit(m_sendLimit);
+        m_remoteAddress = m_socket->getRemoteAddress();
+    }
+    m_channel.open.store(m_socket && m_socket->isConnected(), std::memory_order_release);
 }
 
 bool Session::isConnected() const
 {
-    return m_socket && m_socket->isConnected();
+    return m_channel.open.load(std::memory_order_acquire);
+}
+
+void Session::closeSocket()
+{
+    if (m_socket) {
+        m_socket->disconnect();
+    }
+    m_channel.open.store(false, std::memory_order_release);
 }
 
 void Session::setState(SessionState state)
@@ -121,13 +137,118 @@ void Session::clearPlayer()
     }
 }
 
+bool Session::canStage(size_t frameSize)
+{
+    if (!isConnected() || isDisconnecting() || m_sendOverflow) {
+        return false;
+    }
+
+    PacketBatch& staging = m_channel.staging;
+    if (staging.size() + frameSize > m_sendLimit) {
+        // Output is piling up faster than the I/O thread can take it. Stop
+        // queuing and let SessionManager::update() remove the session.
+        LOG_WARN("Session %u: Send queue full (%zu bytes), dropping slow consumer",
+                 m_id, staging.size());
+        m_sendOverflow = true;
+        markForRemoval();
+        return false;
+    }
+    return true;
+}
+
+bool Session::markStaged()
+{
+    if (m_flushScheduled) {
+        return false;
+    }
+    m_flushScheduled = true;
+    return true;
+}
+
 void Session::sendPacket(const StlBuffer& data)
 {
-    if (m_socket && !isDisconnecting()) {
-        m_socket->send(data);
+    std::unique_lock<std::mutex> lock(m_channel.stagingMutex);
+    if (!canStage(4 + data.size())) {
+        return;
+    }
+
+    PacketBatch& staging = m_channel.staging;
+
+    // Wire format: [4 bytes: payload size (uint32 LE)] [payload]
+    uint32_t len = static_cast<uint32_t>(data.size());
+    uint8_t header[4] = {
+        static_cast<uint8_t>(len & 0xFF),
+        static_cast<uint8_t>((len >> 8) & 0xFF),
+        static_cast<uint8_t>((len >> 16) & 0xFF),
+        static_cast<uint8_t>((len >> 24) & 0xFF)
+    };
+    staging.bytes.insert(staging.bytes.end(), header, header + 4);
+    staging.bytes.insert(staging.bytes.end(), data.data(), data.data() + data.size());
+    ++staging.count;
+
+    bool schedule = markStaged();
+    lock.unlock();
+    if (schedule) {
+        sSessionManager.scheduleFlush(*this);
     }
 }
 
+void Session::sendPacket(const SharedPacketPtr& packet)
+{
+    if (!packet) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_channel.stagingMutex);
+    if (!canStage(packet->size())) {
+        return;
+    }
+
+    SharedPacket::Stats& stats = SharedPacket::stats();
+    stats.deliveries.fetch_add(1, std::memory_order_relaxed);
+
+    PacketBatch& staging = m_channel.staging;
+    if (packet->size() < SharedPacket::MIN_SHARED_SIZE) {
+        staging.bytes.insert(staging.bytes.end(), packet->data(), packet->data() + packet->size());
+    } else {
+        staging.shared.push_back({staging.bytes.size(), packet});
+        staging.sharedBytes += packet->size();
+        stats.bytesShared.fetch_add(packet->size(), std::memory_order_relaxed);
+    }
+    ++staging.count;
+
+    bool schedule = markStaged();
+    lock.unlock();
+    if (schedule) {
+        sSessionManager.scheduleFlush(*this);
+    }
+}
+
+bool Session::hasPendingOutput() const
+{
+    return m_socket && m_socket->hasPendingOutput();
+}
+
+size_t Session::getSendQueueDepth() const
+{
+    std::lock_guard<std::mutex> lock(m_channel.stagingMutex);
+    return m_channel.staging.size() +
+           m_channel.sendQueueDepth.load(std::memory_order_relaxed);
+}
+
+uint64_t Session::getBytesSent() const
+{
+    return m_channel.bytesSent.load(std::memory_order_relaxed);
+}
+
+double Session::sampleSendRate(double elapsedSeconds)
+{
+    uint64_t sent = getBytesSent();
+    uint64_t delta = sent - m_sentAtLastSample;
+    m_sentAtLastSample = sent;
+    return elapsedSeconds > 0.0 ? static_cast<double>(delta) / elapsedSeconds : 0.0;
+}
+
 void Session::updateLastActivity()
 {
     m_lastActivity = std::time(nullptr);
@@ -192,8 +313,6 @@ bool Session::shouldRemove() const
 
 std::string Session::getRemoteAddress() const
 {
-    if (m_socket) {
-        return m_socket->getRemoteAddress();
-    }
-    return "unknown";
+    // Cached at accept; the socket itself belongs to the I/O thread
+    return m_remoteAddress;
 }
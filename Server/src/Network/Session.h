@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "Network/SessionChannel.h"
 #include <memory>
 #include <cstdint>
 #include <string>
@@ -38,11 +39,18 @@ public:
     uint32_t getId() const { return m_id; }
 
     // Socket management
+    // The socket belongs to the session's I/O thread (see NetIoService); the
+    // tick thread reaches it only through the channel.
     void setSocket(std::unique_ptr<SfSocket> socket);
     SfSocket* getSocket() { return m_socket.get(); }
     const SfSocket* getSocket() const { return m_socket.get(); }
     bool isConnected() const;
 
+    // I/O side: close the socket and report the session as disconnected
+    void closeSocket();
+
+    SessionChannel& getChannel() { return m_channel; }
+
     // State management
     SessionState getState() const { return m_state; }
     void setState(SessionState state);
@@ -70,8 +78,24 @@ public:
     void setPlayerGuid(uint32_t guid) { m_playerGuid = guid; }
 
     // Packet handling
+    // sendPacket only stages the frame; SessionManager::flushOutput() hands
+    // staged output to the I/O thread once per tick
     void sendPacket(const StlBuffer& data);
 
+    // Queue a broadcast frame built once for many recipients. Large frames
+    // are queued by reference rather than copied.
+    void sendPacket(const SharedPacketPtr& packet);
+
+    // I/O side: socket has output the kernel has not accepted yet
+    bool hasPendingOutput() const;
+
+    // Outbound queue metrics
+    size_t getSendQueueDepth() const;
+    uint64_t getBytesSent() const;
+
+    // Bytes/sec sent since the previous call (for slow consumer reporting)
+    double sampleSendRate(double elapsedSeconds);
+
     // Activity tracking
     void updateLastActivity();
     void updateLastPing();
@@ -97,8 +121,16 @@ public:
     std::string getRemoteAddress() const;
 
 private:
+    // Check the staging limit for another frame (drops the session if hit)
+    bool canStage(size_t frameSize);
+    // Note staged output; true the first time since the last flush, when the
+    // caller must ask SessionManager to flush this session (outside the lock)
+    bool markStaged();
+
     uint32_t m_id;
     std::unique_ptr<SfSocket> m_socket;
+    SessionChannel m_channel;
+    std::string m_remoteAddress = "unknown";
 
     // State
     SessionState m_state = SessionState::Connected;
@@ -120,4 +152,12 @@ private:
     // Disconnect handling
     bool m_markedForRemoval = false;
     std::string m_disconnectReason;
+
+    // Output queue
+    bool m_flushScheduled = false;   // Listed in SessionManager's pending flush set (under stagingMutex)
+    bool m_sendOverflow = false;     // Queue limit hit; session is being dropped
+    size_t m_sendLimit = 0;          // Max bytes staged per flush
+    uint64_t m_sentAtLastSample = 0;
+
+    friend class SessionManager;
 };
@@ -0,0 +1,77 @@
+// Session Channel - Packet hand-off between a session's I/O thread and the tick thread
+// The I/O thread owns the socket. Everything the tick thread needs from it
+// (received packets, connection state, send statistics) crosses through here,
+// and output built during a tick goes back the same way.
+
+#pragma once
+
+#include "Network/SharedPacket.h"
+#include "Network/SpscQueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// A run of packets moved between threads as one unit
+struct PacketBatch
+{
+    // Inbound: [4 bytes: size] [opcode + payload] per packet.
+    // Outbound: wire frames ([4 bytes: size] [payload]) ready to write.
+    std::vector<uint8_t> bytes;
+    uint32_t count = 0;
+
+    // Outbound: broadcast frames queued by reference. Each one is written
+    // after the first `offset` bytes of `bytes`, keeping send order.
+    struct SharedRef
+    {
+        size_t offset;
+        SharedPacketPtr packet;
+    };
+    std::vector<SharedRef> shared;
+    size_t sharedBytes = 0;
+
+    // Inbound: when the I/O thread read these packets off the socket
+    std::chrono::steady_clock::time_point receivedAt;
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return bytes.size() + sharedBytes; }
+
+    void clear()
+    {
+        bytes.clear();
+        count = 0;
+        shared.clear();
+        sharedBytes = 0;
+    }
+};
+
+struct SessionChannel
+{
+    // Batches in flight per direction. A full inbound queue stops the I/O
+    // thread reading that socket until the tick thread catches up.
+    static constexpr size_t QUEUE_BATCHES = 16;
+
+    // Drained batches travel back through the *Free queues so their buffers
+    // are reused instead of reallocated
+    SpscQueue<PacketBatch> inbound{QUEUE_BATCHES};       // I/O thread -> tick thread
+    SpscQueue<PacketBatch> inboundFree{QUEUE_BATCHES};   // tick thread -> I/O thread
+    SpscQueue<PacketBatch> outbound{QUEUE_BATCHES};      // tick thread -> I/O thread
+    SpscQueue<PacketBatch> outboundFree{QUEUE_BATCHES};  // I/O thread -> tick thread
+
+    // Output queued since the last flush. Map jobs send concurrently, so
+    // staging is only touched under stagingMutex.
+    PacketBatch staging;
+    mutable std::mutex stagingMutex;
+
+    // Cleared by the I/O side when the socket closes or fails
+    std::atomic<bool> open{false};
+
+    // Set by the I/O thread once it has dropped every reference to the
+    // session; only then may the session be destroyed
+    std::atomic<bool> released{false};
+
+    // Published by the I/O thread after each write
+    std::atomic<uint64_t> bytesSent{0};
+    std::atomic<size_t> sendQueueDepth{0};
+};
@@ -4,6 +4,11 @@
 #include "stdafx.h"
 #include "Network/SessionManager.h"
 #include "Network/Session.h"
+#include "Network/NetIoService.h"
+#include "Network/PacketCapture.h"
+#include "Network/SharedPacket.h"
+#include "Core/Config.h"
+#include "Core/GameClock.h"
 #include "Core/Logger.h"
 #include "SfSocket.h"
 
@@ -13,11 +18,12 @@ SessionManager& SessionManager::instance()
     return instance;
 }
 
-Session* SessionManager::createSession()
+Session* SessionManager::createSession(std::unique_ptr<SfSocket> socket)
 {
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
     uint32_t id = m_nextId++;
     auto session = std::make_unique<Session>(id);
+    session->setSocket(std::move(socket));
     auto* ptr = session.get();
     m_sessions[id] = std::move(session);
     LOG_INFO("Session %u created", id);
@@ -27,9 +33,36 @@ Session* SessionManager::createSession()
 void SessionManager::removeSession(uint32_t id)
 {
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    if (m_sessions.erase(id) > 0) {
-        LOG_INFO("Session %u removed", id);
+    auto it = m_sessions.find(id);
+    if (it == m_sessions.end())
+        return;
+
+    std::unique_ptr<Session> session = std::move(it->second);
+    m_sessions.erase(it);
+
+    if (sPacketCapture.isOpen()) {
+        sPacketCapture.recordClose(id, sGameClock.getTickCount());
     }
+
+    // Leave the world now; the I/O thread may hold the session a little longer
+    session->clearPlayer();
+
+    if (m_onRemove)
+        m_onRemove(*session);
+
+    m_bytesSentBase += session->getBytesSent();
+    m_released.push_back(std::move(session));
+    destroyReleasedSessions();
+    LOG_INFO("Session %u removed", id);
+}
+
+void SessionManager::destroyReleasedSessions()
+{
+    auto released = std::remove_if(m_released.begin(), m_released.end(),
+        [](const std::unique_ptr<Session>& session) {
+            return session->getChannel().released.load(std::memory_order_acquire);
+        });
+    m_released.erase(released, m_released.end());
 }
 
 Session* SessionManager::getSession(uint32_t id)
@@ -46,6 +79,8 @@ void SessionManager::update()
     {
         std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
+        destroyReleasedSessions();
+
         for (auto& [id, session] : m_sessions) {
             // Check for disconnected sessions
             if (session->shouldRemove()) {
@@ -123,10 +158,8 @@ void SessionManager::disconnectAll(const std::string& reason)
         if (!session->isDisconnecting()) {
             session->initiateDisconnect(reason);
 
-            // Close the socket
-            if (session->getSocket()) {
-                session->getSocket()->disconnect();
-            }
+            // Close the socket (I/O threads are stopped by now)
+            session->closeSocket();
         }
     }
 
@@ -140,6 +173,87 @@ size_t SessionManager::getSessionCount() const
     return m_sessions.size();
 }
 
+void SessionManager::scheduleFlush(Session& session)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    m_pendingFlush.push_back(session.getId());
+}
+
+void SessionManager::flushOutput()
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    // Swap so sessions that still have output after this pass can be
+    // rescheduled without disturbing the list being walked
+    m_flushing.swap(m_pendingFlush);
+    m_pendingFlush.clear();
+
+    for (uint32_t id : m_flushing) {
+        auto it = m_sessions.find(id);
+        if (it == m_sessions.end())
+            continue;
+
+        // Channel full: the I/O thread is behind, retry next tick
+        Session& session = *it->second;
+        std::lock_guard<std::mutex> staging(session.getChannel().stagingMutex);
+        if (sNetIo.queueOutput(session)) {
+            session.m_flushScheduled = false;
+        } else {
+            m_pendingFlush.push_back(id);
+        }
+    }
+
+    m_flushing.clear();
+    sNetIo.commitOutput();
+}
+
+void SessionManager::logNetworkStats()
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - m_lastStatsTime).count();
+    m_lastStatsTime = now;
+
+    uint64_t totalSent = m_bytesSentBase;
+    size_t totalQueued = 0;
+    size_t slowConsumers = 0;
+
+    for (auto& [id, session] : m_sessions) {
+        double rate = session->sampleSendRate(elapsed);
+        size_t depth = session->getSendQueueDepth();
+        totalSent += session->getBytesSent();
+        totalQueued += depth;
+
+        size_t limit = sConfig.getSendQueueLimit();
+        if (depth >= static_cast<size_t>(limit * SLOW_CONSUMER_FRACTION)) {
+            ++slowConsumers;
+            LOG_WARN("Session %u: Slow consumer - %zu/%zu bytes queued, %.1f KB/s sent",
+                     id, depth, limit, rate / 1024.0);
+        }
+    }
+
+    double outRate = elapsed > 0.0
+        ? static_cast<double>(totalSent - m_bytesSentAtLastStats) / elapsed : 0.0;
+    m_bytesSentAtLastStats = totalSent;
+
+    LOG_INFO("Network: %.1f KB/s out, %zu bytes queued, %zu slow consumer(s)",
+             outRate / 1024.0, totalQueued, slowConsumers);
+
+    // Broadcasts built once instead of per recipient
+    SharedPacket::Stats& shared = SharedPacket::stats();
+    uint64_t packets = shared.packets.exchange(0, std::memory_order_relaxed);
+    uint64_t deliveries = shared.deliveries.exchange(0, std::memory_order_relaxed);
+    uint64_t bytesShared = shared.bytesShared.exchange(0, std::memory_order_relaxed);
+    if (packets > 0) {
+        LOG_INFO("Network broadcasts: %llu packets to %llu recipients, %llu serializations and %.1f KB of copies saved",
+                 static_cast<unsigned long long>(packets),
+                 static_cast<unsigned long long>(deliveries),
+                 static_cast<unsigned long long>(deliveries > packets ? deliveries - packets : 0),
+                 bytesShared / 1024.0);
+    }
+}
+
 bool SessionManager::isSessionTimedOut(const Session& session) const
 {
     switch (session.getState()) {
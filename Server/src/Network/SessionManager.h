@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -11,6 +13,7 @@
 #include <string>
 
 class Session;
+class SfSocket;
 
 class SessionManager
 {
@@ -18,7 +21,9 @@ public:
     static SessionManager& instance();
 
     // Session management
-    Session* createSession();
+    // createSession may run on the I/O thread that accepted the socket; the
+    // session is only visible to lookups once it owns the socket.
+    Session* createSession(std::unique_ptr<SfSocket> socket);
     void removeSession(uint32_t id);
     Session* getSession(uint32_t id);
 
@@ -47,15 +52,49 @@ public:
     // Statistics
     size_t getSessionCount() const;
 
+    // Outbound queues
+    // Sessions that queued output since the last flush register here, so the
+    // per-tick flush only visits sessions with something to send.
+    void scheduleFlush(Session& session);
+
+    // Hand this tick's output to the I/O threads
+    void flushOutput();
+
+    // Log aggregate send throughput and any sessions whose queues are backing up
+    void logNetworkStats();
+
+    // Queue depth at which a session is reported as a slow consumer
+    static constexpr double SLOW_CONSUMER_FRACTION = 0.25;
+
+    // Called for every session as it is removed (e.g. so its I/O thread can
+    // let go of the socket). The session is destroyed once its channel
+    // reports `released`.
+    using SessionCallback = std::function<void(Session&)>;
+    void setRemoveCallback(SessionCallback callback) { m_onRemove = std::move(callback); }
+
 private:
     SessionManager() = default;
 
     // Check if a session has timed out based on its state
     bool isSessionTimedOut(const Session& session) const;
 
+    // Destroy removed sessions their I/O thread has let go of
+    void destroyReleasedSessions();
+
     std::unordered_map<uint32_t, std::unique_ptr<Session>> m_sessions;
+    std::vector<std::unique_ptr<Session>> m_released;  // Removed, awaiting I/O release
     mutable std::recursive_mutex m_mutex;  // Recursive to allow nested calls (e.g., kickDuplicateLogin from packet handlers)
     uint32_t m_nextId = 1;
+    SessionCallback m_onRemove;
+
+    // Pending flush list (session ids; sessions may be removed before flushing)
+    std::vector<uint32_t> m_pendingFlush;
+    std::vector<uint32_t> m_flushing;
+
+    // Throughput sampling for logNetworkStats()
+    std::chrono::steady_clock::time_point m_lastStatsTime = std::chrono::steady_clock::now();
+    uint64_t m_bytesSentBase = 0;      // Bytes sent by sessions already removed
+    uint64_t m_bytesSentAtLastStats = 0;
 };
 
 #define sSessionManager SessionManager::instance()
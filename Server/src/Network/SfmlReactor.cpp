@@ -0,0 +1,65 @@
+// SFML Reactor - Portable sf::SocketSelector backend
+
+#include "stdafx.h"
+#include "Network/SfmlReactor.h"
+#include "Network/Session.h"
+#include "SfSocket.h"
+#include <SFML/Network/TcpListener.hpp>
+
+bool SfmlReactor::onListen()
+{
+    m_selector.add(*m_listener);
+    return true;
+}
+
+void SfmlReactor::onClose()
+{
+    m_selector.remove(*m_listener);
+}
+
+void SfmlReactor::poll(int timeoutMs, Events& events)
+{
+    events.clear();
+
+    // sf::Time::Zero means "wait forever" to SFML, so never pass it
+    if (!m_selector.wait(sf::milliseconds(std::max(timeoutMs, 1))))
+        return;
+
+    // Check for new connections
+    if (m_listening && m_selector.isReady(*m_listener))
+    {
+        acceptPending(events.accepted);
+    }
+
+    // Find sessions with pending input
+    for (auto& [id, session] : m_watched)
+    {
+        SfSocket* socket = session->getSocket();
+        if (!socket || !socket->isConnected() || m_selector.isReady(*socket->getSocket()))
+        {
+            events.readable.push_back(session);
+        }
+    }
+}
+
+bool SfmlReactor::watch(Session& session)
+{
+    SfSocket* socket = session.getSocket();
+    if (!socket)
+        return false;
+
+    m_selector.add(*socket->getSocket());
+    m_watched[session.getId()] = &session;
+    return true;
+}
+
+void SfmlReactor::unwatch(Session& session)
+{
+    if (m_watched.erase(session.getId()) == 0)
+        return;
+
+    if (SfSocket* socket = session.getSocket())
+    {
+        m_selector.remove(*socket->getSocket());
+    }
+}
@@ -0,0 +1,27 @@
+// SFML Reactor - Portable sf::SocketSelector backend
+// Every wakeup checks each watched socket, so cost grows with the session count.
+// Used where epoll is unavailable or when [Network] Backend=sfml.
+
+#pragma once
+
+#include "Network/NetReactor.h"
+#include <SFML/Network/SocketSelector.hpp>
+#include <unordered_map>
+
+class SfmlReactor : public NetReactor
+{
+public:
+    const char* getName() const override { return "sfml"; }
+
+    void poll(int timeoutMs, Events& events) override;
+    bool watch(Session& session) override;
+    void unwatch(Session& session) override;
+
+protected:
+    bool onListen() override;
+    void onClose() override;
+
+private:
+    sf::SocketSelector m_selector;
+    std::unordered_map<uint32_t, Session*> m_watched;
+};
@@ -0,0 +1,27 @@
+// Shared Packet - Immutable framed packet for broadcasts
+
+#include "stdafx.h"
+#include "Network/SharedPacket.h"
+#include "StlBuffer.h"
+
+SharedPacketPtr SharedPacket::create(const StlBuffer& packet)
+{
+    // Wire format: [4 bytes: payload size (uint32 LE)] [payload]
+    std::vector<uint8_t> frame(4 + packet.size());
+    uint32_t len = static_cast<uint32_t>(packet.size());
+    frame[0] = static_cast<uint8_t>(len & 0xFF);
+    frame[1] = static_cast<uint8_t>((len >> 8) & 0xFF);
+    frame[2] = static_cast<uint8_t>((len >> 16) & 0xFF);
+    frame[3] = static_cast<uint8_t>((len >> 24) & 0xFF);
+    if (packet.size() > 0)
+        std::memcpy(frame.data() + 4, packet.data(), packet.size());
+
+    stats().packets.fetch_add(1, std::memory_order_relaxed);
+    return std::make_shared<const SharedPacket>(std::move(frame));
+}
+
+SharedPacket::Stats& SharedPacket::stats()
+{
+    static Stats stats;
+    return stats;
+}
@@ -0,0 +1,48 @@
+// Shared Packet - Immutable framed packet for broadcasts
+// A broadcast serializes and frames its packet once, then queues the same
+// buffer to every recipient. Recipients hold references; the I/O threads
+// write straight from this buffer, and it is freed when the last send
+// completes.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class StlBuffer;
+class SharedPacket;
+
+using SharedPacketPtr = std::shared_ptr<const SharedPacket>;
+
+class SharedPacket
+{
+public:
+    // Frame a packet ([4 bytes: payload size] [payload]) for sharing
+    static SharedPacketPtr create(const StlBuffer& packet);
+
+    // Framed bytes, ready to write
+    const uint8_t* data() const { return m_frame.data(); }
+    size_t size() const { return m_frame.size(); }
+
+    // Frames smaller than this are still copied into each recipient's queue:
+    // for tiny packets a memcpy is cheaper than a reference and an extra
+    // gather-write entry
+    static constexpr size_t MIN_SHARED_SIZE = 64;
+
+    // Broadcast counters (updated from any thread; logNetworkStats drains them)
+    struct Stats
+    {
+        std::atomic<uint64_t> packets{0};      // SharedPackets created
+        std::atomic<uint64_t> deliveries{0};   // Recipients queued (each one a serialization saved)
+        std::atomic<uint64_t> bytesShared{0};  // Bytes queued by reference instead of copied
+    };
+    static Stats& stats();
+
+    explicit SharedPacket(std::vector<uint8_t> frame) : m_frame(std::move(frame)) {}
+
+private:
+    std::vector<uint8_t> m_frame;
+};
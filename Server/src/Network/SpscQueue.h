@@ -0,0 +1,88 @@
+// SPSC Queue - Bounded lock-free single-producer/single-consumer queue
+// Used to hand packet batches between a network I/O thread and the tick thread.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+template<typename T>
+class SpscQueue
+{
+public:
+    // Capacity is rounded up to a power of two
+    explicit SpscQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side. Returns false (leaving `value` untouched) when full.
+    bool push(T&& value)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail > m_mask)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail > m_mask)
+                return false;
+        }
+
+        m_slots[head & m_mask] = std::move(value);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when empty.
+    bool pop(T& out)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_cachedHead)
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail == m_cachedHead)
+                return false;
+        }
+
+        out = std::move(m_slots[tail & m_mask]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side: true if push() would succeed
+    bool canPush()
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail > m_mask)
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+        return head - m_cachedTail <= m_mask;
+    }
+
+    // Approximate when called from the other side's thread
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return m_mask + 1; }
+
+private:
+    std::vector<T> m_slots;
+    size_t m_mask = 0;
+
+    // Producer and consumer indices live on separate cache lines; each side
+    // also caches the other's index to avoid touching the shared line on
+    // every operation.
+    alignas(64) std::atomic<size_t> m_head{0};  // Written by producer
+    size_t m_cachedTail = 0;                    // Producer's view of m_tail
+    alignas(64) std::atomic<size_t> m_tail{0};  // Written by consumer
+    size_t m_cachedHead = 0;                    // Consumer's view of m_head
+};
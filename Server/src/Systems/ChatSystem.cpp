@@ -99,19 +99,13 @@ void ChatManager::sendSystemMessage(Player* target, const std::string& message)
 void ChatManager::sendSystemMessageToMap(int mapId, const std::string& message)
 {
     auto players = sWorldManager.getPlayersOnMap(mapId);
-    for (Player* player : players)
-    {
-        sendSystemMessage(player, message);
-    }
+    broadcastChatMessage(players, ChatDefines::Channels::System, 0, "", message);
 }
 
 void ChatManager::sendSystemMessageGlobal(const std::string& message)
 {
     auto players = sWorldManager.getAllPlayers();
-    for (Player* player : players)
-    {
-        sendSystemMessage(player, message);
-    }
+    broadcastChatMessage(players, ChatDefines::Channels::System, 0, "", message);
 }
 
 // ============================================================================
@@ -135,15 +129,8 @@ void ChatManager::handleSay(Player* sender, const std::string& message)
     }
 
     // Send to all recipients (including sender)
-    for (Player* recipient : recipients)
-    {
-        // Check ignore list
-        if (isIgnoring(recipient->getGuid(), sender->getGuid()))
-            continue;
-
-        sendChatMessage(recipient, ChatDefines::Channels::Say,
-                        sender->getGuid(), sender->getName(), message);
-    }
+    broadcastChatMessage(recipients, ChatDefines::Channels::Say,
+                         sender->getGuid(), sender->getName(), message);
 }
 
 void ChatManager::handleYell(Player* sender, const std::string& message)
@@ -163,15 +150,8 @@ void ChatManager::handleYell(Player* sender, const std::string& message)
     }
 
     // Send to all recipients (including sender)
-    for (Player* recipient : recipients)
-    {
-        // Check ignore list
-        if (isIgnoring(recipient->getGuid(), sender->getGuid()))
-            continue;
-
-        sendChatMessage(recipient, ChatDefines::Channels::Yell,
-                        sender->getGuid(), sender->getName(), message);
-    }
+    broadcastChatMessage(recipients, ChatDefines::Channels::Yell,
+                         sender->getGuid(), sender->getName(), message);
 }
 
 void ChatManager::handleWhisper(Player* sender, const std::string& targetName, const std::string& message)
@@ -247,15 +227,8 @@ void ChatManager::handleAllChat(Player* sender, const std::string& message)
     auto players = sWorldManager.getAllPlayers();
 
     // Send to all players (including sender)
-    for (Player* recipient : players)
-    {
-        // Check ignore list
-        if (isIgnoring(recipient->getGuid(), sender->getGuid()))
-            continue;
-
-        sendChatMessage(recipient, ChatDefines::Channels::AllChat,
-                        sender->getGuid(), sender->getName(), message);
-    }
+    broadcastChatMessage(players, ChatDefines::Channels::AllChat,
+                         sender->getGuid(), sender->getName(), message);
 }
 
 // ============================================================================
@@ -553,23 +526,45 @@ void ChatManager::sendChatMessage(Player* recipient, ChatDefines::Channels chann
     recipient->sendPacket(packet.build(StlBuffer{}));
 }
 
-std::vector<Player*> ChatManager::getPlayersInRange(int mapId, float x, float y, float range) const
+void ChatManager::broadcastChatMessage(const std::vector<Player*>& recipients, ChatDefines::Channels channel,
+                                       uint32_t senderGuid, const std::string& senderName,
+                                       const std::string& message)
 {
-    std::vector<Player*> result;
+    // Skip recipients ignoring the sender
+    std::vector<Player*> targets;
+    targets.reserve(recipients.size());
+    for (Player* recipient : recipients)
+    {
+        if (senderGuid != 0 && isIgnoring(recipient->getGuid(), senderGuid))
+            continue;
+        targets.push_back(recipient);
+    }
 
-    auto players = sWorldManager.getPlayersOnMap(mapId);
-    float rangeSq = range * range;
+    if (targets.empty())
+        return;
 
-    for (Player* player : players)
-    {
-        float dx = player->getX() - x;
-        float dy = player->getY() - y;
-        float distSq = dx * dx + dy * dy;
+    // Build the packet once for everyone
+    GP_Server_ChatMsg packet;
+    packet.m_channelId = static_cast<uint8_t>(channel);
+    packet.m_fromGuid = senderGuid;
+    packet.m_fromName = senderName;
+    packet.m_text = message;
 
-        if (distSq <= rangeSq)
-        {
-            result.push_back(player);
-        }
+    sWorldManager.sendToPlayers(targets, packet.build(StlBuffer{}));
+}
+
+std::vector<Player*> ChatManager::getPlayersInRange(int mapId, float x, float y, float range) const
+{
+    SpatialFilter filter;
+    filter.types = SpatialFilter::Players;
+    static thread_local std::vector<SpatialHit> hits;
+    sWorldManager.queryRadius(mapId, x, y, range, filter, hits);
+
+    std::vector<Player*> result;
+    result.reserve(hits.size());
+    for (const SpatialHit& hit : hits)
+    {
+        result.push_back(static_cast<Player*>(hit.entity));
     }
 
     return result;
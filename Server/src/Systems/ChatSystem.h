@@ -143,6 +143,12 @@ private:
                          uint32_t senderGuid, const std::string& senderName,
                          const std::string& message);
 
+    // Same packet to many recipients (skips those ignoring the sender),
+    // serialized once
+    void broadcastChatMessage(const std::vector<Player*>& recipients, ChatDefines::Channels channel,
+                              uint32_t senderGuid, const std::string& senderName,
+                              const std::string& message);
+
     // Get players within range of a position on a map
     std::vector<Player*> getPlayersInRange(int mapId, float x, float y, float range) const;
 
@@ -783,16 +783,18 @@ void GuildManager::sendGuildMessage(Player* sender, const std::string& message)
     chatPacket.pack(packet);
 
     // Send to all online guild members
+    std::vector<Player*> recipients;
     for (const auto& member : guild->members)
     {
         if (member.online)
         {
             if (Player* p = sWorldManager.getPlayer(member.characterGuid))
             {
-                p->sendPacket(packet);
+                recipients.push_back(p);
             }
         }
     }
+    sWorldManager.sendToPlayers(recipients, packet);
 }
 
 // ============================================================================
@@ -595,7 +595,7 @@ void LootManager::markAsLooted(uint32_t targetGuid, uint32_t looterGuid)
 
     if (target)
     {
-        sWorldManager.broadcastToMap(target->getMapId(), buf);
+        sWorldManager.broadcastToVisible(target, buf, true);
     }
 
     LOG_DEBUG("LootManager: Marked object {} as looted", targetGuid);
@@ -253,6 +253,10 @@ void QuestManager::refreshNpcGossipStatuses(Player* player) const
         if (!npc || !npc->isQuestGiver())
             continue;
 
+        // Out-of-range NPCs get the current status when they come into view
+        if (!player->canSee(npc))
+            continue;
+
         // Resend full NPC packet to this player - includes updated gossip status
         sWorldManager.sendNpcTo(player, npc);
     }
@@ -507,7 +507,7 @@ void VendorManager::sendStockUpdate(Npc* vendor, int32_t itemIndex, int32_t newS
     packet.pack(buf);
 
     // Broadcast to nearby players
-    sWorldManager.broadcastToMap(vendor->getMapId(), buf);
+    sWorldManager.broadcastToVisible(vendor, buf);
 }
 
 } // namespace VendorSystem
@@ -0,0 +1,162 @@
+#include "stdafx.h"
+#include "World/ClearanceField.h"
+#include "World/CollisionLayer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr float SQRT2 = 1.41421356f;
+
+    // Beyond any squared distance on a map
+    constexpr double FAR = 1e12;
+
+    // Squared distance transform of one row or column (Felzenszwalb and
+    // Huttenlocher): out[q] = min over p of (q - p)^2 + in[p]
+    void distance1d(const double* in, int n, double* out, int* hull, double* bounds)
+    {
+        int k = 0;
+        hull[0] = 0;
+        bounds[0] = -FAR;
+        bounds[1] = FAR;
+        for (int q = 1; q < n; ++q)
+        {
+            double s = 0.0;
+            for (;;)
+            {
+                int p = hull[k];
+                s = ((in[q] + static_cast<double>(q) * q) - (in[p] + static_cast<double>(p) * p)) / (2.0 * (q - p));
+                if (s > bounds[k] || k == 0)
+                    break;
+                --k;
+            }
+            ++k;
+            hull[k] = q;
+            bounds[k] = s;
+            bounds[k + 1] = FAR;
+        }
+
+        k = 0;
+        for (int q = 0; q < n; ++q)
+        {
+            while (bounds[k + 1] < q)
+                ++k;
+            double d = q - hull[k];
+            out[q] = d * d + in[hull[k]];
+        }
+    }
+}
+
+void ClearanceField::build(const CollisionLayer& walk)
+{
+    m_width = walk.getWidth();
+
+    // One blocked cell of padding all round, so the map edge counts as a wall
+    const int padded = m_width + 2;
+    auto blocked = [&walk](int x, int y) { return walk.isBlocked(x - 1, y - 1); };
+
+    // Distance to the nearest blocked cell in the same column, with a pass
+    // down and a pass up over whole rows (the padding ends every column)
+    std::vector<int32_t> column(static_cast<size_t>(padded) * padded);
+    for (int y = 0; y < padded; ++y)
+    {
+        int32_t* row = column.data() + static_cast<size_t>(y) * padded;
+        for (int x = 0; x < padded; ++x)
+            row[x] = blocked(x, y) ? 0 : row[x - padded] + 1;
+    }
+    for (int y = padded - 2; y > 0; --y)
+    {
+        int32_t* row = column.data() + static_cast<size_t>(y) * padded;
+        for (int x = 0; x < padded; ++x)
+            row[x] = std::min(row[x], row[x + padded] + 1);
+    }
+
+    // Then along each row: exact squared Euclidean distances
+    std::vector<double> in(padded);
+    std::vector<double> out(padded);
+    std::vector<int> hull(padded);
+    std::vector<double> bounds(padded + 1);
+
+    m_steps.assign(static_cast<size_t>(m_width) * m_width, 0);
+    for (int y = 1; y <= m_width; ++y)
+    {
+        const int32_t* row = column.data() + static_cast<size_t>(y) * padded;
+        for (int x = 0; x < padded; ++x)
+            in[x] = static_cast<double>(row[x]) * row[x];
+        distance1d(in.data(), padded, out.data(), hull.data(), bounds.data());
+
+        uint8_t* steps = m_steps.data() + static_cast<size_t>(y - 1) * m_width;
+        for (int x = 0; x < m_width; ++x)
+            steps[x] = static_cast<uint8_t>(std::min(255.0, std::floor(std::sqrt(out[x + 1]) * STEPS_PER_CELL)));
+    }
+}
+
+bool ClearanceField::isClear(float x, float y, float radius) const
+{
+    float clearance = getClearance(static_cast<int>(std::floor(x)), static_cast<int>(std::floor(y)));
+    return clearance > std::max(0.0f, radius);
+}
+
+float ClearanceField::clearLength(float fromX, float fromY, float toX, float toY) const
+{
+    const float dx = toX - fromX;
+    const float dy = toY - fromY;
+    const float length = std::sqrt(dx * dx + dy * dy);
+
+    int cx = static_cast<int>(std::floor(fromX));
+    int cy = static_cast<int>(std::floor(fromY));
+    if (getClearance(cx, cy) <= 0.0f)
+        return 0.0f;
+    if (length < 1e-4f)
+        return length;
+
+    const float ux = dx / length;
+    const float uy = dy / length;
+
+    float t = 0.0f;
+    while (t < length)
+    {
+        float x = fromX + ux * t;
+        float y = fromY + uy * t;
+        cx = static_cast<int>(std::floor(x));
+        cy = static_cast<int>(std::floor(y));
+
+        // Any point within `safe` of this one lies in a cell whose centre is
+        // closer than the clearance to this cell's centre (both points are
+        // at most half a diagonal from their centres), so it is walkable
+        float safe = getClearance(cx, cy) - SQRT2 - 0.01f;
+        if (safe >= length - t)
+            return length;
+        if (safe >= 1.0f)
+        {
+            t += safe;
+            continue;
+        }
+
+        // Close to a wall: step to the next cell the segment enters
+        float exitX = ux > 0.0f ? (cx + 1 - x) / ux : ux < 0.0f ? (cx - x) / ux : length;
+        float exitY = uy > 0.0f ? (cy + 1 - y) / uy : uy < 0.0f ? (cy - y) / uy : length;
+        float exit = t + std::min(exitX, exitY);
+        if (exit >= length)
+            return length;
+
+        t = exit + 1e-3f;
+        int nx = static_cast<int>(std::floor(fromX + ux * t));
+        int ny = static_cast<int>(std::floor(fromY + uy * t));
+        if (getClearance(nx, ny) <= 0.0f)
+            return exit;
+
+        // Through a corner: both cells beside it must be open too
+        if (nx != cx && ny != cy && (getClearance(nx, cy) <= 0.0f || getClearance(cx, ny) <= 0.0f))
+            return exit;
+    }
+    return length;
+}
+
+bool ClearanceField::isSegmentClear(float fromX, float fromY, float toX, float toY) const
+{
+    float dx = toX - fromX;
+    float dy = toY - fromY;
+    return clearLength(fromX, fromY, toX, toY) >= std::sqrt(dx * dx + dy * dy);
+}
@@ -0,0 +1,55 @@
+// ClearanceField - Distance from every cell of a Map to the nearest blocked one
+// Built once at load from the walk layer with an exact Euclidean distance
+// transform (the map edge counts as blocked). A point query is then a single
+// lookup, and a segment walks in steps as long as the clearance it stands
+// on: in the open, one lookup covers the whole segment, and only the stretch
+// that passes close to a wall is checked cell by cell.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class CollisionLayer;
+
+class ClearanceField
+{
+public:
+    // Clearances are stored in 1/STEPS_PER_CELL cells, so they top out at
+    // MAX_CLEARANCE; anything further from a wall reads as that
+    static constexpr int STEPS_PER_CELL = 4;
+    static constexpr float MAX_CLEARANCE = 255.0f / STEPS_PER_CELL;
+
+    void build(const CollisionLayer& walk);
+
+    int getWidth() const { return m_width; }
+
+    // Distance (cells) from cell (x, y) to the nearest blocked cell, rounded
+    // down: 0 for blocked and out-of-bounds cells, 1 next to a wall
+    float getClearance(int x, int y) const
+    {
+        if (static_cast<unsigned>(x) >= static_cast<unsigned>(m_width) ||
+            static_cast<unsigned>(y) >= static_cast<unsigned>(m_width))
+            return 0.0f;
+        return m_steps[static_cast<size_t>(y) * m_width + x] * (1.0f / STEPS_PER_CELL);
+    }
+
+    // The cell holding (x, y) is walkable and so is every cell whose centre
+    // is within `radius` of its centre (radius 0 = just walkable)
+    bool isClear(float x, float y, float radius = 0.0f) const;
+
+    // How far one can walk in a straight line from `from` towards `to`
+    // before entering a blocked cell: the segment length if it is clear,
+    // 0 if `from` itself is blocked. Every cell the segment passes through
+    // is covered, corners included.
+    float clearLength(float fromX, float fromY, float toX, float toY) const;
+
+    bool isSegmentClear(float fromX, float fromY, float toX, float toY) const;
+
+    size_t getMemoryUsage() const { return m_steps.capacity(); }
+
+private:
+    int m_width = 0;
+    std::vector<uint8_t> m_steps;   // Row-major, 1/STEPS_PER_CELL cells each
+};
@@ -0,0 +1,218 @@
+#include "stdafx.h"
+#include "World/CollisionLayer.h"
+#include "World/Map.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+    constexpr uint64_t ALL_ONES = ~0ULL;
+
+    // Index of the lowest / highest set bit of a non-zero word
+    int lowestBit(uint64_t v)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, v);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(v);
+#endif
+    }
+
+    int highestBit(uint64_t v)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, v);
+        return static_cast<int>(index);
+#else
+        return 63 - __builtin_clzll(v);
+#endif
+    }
+
+    // Bits first..last (inclusive) of a row of words
+    bool anyBitInRange(const uint64_t* words, int first, int last)
+    {
+        int firstWord = first >> 6;
+        int lastWord = last >> 6;
+        for (int w = firstWord; w <= lastWord; ++w)
+        {
+            uint64_t mask = ALL_ONES;
+            if (w == firstWord)
+                mask &= ALL_ONES << (first & 63);
+            if (w == lastWord && (last & 63) != 63)
+                mask &= (2ULL << (last & 63)) - 1;
+            if (words[w] & mask)
+                return true;
+        }
+        return false;
+    }
+}
+
+void CollisionLayer::build(const MapCell* cells, int width, uint8_t flag, bool transposed)
+{
+    m_width = width;
+    m_wordsPerRow = (width + 63) / 64;
+    m_bits.assign(static_cast<size_t>(m_wordsPerRow) * width, 0);
+    m_blockedRow.assign(static_cast<size_t>(m_wordsPerRow), ALL_ONES);
+
+    for (int y = 0; y < width; ++y)
+    {
+        uint64_t* rowBits = m_bits.data() + static_cast<size_t>(y) * m_wordsPerRow;
+        for (int x = 0; x < width; ++x)
+        {
+            const MapCell& cell = transposed ? cells[x * width + y] : cells[y * width + x];
+            if (cell.hasFlag(flag))
+                rowBits[x >> 6] |= 1ULL << (x & 63);
+        }
+
+        // Padding past the last cell is blocked so row scans stop there
+        if ((width & 63) != 0)
+            rowBits[m_wordsPerRow - 1] |= ALL_ONES << (width & 63);
+    }
+
+    int blocksPerRow = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    m_blockWordsPerRow = (blocksPerRow + 63) / 64;
+    m_blockBits.assign(static_cast<size_t>(m_blockWordsPerRow) * blocksPerRow, 0);
+    for (int by = 0; by < blocksPerRow; ++by)
+    {
+        int lastY = std::min(width, (by + 1) * BLOCK_SIZE) - 1;
+        for (int bx = 0; bx < blocksPerRow; ++bx)
+        {
+            int firstX = bx * BLOCK_SIZE;
+            int lastX = std::min(width, firstX + BLOCK_SIZE) - 1;
+            for (int y = by * BLOCK_SIZE; y <= lastY; ++y)
+            {
+                if (anyBitInRange(row(y), firstX, lastX))
+                {
+                    m_blockBits[static_cast<size_t>(by) * m_blockWordsPerRow + (bx >> 6)] |= 1ULL << (bx & 63);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+const uint64_t* CollisionLayer::row(int y) const
+{
+    if (static_cast<unsigned>(y) >= static_cast<unsigned>(m_width))
+        return m_blockedRow.data();
+    return m_bits.data() + static_cast<size_t>(y) * m_wordsPerRow;
+}
+
+bool CollisionLayer::blocksClear(int x0, int y0, int x1, int y1) const
+{
+    int bx0 = std::min(x0, x1) / BLOCK_SIZE;
+    int bx1 = std::max(x0, x1) / BLOCK_SIZE;
+    int by0 = std::min(y0, y1) / BLOCK_SIZE;
+    int by1 = std::max(y0, y1) / BLOCK_SIZE;
+    for (int by = by0; by <= by1; ++by)
+    {
+        if (anyBitInRange(m_blockBits.data() + static_cast<size_t>(by) * m_blockWordsPerRow, bx0, bx1))
+            return false;
+    }
+    return true;
+}
+
+bool CollisionLayer::traceClear(int x0, int y0, int x1, int y1) const
+{
+    // Both ends are inside the map, so every cell between them is too
+    int dx = std::abs(x1 - x0);
+    int dy = -std::abs(y1 - y0);
+    int sx = x0 < x1 ? 1 : -1;
+    int sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+
+    while (x0 != x1 || y0 != y1)
+    {
+        int e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x0 += sx; }
+        if (e2 <= dx) { err += dx; y0 += sy; }
+
+        if ((m_bits[static_cast<size_t>(y0) * m_wordsPerRow + (x0 >> 6)] >> (x0 & 63)) & 1)
+            return false;
+    }
+    return true;
+}
+
+bool CollisionLayer::isSegmentClear(float fromX, float fromY, float toX, float toY) const
+{
+    int x0 = static_cast<int>(std::floor(fromX));
+    int y0 = static_cast<int>(std::floor(fromY));
+    int x1 = static_cast<int>(std::floor(toX));
+    int y1 = static_cast<int>(std::floor(toY));
+
+    if (isBlocked(x0, y0) || isBlocked(x1, y1))
+        return false;
+    return blocksClear(x0, y0, x1, y1) || traceClear(x0, y0, x1, y1);
+}
+
+size_t CollisionLayer::segmentsClear(float fromX, float fromY, const float* toX, const float* toY,
+                                     size_t count, uint8_t* clear) const
+{
+    int x0 = static_cast<int>(std::floor(fromX));
+    int y0 = static_cast<int>(std::floor(fromY));
+    if (isBlocked(x0, y0))
+    {
+        std::fill(clear, clear + count, 0);
+        return 0;
+    }
+
+    // The start cell is checked once; most targets are then settled by their
+    // own cell or the block summary without tracing
+    size_t visible = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        int x1 = static_cast<int>(std::floor(toX[i]));
+        int y1 = static_cast<int>(std::floor(toY[i]));
+        bool isClear = !isBlocked(x1, y1) && (blocksClear(x0, y0, x1, y1) || traceClear(x0, y0, x1, y1));
+        clear[i] = isClear ? 1 : 0;
+        visible += clear[i];
+    }
+    return visible;
+}
+
+int CollisionLayer::findRowStop(int x, int y, int dir) const
+{
+    const uint64_t* cells = row(y);
+    const uint64_t* above = row(y - 1);
+    const uint64_t* below = row(y + 1);
+
+    int w = x >> 6;
+    if (dir > 0)
+    {
+        uint64_t mask = ALL_ONES << (x & 63);
+        for (; w < m_wordsPerRow; ++w, mask = ALL_ONES)
+        {
+            // Bit i of the shifted rows holds the cell one step behind, i - 1
+            // (x = -1 is out of bounds, so blocked)
+            uint64_t aboveBehind = (above[w] << 1) | (w > 0 ? above[w - 1] >> 63 : 1);
+            uint64_t belowBehind = (below[w] << 1) | (w > 0 ? below[w - 1] >> 63 : 1);
+            uint64_t forced = (~above[w] & aboveBehind) | (~below[w] & belowBehind);
+            uint64_t stops = (cells[w] | forced) & mask;
+            if (stops)
+                return std::min(m_width, (w << 6) + lowestBit(stops));
+        }
+        return m_width;
+    }
+
+    uint64_t mask = (x & 63) == 63 ? ALL_ONES : (2ULL << (x & 63)) - 1;
+    for (; w >= 0; --w, mask = ALL_ONES)
+    {
+        // Bit i of the shifted rows holds the cell one step behind, i + 1
+        bool last = w + 1 >= m_wordsPerRow;
+        uint64_t aboveBehind = (above[w] >> 1) | (last ? 1ULL << 63 : above[w + 1] << 63);
+        uint64_t belowBehind = (below[w] >> 1) | (last ? 1ULL << 63 : below[w + 1] << 63);
+        uint64_t forced = (~above[w] & aboveBehind) | (~below[w] & belowBehind);
+        uint64_t stops = (cells[w] | forced) & mask;
+        if (stops)
+            return (w << 6) + highestBit(stops);
+    }
+    return -1;
+}
@@ -0,0 +1,65 @@
+// CollisionLayer - One collision flag of a Map as a row-major bitset
+// One bit per cell (set = blocked), each row padded to whole 64-bit words with
+// blocked bits, plus one bit per BLOCK_SIZE x BLOCK_SIZE block that is set if
+// any cell in it is blocked. Segment tests skip every cell when the blocks
+// around the segment are clear, and row scans test 64 cells per step, which
+// is what Jump Point Search spends its time on.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct MapCell;
+
+class CollisionLayer
+{
+public:
+    static constexpr int BLOCK_SIZE = 8;
+
+    // Bits for every cell carrying `flag`. Transposed layers store column x
+    // as row x, so column scans can use the row code.
+    void build(const MapCell* cells, int width, uint8_t flag, bool transposed = false);
+
+    int getWidth() const { return m_width; }
+
+    // Out of bounds counts as blocked
+    bool isBlocked(int x, int y) const
+    {
+        if (static_cast<unsigned>(x) >= static_cast<unsigned>(m_width) ||
+            static_cast<unsigned>(y) >= static_cast<unsigned>(m_width))
+            return true;
+        return (m_bits[static_cast<size_t>(y) * m_wordsPerRow + (x >> 6)] >> (x & 63)) & 1;
+    }
+
+    // Same cells as MapLogic::checkLosToC (Bresenham from the `from` cell to
+    // the `to` cell, both included): true if none of them is blocked
+    bool isSegmentClear(float fromX, float fromY, float toX, float toY) const;
+
+    // isSegmentClear from one point to `count` others (e.g. every AoE
+    // candidate): clear[i] is 1 or 0. Returns how many are clear.
+    size_t segmentsClear(float fromX, float fromY, const float* toX, const float* toY,
+                         size_t count, uint8_t* clear) const;
+
+    // Jump Point Search straight move along row y from x in direction dir
+    // (+1/-1): the first cell at or after x that is blocked, or that is open
+    // with an open cell beside it (row y-1 or y+1) whose predecessor along the
+    // row is blocked (a forced neighbour). Returns -1 or the width if the row
+    // ends first.
+    int findRowStop(int x, int y, int dir) const;
+
+    size_t getMemoryUsage() const { return (m_bits.size() + m_blockBits.size()) * sizeof(uint64_t); }
+
+private:
+    const uint64_t* row(int y) const;
+    bool blocksClear(int x0, int y0, int x1, int y1) const;
+    bool traceClear(int x0, int y0, int x1, int y1) const;
+
+    int m_width = 0;
+    int m_wordsPerRow = 0;
+    int m_blockWordsPerRow = 0;
+    std::vector<uint64_t> m_bits;
+    std::vector<uint64_t> m_blockBits;
+    std::vector<uint64_t> m_blockedRow;     // All ones: rows -1 and width
+};
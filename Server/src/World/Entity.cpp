@@ -208,18 +208,21 @@ void Entity::broadcastVariable(ObjDefines::Variable var, int32_t value)
         return;
     }
 
-    // For critical state changes (IsDead, dynamic flags, etc.),
-    // resend the full entity packet to ensure client is in sync
-    if (getType() == MutualObject::Type::Player)
-    {
-        ::Player* selfPlayer = static_cast<::Player*>(this);
-        // Resend full player data to all viewers (includes updated variables)
-        sWorldManager.broadcastPlayerUpdate(selfPlayer);
-    }
-    else if (getType() == MutualObject::Type::Npc)
+    if (getType() != MutualObject::Type::Player && getType() != MutualObject::Type::Npc)
+        return;
+
+    // For critical state changes (IsDead, dynamic flags, etc.) the viewers get
+    // the full entity packet again. Queue it so several changes in one tick
+    // (death, loot flag, gossip status...) go out as a single update.
+    size_t bit = static_cast<size_t>(var);
+    if (bit >= m_dirtyVariables.size())
+        return;
+
+    bool queued = m_dirtyVariables.any();
+    m_dirtyVariables.set(bit);
+    ++m_pendingVariableChanges;
+    if (!queued)
     {
-        ::Npc* selfNpc = static_cast<::Npc*>(this);
-        // Resend full NPC data to all players on the map
-        sWorldManager.broadcastNpcUpdate(selfNpc);
+        sWorldManager.queueEntityUpdate(this);
     }
 }
@@ -3,10 +3,12 @@
 #include "MutualObject.h"
 #include "ObjDefines.h"
 #include "../Combat/AuraSystem.h"
+#include "MoveSpline.h"
 
 #include <string>
 #include <functional>
 #include <set>
+#include <bitset>
 
 class Map;
 
@@ -27,6 +29,10 @@ public:
     void setPosition(float x, float y);
     void setOrientation(float orientation) { m_orientation = orientation; }
 
+    // Path the entity is walking; its position advances along it each tick
+    MoveSpline& getMoveSpline() { return m_moveSpline; }
+    const MoveSpline& getMoveSpline() const { return m_moveSpline; }
+
     // Map reference
     Map* getMap() const { return m_map; }
     void setMap(Map* map) { m_map = map; }
@@ -56,16 +62,19 @@ public:
     bool isInRange(const Entity* other, float range) const;
     bool isInRange(float x, float y, float range) const;
 
-    // Visibility - entities that can see this entity
-    void addVisibleTo(Entity* viewer) { m_visibleTo.insert(viewer); }
-    void removeVisibleTo(Entity* viewer) { m_visibleTo.erase(viewer); }
-    const std::set<Entity*>& getVisibleTo() const { return m_visibleTo; }
+    // Visibility - players that can see this entity. Kept by guid and
+    // resolved through WorldManager, so one that left resolves to nothing.
+    void addVisibleTo(const Entity* viewer) { m_visibleTo.insert(viewer->getGuid()); }
+    void removeVisibleTo(const Entity* viewer) { m_visibleTo.erase(viewer->getGuid()); }
+    bool isVisibleTo(const Entity* viewer) const { return m_visibleTo.count(viewer->getGuid()) > 0; }
+    const std::set<uint32_t>& getVisibleTo() const { return m_visibleTo; }
     void clearVisibleTo() { m_visibleTo.clear(); }
 
-    // Entities this entity can see
-    void addCanSee(Entity* target) { m_canSee.insert(target); }
-    void removeCanSee(Entity* target) { m_canSee.erase(target); }
-    const std::set<Entity*>& getCanSee() const { return m_canSee; }
+    // Entities (players and NPCs) this entity can see, by guid
+    void addCanSee(const Entity* target) { m_canSee.insert(target->getGuid()); }
+    void removeCanSee(const Entity* target) { m_canSee.erase(target->getGuid()); }
+    bool canSee(const Entity* target) const { return m_canSee.count(target->getGuid()) > 0; }
+    const std::set<uint32_t>& getCanSee() const { return m_canSee; }
     void clearCanSee() { m_canSee.clear(); }
 
     // Aura system (Task 5.8)
@@ -90,8 +99,15 @@ public:
     void setInvulnerable(bool invuln) { m_invulnerable = invuln; }
 
     // Broadcast variable update to nearby players
+    // Marks the variable dirty; WorldManager sends the entity once at the end of the tick
     void broadcastVariable(ObjDefines::Variable var, int32_t value);
 
+    // Variables changed since the last flush (bit index = variable id)
+    using VariableMask = std::bitset<static_cast<size_t>(ObjDefines::Variable::MaxVariable)>;
+    const VariableMask& getDirtyVariables() const { return m_dirtyVariables; }
+    uint32_t getPendingVariableChanges() const { return m_pendingVariableChanges; }
+    void clearDirtyVariables() { m_dirtyVariables.reset(); m_pendingVariableChanges = 0; }
+
 protected:
     std::string m_name;
 
@@ -100,6 +116,7 @@ protected:
     float m_x = 0.0f;
     float m_y = 0.0f;
     float m_orientation = 0.0f;
+    MoveSpline m_moveSpline;
 
     // Map reference
     Map* m_map = nullptr;
@@ -113,9 +130,13 @@ protected:
     // Variable change callback
     VariableCallback m_variableCallback;
 
+    // Pending end-of-tick update
+    VariableMask m_dirtyVariables;
+    uint32_t m_pendingVariableChanges = 0;  // broadcastVariable calls folded into it
+
     // Visibility tracking
-    std::set<Entity*> m_visibleTo;  // Who can see me
-    std::set<Entity*> m_canSee;     // Who I can see
+    std::set<uint32_t> m_visibleTo;  // Who can see me (guids)
+    std::set<uint32_t> m_canSee;     // Who I can see (guids)
 
     // Aura manager (Task 5.8)
     AuraManager m_auras;
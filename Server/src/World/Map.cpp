@@ -1,26 +1,32 @@
 #include "stdafx.h"
 #include "Map.h"
 #include "../Core/Logger.h"
+#include "StlBuffer.h"
 
+#include <chrono>
+#include <filesystem>
 #include <fstream>
 
 // Constants matching client's GameMap::Defines
 namespace MapDefines
 {
-    constexpr int NumLayers = 4;
+    constexpr int NumLayers = 3;  // Layer slots stored per cell in .map files
     constexpr int BaseCellWidth = 64;
     constexpr int BaseCellHeight = 32;
 }
 
-bool Map::load(const std::string& filepath)
+// Server map cache (<name>.smap): header, one flags byte per cell, NavGraph
+namespace
 {
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file.is_open())
-    {
-        LOG_ERROR("Map: Failed to open file: {}", filepath);
-        return false;
-    }
+    constexpr uint32_t CACHE_MAGIC = 0x504D5344;  // "DSMP"
+    constexpr uint32_t CACHE_VERSION = 1;
+    constexpr size_t CACHE_HEADER_SIZE = 32;
+}
 
+static_assert(sizeof(MapCell) == 1, "MapCell flags are mapped straight from the .smap file");
+
+bool Map::load(const std::string& filepath)
+{
     // Extract map name from filepath (e.g., "maps/fanadin.map" -> "fanadin")
     size_t lastSlash = filepath.find_last_of("/\\");
     size_t lastDot = filepath.find_last_of('.');
@@ -29,10 +35,60 @@ bool Map::load(const std::string& filepath)
     else
         lastSlash++;
 
+    size_t stemEnd = filepath.size();
     if (lastDot != std::string::npos && lastDot > lastSlash)
+    {
         m_name = filepath.substr(lastSlash, lastDot - lastSlash);
+        stemEnd = lastDot;
+    }
     else
+    {
         m_name = filepath.substr(lastSlash);
+    }
+
+    std::string cachePath = filepath.substr(0, stemEnd) + ".smap";
+
+    // The cache is only trusted for the .map file it was made from. A server
+    // shipped with just the .smap files uses them as they are.
+    std::error_code ec;
+    bool haveSource = std::filesystem::exists(filepath, ec);
+    uint64_t sourceSize = 0;
+    int64_t sourceTime = 0;
+    if (haveSource)
+    {
+        sourceSize = static_cast<uint64_t>(std::filesystem::file_size(filepath, ec));
+        sourceTime = static_cast<int64_t>(std::filesystem::last_write_time(filepath, ec).time_since_epoch().count());
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    m_fromCache = loadCache(cachePath, haveSource, sourceSize, sourceTime);
+    if (!m_fromCache)
+    {
+        if (!loadSource(filepath))
+            return false;
+
+        buildCollision();
+        m_nav.build(*this);
+        if (!writeCache(cachePath, sourceSize, sourceTime))
+            LOG_WARN("Map: Could not write cache %s", cachePath.c_str());
+    }
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - started).count();
+
+    LOG_INFO("Map: Loaded '%s' (%dx%d) from %s in %lld ms (%u regions, %zu entrance nodes)",
+             m_name.c_str(), m_width, m_width, m_fromCache ? "cache" : "source",
+             static_cast<long long>(ms), m_nav.getComponentCount(), m_nav.getNodeCount());
+    return true;
+}
+
+bool Map::loadSource(const std::string& filepath)
+{
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open())
+    {
+        LOG_ERROR("Map: Failed to open file: {}", filepath);
+        return false;
+    }
 
     // Helper to read little-endian int32
     auto readInt32 = [&file]() -> int32_t {
@@ -55,6 +111,7 @@ bool Map::load(const std::string& filepath)
     if (m_width <= 0 || m_width > 10000)
     {
         LOG_ERROR("Map: Invalid map width {} in {}", m_width, filepath);
+        m_width = 0;
         return false;
     }
 
@@ -81,7 +138,7 @@ bool Map::load(const std::string& filepath)
         if (cellId >= 0 && cellId < static_cast<int32_t>(m_cells.size()))
             m_cells[cellId].flags = flags;
 
-        // Skip layer texture data (4 layers)
+        // Skip layer texture data
         for (int layer = 0; layer < MapDefines::NumLayers; ++layer)
         {
             bool hasTexture = false;
@@ -132,17 +189,87 @@ bool Map::load(const std::string& filepath)
         readInt32();  // areaId
     }
 
-    LOG_INFO("Map: Loaded '%s' (%dx%d, %zu cells with flags)",
-             m_name.c_str(), m_width, m_width, numCells);
+    m_cellData = m_cells.data();
+    return true;
+}
+
+void Map::buildCollision()
+{
+    m_walkLayer.build(m_cellData, m_width, CellFlags::Unwalkable);
+    m_walkLayerT.build(m_cellData, m_width, CellFlags::Unwalkable, true);
+    m_sightLayer.build(m_cellData, m_width, CellFlags::CollideBlock);
+    m_clearance.build(m_walkLayer);
+}
+
+bool Map::loadCache(const std::string& cachePath, bool checkSource, uint64_t sourceSize, int64_t sourceTime)
+{
+    if (!m_file.open(cachePath))
+        return false;
+
+    StlBuffer header = StlBuffer::view(m_file.data(), m_file.size());
+    uint32_t magic = 0, version = 0;
+    uint64_t cachedSize = 0;
+    int64_t cachedTime = 0;
+    int32_t width = 0, reserved = 0;
+    header >> magic >> version >> cachedSize >> cachedTime >> width >> reserved;
+
+    size_t numCells = static_cast<size_t>(width > 0 ? width : 0) * static_cast<size_t>(width > 0 ? width : 0);
+    bool valid = !header.hasError() && magic == CACHE_MAGIC && version == CACHE_VERSION &&
+                 width > 0 && width <= 10000 && m_file.size() >= CACHE_HEADER_SIZE + numCells &&
+                 (!checkSource || (cachedSize == sourceSize && cachedTime == sourceTime));
+    if (!valid)
+    {
+        m_file.close();
+        return false;
+    }
 
+    // Flags are used in place, straight from the mapped pages
+    m_width = width;
+    m_cells.clear();
+    m_cellData = reinterpret_cast<const MapCell*>(m_file.data() + CACHE_HEADER_SIZE);
+    buildCollision();
+
+    StlBuffer nav = StlBuffer::view(m_file.data() + CACHE_HEADER_SIZE + numCells,
+                                    m_file.size() - CACHE_HEADER_SIZE - numCells);
+    if (!m_nav.read(nav, m_width))
+    {
+        m_file.close();
+        m_cellData = nullptr;
+        m_width = 0;
+        return false;
+    }
+    return true;
+}
+
+bool Map::writeCache(const std::string& cachePath, uint64_t sourceSize, int64_t sourceTime) const
+{
+    StlBuffer buf;
+    buf.reserve(CACHE_HEADER_SIZE + m_cells.size() + m_nav.getMemoryUsage());
+    buf << CACHE_MAGIC << CACHE_VERSION << sourceSize << sourceTime << static_cast<int32_t>(m_width)
+        << static_cast<int32_t>(0);
+    buf.write(reinterpret_cast<const char*>(m_cellData), static_cast<size_t>(getNumCells()));
+    m_nav.write(buf);
+
+    // Written aside and renamed so a reader never maps a half-written file
+    std::string tempPath = cachePath + ".tmp";
+    if (!buf.writeFile(tempPath))
+        return false;
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec)
+    {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
     return true;
 }
 
 const MapCell* Map::getCell(int cellId) const
 {
-    if (cellId < 0 || cellId >= static_cast<int>(m_cells.size()))
+    if (cellId < 0 || cellId >= getNumCells())
         return nullptr;
-    return &m_cells[cellId];
+    return &m_cellData[cellId];
 }
 
 const MapCell* Map::getCell(int x, int y) const
@@ -152,28 +279,26 @@ const MapCell* Map::getCell(int x, int y) const
 
 bool Map::isWalkable(int cellId) const
 {
-    const MapCell* cell = getCell(cellId);
-    if (!cell)
+    if (cellId < 0 || cellId >= getNumCells())
         return false;  // Out of bounds = not walkable
-    return (cell->flags & CellFlags::Unwalkable) == 0;
+    return !m_walkLayer.isBlocked(cellId % m_width, cellId / m_width);
 }
 
 bool Map::isWalkable(int x, int y) const
 {
-    return isWalkable(cellIdFromCoords(x, y));
+    return !m_walkLayer.isBlocked(x, y);
 }
 
 bool Map::blocksLineOfSight(int cellId) const
 {
-    const MapCell* cell = getCell(cellId);
-    if (!cell)
+    if (cellId < 0 || cellId >= getNumCells())
         return true;  // Out of bounds = blocks
-    return (cell->flags & CellFlags::CollideBlock) != 0;
+    return m_sightLayer.isBlocked(cellId % m_width, cellId / m_width);
 }
 
 bool Map::blocksLineOfSight(int x, int y) const
 {
-    return blocksLineOfSight(cellIdFromCoords(x, y));
+    return m_sightLayer.isBlocked(x, y);
 }
 
 int Map::cellIdFromCoords(int x, int y) const
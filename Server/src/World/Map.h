@@ -1,21 +1,29 @@
 #pragma once
 
+#include "Core/MappedFile.h"
+#include "World/ClearanceField.h"
+#include "World/CollisionLayer.h"
+#include "World/NavGraph.h"
+
 #include <string>
 #include <vector>
 #include <cstdint>
 
-// Cell flags for collision/pathfinding (matches client MapCellT::Flags)
+// Cell flags for collision/pathfinding (matches client MapCellT::Flags).
+// Walls carry both bits; open ground outside rooms is only Unwalkable.
 namespace CellFlags
 {
     constexpr uint8_t None         = 0x00;
-    constexpr uint8_t Unwalkable   = 0x01;  // Cannot walk through
-    constexpr uint8_t CollideBlock = 0x02;  // Blocks line of sight
+    constexpr uint8_t Unwalkable   = 0x20;  // Cannot walk through
+    constexpr uint8_t CollideBlock = 0x40;  // Blocks line of sight
 }
 
 // Server-side map cell - stores only what server needs
 struct MapCell
 {
     uint8_t flags = CellFlags::None;
+
+    bool hasFlag(uint8_t flag) const { return (flags & flag) != 0; }
 };
 
 // Server-side map data loaded from .map files
@@ -25,17 +33,30 @@ public:
     Map() = default;
     ~Map() = default;
 
-    // Load map from binary .map file
+    // Load map from binary .map file. The server keeps what it needs (cell
+    // flags and the NavGraph) in <name>.smap beside it: written on the first
+    // load, memory-mapped on later ones, and rebuilt when the .map changes.
     bool load(const std::string& filepath);
 
+    // The last load() came from the .smap cache
+    bool isFromCache() const { return m_fromCache; }
+
     // Map dimensions
     int getWidth() const { return m_width; }
     int getHeight() const { return m_width; }  // Maps are square
     int getNumCells() const { return m_width * m_width; }
 
+    // Names the shared MapLogic templates expect
+    int getMapWidth() const { return m_width; }
+    int getMapHeight() const { return m_width; }
+
     // Cell access by index
     const MapCell* getCell(int cellId) const;
 
+    // All cells, row-major (width * width), for tight loops that do their own
+    // bounds checks
+    const MapCell* getCells() const { return m_cellData; }
+
     // Cell access by coordinates
     const MapCell* getCell(int x, int y) const;
 
@@ -45,6 +66,24 @@ public:
     bool blocksLineOfSight(int cellId) const;
     bool blocksLineOfSight(int x, int y) const;
 
+    // Bitsets of the Unwalkable and CollideBlock flags, built by load().
+    // The transposed walk layer lets column scans use the row code.
+    const CollisionLayer& getWalkLayer() const { return m_walkLayer; }
+    const CollisionLayer& getWalkLayerTransposed() const { return m_walkLayerT; }
+    const CollisionLayer& getSightLayer() const { return m_sightLayer; }
+
+    // Distance to the nearest unwalkable cell, built by load() from the walk
+    // layer: O(1) "walkable with radius" tests, and segment tests that cost
+    // one lookup in the open
+    const ClearanceField& getClearance() const { return m_clearance; }
+
+    // Line of sight between two positions (cell units): no CollideBlock cell
+    // on the way
+    bool hasLineOfSight(float fromX, float fromY, float toX, float toY) const
+    {
+        return m_sightLayer.isSegmentClear(fromX, fromY, toX, toY);
+    }
+
     // Coordinate conversion
     int cellIdFromCoords(int x, int y) const;
     void coordsFromCellId(int cellId, int& x, int& y) const;
@@ -57,9 +96,36 @@ public:
     int getMapId() const { return m_mapId; }
     void setMapId(int id) { m_mapId = id; }
 
+    // Connectivity and cluster graph, built (or read from <name>.smap) by load()
+    const NavGraph& getNav() const { return m_nav; }
+
+    // Heap bytes held by the map (cells when parsed, collision layers, nav).
+    // The mapped .smap is counted apart: its pages are clean file cache the
+    // OS can drop and share.
+    size_t getMemoryUsage() const
+    {
+        return m_cells.capacity() * sizeof(MapCell) + m_walkLayer.getMemoryUsage() +
+               m_walkLayerT.getMemoryUsage() + m_sightLayer.getMemoryUsage() + m_clearance.getMemoryUsage() +
+               m_nav.getMemoryUsage();
+    }
+    size_t getMappedBytes() const { return m_file.size(); }
+
 private:
+    bool loadSource(const std::string& filepath);
+    bool loadCache(const std::string& cachePath, bool checkSource, uint64_t sourceSize, int64_t sourceTime);
+    bool writeCache(const std::string& cachePath, uint64_t sourceSize, int64_t sourceTime) const;
+    void buildCollision();
+
     std::string m_name;
     int m_mapId = 0;
     int m_width = 0;
-    std::vector<MapCell> m_cells;
+    std::vector<MapCell> m_cells;           // Parsed from the .map (empty when mapped)
+    MappedFile m_file;                      // The .smap, when loaded from it
+    const MapCell* m_cellData = nullptr;    // Whichever of the two holds the flags
+    bool m_fromCache = false;
+    CollisionLayer m_walkLayer;
+    CollisionLayer m_walkLayerT;
+    CollisionLayer m_sightLayer;
+    ClearanceField m_clearance;
+    NavGraph m_nav;
 };
@@ -1,9 +1,33 @@
 #include "stdafx.h"
 #include "MapManager.h"
 #include "Map.h"
+#include "../Core/Config.h"
 #include "../Core/Logger.h"
 #include "../Database/GameData.h"
 #include "NpcSpawner.h"
+#include "WorldManager.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <thread>
+
+// Filled in by the loading thread under m_mapMutex, then handed to the tick
+// thread by finishLoad()
+struct MapManager::PendingLoad
+{
+    bool done = false;
+    std::unique_ptr<Map> map;
+    std::vector<NpcSpawnInfo> spawns;
+    long long elapsedMs = 0;
+    std::vector<std::function<void(Map*)>> callbacks;
+
+    // Last, so it is destroyed first: that waits for the task, which still
+    // writes the members above
+    std::future<void> task;
+};
 
 MapManager& MapManager::instance()
 {
@@ -27,6 +51,15 @@ bool MapManager::initialize(const std::string& mapsDirectory)
 
 void MapManager::shutdown()
 {
+    // Loads still running take the lock when they finish: wait for them
+    // (destroying their futures does) without holding it
+    std::unordered_map<int, std::unique_ptr<PendingLoad>> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_mapMutex);
+        pending.swap(m_pendingLoads);
+    }
+    pending.clear();
+
     std::lock_guard<std::mutex> lock(m_mapMutex);
 
     LOG_INFO("MapManager: Shutting down, unloading %zu maps", m_loadedMaps.size());
@@ -35,26 +68,142 @@ void MapManager::shutdown()
 
 Map* MapManager::getMap(int mapId)
 {
-    std::lock_guard<std::mutex> lock(m_mapMutex);
+    std::unique_lock<std::mutex> lock(m_mapMutex);
 
     // Check if already loaded
     auto it = m_loadedMaps.find(mapId);
     if (it != m_loadedMaps.end())
         return it->second.get();
 
-    // Load the map
+    // Loading in the background already: wait for that load instead of
+    // reading the files a second time
+    if (m_pendingLoads.count(mapId) > 0)
+    {
+        m_loadDone.wait(lock, [this, mapId]() {
+            auto pending = m_pendingLoads.find(mapId);
+            return pending == m_pendingLoads.end() || pending->second->done;
+        });
+
+        // Another caller may have installed it while this one slept
+        if (m_pendingLoads.count(mapId) > 0)
+            return finishLoad(lock, mapId);
+        auto loaded = m_loadedMaps.find(mapId);
+        return loaded != m_loadedMaps.end() ? loaded->second.get() : nullptr;
+    }
+
+    // Load the map (a preloaded server never gets here for a known map)
+    auto started = std::chrono::steady_clock::now();
     auto map = loadMapFromFile(mapId);
     if (!map)
         return nullptr;
 
+    LOG_INFO("MapManager: Map %d (%s) was not preloaded; loaded on demand in %lld ms",
+             mapId, map->getName().c_str(),
+             static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                 std::chrono::steady_clock::now() - started).count()));
+
     Map* result = map.get();
     m_loadedMaps[mapId] = std::move(map);
+    lock.unlock();
 
     sNpcSpawner.loadSpawnsForMap(mapId);
 
     return result;
 }
 
+void MapManager::prefetchMap(int mapId)
+{
+    std::lock_guard<std::mutex> lock(m_mapMutex);
+
+    if (m_loadedMaps.count(mapId) == 0)
+        startLoad(mapId);
+}
+
+void MapManager::whenLoaded(int mapId, std::function<void(Map*)> then)
+{
+    Map* map = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mapMutex);
+
+        auto it = m_loadedMaps.find(mapId);
+        if (it != m_loadedMaps.end())
+        {
+            map = it->second.get();
+        }
+        else if (startLoad(mapId))
+        {
+            m_pendingLoads[mapId]->callbacks.push_back(std::move(then));
+            return;
+        }
+    }
+    then(map);
+}
+
+bool MapManager::startLoad(int mapId)
+{
+    if (m_pendingLoads.count(mapId) > 0)
+        return true;
+
+    const MapTemplate* tmpl = getMapTemplate(mapId);
+    if (!tmpl)
+    {
+        LOG_ERROR("MapManager: No template found for map ID %d", mapId);
+        return false;
+    }
+
+    LOG_INFO("MapManager: Loading map %d (%s) in the background", mapId, tmpl->name.c_str());
+
+    // The entry outlives the task: it is only erased once `done` is set
+    auto pending = std::make_unique<PendingLoad>();
+    PendingLoad* load = pending.get();
+    load->task = std::async(std::launch::async, [this, mapId, load]()
+    {
+        auto started = std::chrono::steady_clock::now();
+        std::unique_ptr<Map> map = loadMapFromFile(mapId);
+        std::vector<NpcSpawnInfo> spawns;
+        if (map)
+            spawns = NpcSpawner::querySpawns(mapId);
+        long long elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - started).count();
+
+        std::lock_guard<std::mutex> lock(m_mapMutex);
+        load->map = std::move(map);
+        load->spawns = std::move(spawns);
+        load->elapsedMs = elapsedMs;
+        load->done = true;
+        m_loadDone.notify_all();
+    });
+    m_pendingLoads[mapId] = std::move(pending);
+    return true;
+}
+
+Map* MapManager::finishLoad(std::unique_lock<std::mutex>& lock, int mapId)
+{
+    auto it = m_pendingLoads.find(mapId);
+    std::unique_ptr<PendingLoad> load = std::move(it->second);
+    m_pendingLoads.erase(it);
+
+    Map* map = load->map.get();
+    if (map)
+        m_loadedMaps[mapId] = std::move(load->map);
+    lock.unlock();
+
+    if (map)
+    {
+        LOG_INFO("MapManager: Map %d (%s) loaded in the background in %lld ms",
+                 mapId, map->getName().c_str(), load->elapsedMs);
+        sNpcSpawner.addSpawnsForMap(mapId, load->spawns);
+    }
+    else
+    {
+        LOG_WARN("MapManager: Background load of map %d failed", mapId);
+    }
+
+    for (auto& callback : load->callbacks)
+        callback(map);
+    return map;
+}
+
 const MapTemplate* MapManager::getMapTemplate(int mapId) const
 {
     return sGameData.getMap(mapId);
@@ -66,33 +215,112 @@ bool MapManager::isMapLoaded(int mapId) const
     return m_loadedMaps.find(mapId) != m_loadedMaps.end();
 }
 
-void MapManager::preloadMaps(const std::vector<int>& mapIds)
+void MapManager::preloadMaps(const std::vector<int>& mapIds, int threads)
 {
-    LOG_INFO("MapManager: Preloading %zu maps...", mapIds.size());
-
+    std::vector<int> toLoad;
     for (int mapId : mapIds)
     {
         if (!isMapLoaded(mapId))
+            toLoad.push_back(mapId);
+    }
+    if (toLoad.empty())
+        return;
+
+    if (threads <= 0)
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    threads = std::min(threads, static_cast<int>(toLoad.size()));
+
+    LOG_INFO("MapManager: Preloading %zu maps on %d threads...", toLoad.size(), threads);
+    auto started = std::chrono::steady_clock::now();
+
+    // Maps are independent, so they load side by side; the biggest ones are
+    // started first so one of them does not finish the batch alone
+    std::sort(toLoad.begin(), toLoad.end(), [this](int a, int b) {
+        return mapFileSize(a) > mapFileSize(b);
+    });
+
+    std::vector<std::unique_ptr<Map>> loaded(toLoad.size());
+    std::atomic<size_t> next{0};
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < toLoad.size(); i = next++)
+            loaded[i] = loadMapFromFile(toLoad[i]);
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (std::thread& thread : pool)
+        thread.join();
+
+    // NPC spawns are not thread-safe: seed them here, one map at a time
+    size_t count = 0;
+    size_t fromCache = 0;
+    for (size_t i = 0; i < toLoad.size(); ++i)
+    {
+        if (!loaded[i])
         {
-            Map* map = getMap(mapId);
-            if (map)
-                LOG_INFO("MapManager: Preloaded map %d (%s)", mapId, map->getName().c_str());
-            else
-                LOG_WARN("MapManager: Failed to preload map %d", mapId);
+            LOG_WARN("MapManager: Failed to preload map %d", toLoad[i]);
+            continue;
         }
+
+        ++count;
+        fromCache += loaded[i]->isFromCache() ? 1 : 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mapMutex);
+            m_loadedMaps[toLoad[i]] = std::move(loaded[i]);
+        }
+        sNpcSpawner.loadSpawnsForMap(toLoad[i]);
     }
+
+    LOG_INFO("MapManager: Preloaded %zu maps (%zu from cache) in %lld ms", count, fromCache,
+             static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                 std::chrono::steady_clock::now() - started).count()));
 }
 
-void MapManager::unloadMap(int mapId)
+void MapManager::preloadAllMaps(int threads)
 {
-    std::lock_guard<std::mutex> lock(m_mapMutex);
+    std::vector<int> mapIds;
+    for (const auto& [id, tmpl] : sGameData.getAllMaps())
+        mapIds.push_back(id);
+    preloadMaps(mapIds, threads);
+}
 
-    auto it = m_loadedMaps.find(mapId);
-    if (it != m_loadedMaps.end())
+bool MapManager::unloadMap(int mapId)
+{
+    if (!isMapLoaded(mapId))
+        return false;
+
+    size_t players = sWorldManager.getPlayerCountOnMap(mapId);
+    if (players > 0)
     {
-        LOG_INFO("MapManager: Unloading map %d (%s)", mapId, it->second->getName().c_str());
+        LOG_WARN("MapManager: Not unloading map %d, %zu players are on it", mapId, players);
+        return false;
+    }
+
+    // NPCs hold a pointer to their Map: they go first
+    size_t npcs = sNpcSpawner.unloadMap(mapId);
+    for (Npc* npc : sWorldManager.getNpcsOnMap(mapId))
+    {
+        sWorldManager.removeNpc(npc);
+        ++npcs;
+    }
+
+    std::unique_ptr<Map> map;
+    {
+        std::lock_guard<std::mutex> lock(m_mapMutex);
+        auto it = m_loadedMaps.find(mapId);
+        if (it == m_loadedMaps.end())
+            return false;
+        map = std::move(it->second);
         m_loadedMaps.erase(it);
     }
+    m_idleSeconds.erase(mapId);
+
+    LOG_INFO("MapManager: Unloaded map %d (%s) with %zu NPCs, %zu KB freed",
+             mapId, map->getName().c_str(), npcs, map->getMemoryUsage() / 1024);
+    return true;
 }
 
 bool MapManager::getStartPosition(int mapId, float& x, float& y, float& orientation) const
@@ -120,8 +348,102 @@ std::vector<int> MapManager::getLoadedMapIds() const
 
 void MapManager::update(float deltaTime)
 {
-    (void)deltaTime;
-    // Future: update map-specific logic like respawns, events, etc.
+    std::vector<int> finished;
+    {
+        std::lock_guard<std::mutex> lock(m_mapMutex);
+        for (const auto& [mapId, load] : m_pendingLoads)
+        {
+            if (load->done)
+                finished.push_back(mapId);
+        }
+    }
+    for (int mapId : finished)
+    {
+        std::unique_lock<std::mutex> lock(m_mapMutex);
+        if (m_pendingLoads.count(mapId) > 0)
+            finishLoad(lock, mapId);
+    }
+
+    unloadIdleMaps(deltaTime);
+}
+
+void MapManager::unloadIdleMaps(float deltaTime)
+{
+    float idleLimit = sConfig.getMapIdleUnload();
+    if (idleLimit <= 0.0f)
+        return;
+
+    // Player counts are all that matter here: once a second is plenty
+    m_idleCheckTimer += deltaTime;
+    if (m_idleCheckTimer < 1.0f)
+        return;
+    float elapsed = m_idleCheckTimer;
+    m_idleCheckTimer = 0.0f;
+
+    for (int mapId : getLoadedMapIds())
+    {
+        if (mapId == m_defaultStartMap || sWorldManager.getPlayerCountOnMap(mapId) > 0)
+        {
+            m_idleSeconds.erase(mapId);
+            continue;
+        }
+
+        float& idle = m_idleSeconds[mapId];
+        idle += elapsed;
+        if (idle >= idleLimit)
+            unloadMap(mapId);
+    }
+}
+
+void MapManager::logStats() const
+{
+    struct MapInfo
+    {
+        int id;
+        std::string name;
+        size_t heap;
+        size_t mapped;
+    };
+
+    std::vector<MapInfo> maps;
+    size_t pending = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mapMutex);
+        for (const auto& [mapId, map] : m_loadedMaps)
+            maps.push_back({mapId, map->getName(), map->getMemoryUsage(), map->getMappedBytes()});
+        pending = m_pendingLoads.size();
+    }
+    std::sort(maps.begin(), maps.end(), [](const MapInfo& a, const MapInfo& b) { return a.heap > b.heap; });
+
+    size_t totalHeap = 0;
+    size_t totalMapped = 0;
+    std::string perMap;
+    for (const MapInfo& info : maps)
+    {
+        totalHeap += info.heap;
+        totalMapped += info.mapped;
+
+        char entry[128];
+        snprintf(entry, sizeof(entry), "%s%s %zu KB (%zu npcs)", perMap.empty() ? "" : ", ",
+                 info.name.c_str(), info.heap / 1024, sWorldManager.getNpcsOnMap(info.id).size());
+        perMap += entry;
+    }
+
+    LOG_INFO("Maps: %zu loaded, %zu loading, %.1f MB heap + %.1f MB mapped",
+             maps.size(), pending, totalHeap / (1024.0 * 1024.0), totalMapped / (1024.0 * 1024.0));
+    if (!perMap.empty())
+        LOG_INFO("Map memory: %s", perMap.c_str());
+}
+
+uintmax_t MapManager::mapFileSize(int mapId) const
+{
+    const MapTemplate* tmpl = getMapTemplate(mapId);
+    if (!tmpl)
+        return 0;
+
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(m_mapsDirectory + tmpl->name + ".map", ec);
+    return ec ? 0 : size;
 }
 
 std::unique_ptr<Map> MapManager::loadMapFromFile(int mapId)
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 #include <mutex>
+#include <condition_variable>
+#include <functional>
 
 class Map;
 struct MapTemplate;  // Forward declaration (defined in GameData.h)
@@ -21,20 +24,35 @@ public:
     // Shutdown - unloads all maps
     void shutdown();
 
-    // Get a map by ID (loads it if not already loaded)
+    // Get a map by ID (loads it if not already loaded, waiting for a
+    // background load of it instead of starting a second one)
     Map* getMap(int mapId);
 
+    // Start loading a map (and reading its NPC spawns) on a background
+    // thread; no-op if it is loaded or already loading
+    void prefetchMap(int mapId);
+
+    // Run `then` once the map is loaded: right away if it is, otherwise when
+    // its background load is installed, normally by update() on the tick
+    // thread (with nullptr if the load failed)
+    void whenLoaded(int mapId, std::function<void(Map*)> then);
+
     // Get map template (metadata) by ID - from GameData
     const MapTemplate* getMapTemplate(int mapId) const;
 
     // Check if a map is loaded
     bool isMapLoaded(int mapId) const;
 
-    // Preload specific maps (e.g., starting zones)
-    void preloadMaps(const std::vector<int>& mapIds);
+    // Preload specific maps (e.g., starting zones), loading them in parallel
+    // on `threads` threads (0 = one per core) and then seeding their NPCs
+    void preloadMaps(const std::vector<int>& mapIds, int threads = 0);
+
+    // Preload every map GameData knows, so no player ever waits on a load
+    void preloadAllMaps(int threads = 0);
 
-    // Unload a map (if no players are on it)
-    void unloadMap(int mapId);
+    // Unload a map (if no players are on it), removing its NPCs first.
+    // Tick thread only, outside the map jobs. Returns true if it unloaded.
+    bool unloadMap(int mapId);
 
     // Get default starting map ID
     int getDefaultStartMapId() const { return m_defaultStartMap; }
@@ -45,24 +63,54 @@ public:
     // Get all loaded map IDs
     std::vector<int> getLoadedMapIds() const;
 
-    // Update all maps (called each tick)
+    // Install finished background loads and run their callbacks, then
+    // unload maps that had no players for MapIdleUnload seconds (called each
+    // tick from the tick thread, after the map jobs)
     void update(float deltaTime);
 
+    // Log the loaded maps with their memory and NPC counts
+    void logStats() const;
+
 private:
     MapManager() = default;
     ~MapManager() = default;
     MapManager(const MapManager&) = delete;
     MapManager& operator=(const MapManager&) = delete;
 
-    // Load a single map from file
+    // Load a single map from file (safe to call from several threads)
     std::unique_ptr<Map> loadMapFromFile(int mapId);
 
+    // Size of a map's .map file (0 if missing), to start big loads first
+    uintmax_t mapFileSize(int mapId) const;
+
+    // A background load in flight (defined in MapManager.cpp)
+    struct PendingLoad;
+
+    // Start a background load if none is running; m_mapMutex must be held.
+    // False if the map has no template.
+    bool startLoad(int mapId);
+
+    // Install a finished background load: insert the map, seed its NPCs and
+    // run its callbacks. Called with `lock` held on m_mapMutex; returns with
+    // it released.
+    Map* finishLoad(std::unique_lock<std::mutex>& lock, int mapId);
+
+    void unloadIdleMaps(float deltaTime);
+
     std::string m_mapsDirectory;
     int m_defaultStartMap = 1;  // fanadin
 
     // Loaded maps indexed by ID
     std::unordered_map<int, std::unique_ptr<Map>> m_loadedMaps;
 
+    // Background loads in flight; m_loadDone wakes getMap() calls waiting on one
+    std::unordered_map<int, std::unique_ptr<PendingLoad>> m_pendingLoads;
+    std::condition_variable m_loadDone;
+
+    // Seconds each loaded map has been without players (tick thread only)
+    std::unordered_map<int, float> m_idleSeconds;
+    float m_idleCheckTimer = 0.0f;
+
     // Thread safety for map loading
     mutable std::mutex m_mapMutex;
 };
@@ -0,0 +1,69 @@
+#include "stdafx.h"
+#include "World/MapNpcList.h"
+#include "World/Npc.h"
+
+bool MapNpcList::contains(const Npc* npc) const
+{
+    size_t slot = npc->getMapSlot();
+    return slot < npcs.size() && npcs[slot] == npc;
+}
+
+void MapNpcList::add(Npc* npc)
+{
+    if (!contains(npc))
+    {
+        npc->setMapSlot(npcs.size());
+        npcs.push_back(npc);
+        x.push_back(0.0f);
+        y.push_back(0.0f);
+        sleepy.push_back(0);
+        dormantTime.push_back(0.0f);
+    }
+
+    size_t slot = npc->getMapSlot();
+    x[slot] = npc->getX();
+    y[slot] = npc->getY();
+    sleepy[slot] = 0;
+    dormantTime[slot] = 0.0f;
+}
+
+void MapNpcList::remove(Npc* npc)
+{
+    if (!contains(npc))
+        return;
+
+    size_t slot = npc->getMapSlot();
+    size_t last = npcs.size() - 1;
+    if (slot != last)
+    {
+        npcs[slot] = npcs[last];
+        x[slot] = x[last];
+        y[slot] = y[last];
+        sleepy[slot] = sleepy[last];
+        dormantTime[slot] = dormantTime[last];
+        npcs[slot]->setMapSlot(slot);
+    }
+
+    npcs.pop_back();
+    x.pop_back();
+    y.pop_back();
+    sleepy.pop_back();
+    dormantTime.pop_back();
+    npc->setMapSlot(Npc::NoMapSlot);
+}
+
+void MapNpcList::syncPosition(const Npc* npc)
+{
+    if (!contains(npc))
+        return;
+
+    size_t slot = npc->getMapSlot();
+    x[slot] = npc->getX();
+    y[slot] = npc->getY();
+}
+
+void MapNpcList::wake(const Npc* npc)
+{
+    if (contains(npc))
+        sleepy[npc->getMapSlot()] = 0;
+}
@@ -0,0 +1,36 @@
+// MapNpcList - Spawned NPCs of one map in dense parallel arrays
+// Index i of every array describes the same NPC. The fields a map job scans
+// each tick (position, whether the NPC may sleep, how long it has slept) are
+// kept here so NPCs that stay asleep are never dereferenced. Removal swaps the
+// last NPC into the hole; each Npc remembers its own index.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Npc;
+
+struct MapNpcList
+{
+    std::vector<Npc*> npcs;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<uint8_t> sleepy;      // Idle or dead at the end of its last update
+    std::vector<float> dormantTime;   // Seconds skipped while asleep (0 = awake)
+
+    size_t size() const { return npcs.size(); }
+    bool empty() const { return npcs.empty(); }
+    bool contains(const Npc* npc) const;
+
+    // Append (or refresh, if already listed) an NPC as awake
+    void add(Npc* npc);
+    void remove(Npc* npc);
+
+    // Copy the NPC's position into the arrays after it moved
+    void syncPosition(const Npc* npc);
+
+    // Keep the NPC awake until its next update decides otherwise
+    void wake(const Npc* npc);
+};
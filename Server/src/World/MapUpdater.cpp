@@ -0,0 +1,91 @@
+#include "stdafx.h"
+#include "World/MapUpdater.h"
+#include "Core/Logger.h"
+
+MapUpdater::~MapUpdater()
+{
+    deactivate();
+}
+
+void MapUpdater::activate(int threadCount)
+{
+    if (isActive() || threadCount <= 0)
+        return;
+
+    m_stopping = false;
+    m_workers.reserve(static_cast<size_t>(threadCount));
+    for (int i = 0; i < threadCount; ++i)
+    {
+        m_workers.emplace_back(&MapUpdater::workerThread, this);
+    }
+
+    LOG_INFO("MapUpdater: %d map update threads", threadCount);
+}
+
+void MapUpdater::deactivate()
+{
+    if (!isActive())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_jobReady.notify_all();
+
+    for (std::thread& worker : m_workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    m_workers.clear();
+}
+
+void MapUpdater::schedule(std::function<void()> job)
+{
+    if (!isActive())
+    {
+        job();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(job));
+        ++m_pending;
+    }
+    m_jobReady.notify_one();
+}
+
+void MapUpdater::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobsDone.wait(lock, [this] { return m_pending == 0; });
+}
+
+void MapUpdater::workerThread()
+{
+    for (;;)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobReady.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+
+            // Drain the queue before stopping so wait() never hangs
+            if (m_queue.empty())
+                return;
+
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        job();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_pending == 0)
+                m_jobsDone.notify_all();
+        }
+    }
+}
@@ -0,0 +1,51 @@
+// MapUpdater - Worker pool that ticks maps in parallel
+// WorldManager::update() schedules one job per map with entities on it and
+// waits for all of them before the serial end-of-tick work (the barrier).
+// [World] MapThreads=0 runs no threads: jobs run inline on the tick thread.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class MapUpdater
+{
+public:
+    MapUpdater() = default;
+    ~MapUpdater();
+
+    MapUpdater(const MapUpdater&) = delete;
+    MapUpdater& operator=(const MapUpdater&) = delete;
+
+    // Start threadCount worker threads (0 = none, jobs run inline)
+    void activate(int threadCount);
+
+    // Finish queued jobs and join the workers
+    void deactivate();
+
+    bool isActive() const { return !m_workers.empty(); }
+    size_t getThreadCount() const { return m_workers.size(); }
+
+    // Queue a job (runs it immediately when there are no workers)
+    void schedule(std::function<void()> job);
+
+    // Block until every scheduled job has finished
+    void wait();
+
+private:
+    void workerThread();
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_queue;
+    size_t m_pending = 0;    // Queued plus running
+    bool m_stopping = false;
+
+    std::mutex m_mutex;
+    std::condition_variable m_jobReady;
+    std::condition_variable m_jobsDone;
+};
@@ -0,0 +1,53 @@
+#include "stdafx.h"
+#include "World/MoveSpline.h"
+
+#include <cmath>
+
+void MoveSpline::start(float fromX, float fromY, std::vector<Point> path, float speed)
+{
+    m_path = std::move(path);
+    m_next = 0;
+    m_speed = speed;
+    m_startX = fromX;
+    m_startY = fromY;
+    m_goal = getDestination();
+    m_active = !m_path.empty() && speed > 0.0f;
+}
+
+void MoveSpline::stop()
+{
+    m_active = false;
+    m_path.clear();
+    m_next = 0;
+}
+
+bool MoveSpline::advance(float deltaTime, float& x, float& y)
+{
+    if (!m_active)
+        return false;
+
+    float budget = m_speed * deltaTime;
+    while (m_next < m_path.size())
+    {
+        const Point& target = m_path[m_next];
+        float dx = target.x - x;
+        float dy = target.y - y;
+        float distance = std::sqrt(dx * dx + dy * dy);
+
+        if (distance > budget)
+        {
+            x += dx / distance * budget;
+            y += dy / distance * budget;
+            return false;
+        }
+
+        // Reached this point; carry the rest of the step into the next one
+        x = target.x;
+        y = target.y;
+        budget -= distance;
+        ++m_next;
+    }
+
+    m_active = false;
+    return true;
+}
@@ -0,0 +1,58 @@
+// MoveSpline - Server-side progress along a movement path
+// The server walks the same path it sends in GP_Server_UnitSpline, at the
+// unit's speed, so the position used for visibility, aggro and range checks is
+// where the unit is now rather than where it is heading.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+class MoveSpline
+{
+public:
+    struct Point
+    {
+        float x;
+        float y;
+    };
+
+    // Start walking from (fromX, fromY) through the path points
+    void start(float fromX, float fromY, std::vector<Point> path, float speed);
+
+    // Stop where the unit is (the caller keeps its current position)
+    void stop();
+
+    bool isActive() const { return m_active; }
+    float getSpeed() const { return m_speed; }
+    float getStartX() const { return m_startX; }
+    float getStartY() const { return m_startY; }
+    const std::vector<Point>& getPath() const { return m_path; }
+
+    // Path points not reached yet (what a viewer joining mid-walk needs)
+    std::vector<Point> getRemainingPath() const
+    {
+        return m_active ? std::vector<Point>(m_path.begin() + m_next, m_path.end()) : std::vector<Point>();
+    }
+
+    // Last point of the path (only meaningful while active)
+    Point getDestination() const { return m_path.empty() ? Point{m_startX, m_startY} : m_path.back(); }
+
+    // Where the walk is meant to end up. start() sets it to the destination;
+    // a path planned one leg at a time sets the final goal after start().
+    Point getGoal() const { return m_goal; }
+    void setGoal(Point goal) { m_goal = goal; }
+
+    // Move (x, y) deltaTime seconds further along the path. Returns true when
+    // the end was reached on this call; the spline is then inactive.
+    bool advance(float deltaTime, float& x, float& y);
+
+private:
+    std::vector<Point> m_path;
+    size_t m_next = 0;          // Path point being walked towards
+    float m_speed = 0.0f;       // Cells per second
+    float m_startX = 0.0f;
+    float m_startY = 0.0f;
+    Point m_goal{0.0f, 0.0f};
+    bool m_active = false;
+};
@@ -0,0 +1,331 @@
+#include "stdafx.h"
+#include "World/NavGraph.h"
+#include "World/Map.h"
+#include "StlBuffer.h"
+
+#include <cfloat>
+
+namespace
+{
+    constexpr uint32_t NAV_MAGIC = 0x56414E44;  // "DNAV"
+    constexpr uint32_t NAV_VERSION = 1;
+
+    // Openings at least this wide get a node pair at each end, narrower
+    // ones a single pair in the middle
+    constexpr int WIDE_ENTRANCE = 6;
+
+    constexpr float SQRT2 = 1.41421356f;
+
+    struct HeapEntry
+    {
+        float dist;
+        int32_t index;
+        bool operator>(const HeapEntry& other) const { return dist > other.dist; }
+    };
+
+    // Pathfinder calls clusterDistances twice per long query
+    thread_local std::vector<HeapEntry> t_heap;
+}
+
+void NavGraph::clusterDistances(const Map& map, int x, int y, std::vector<float>& dist)
+{
+    const int width = map.getWidth();
+    const int originX = (x / CLUSTER_SIZE) * CLUSTER_SIZE;
+    const int originY = (y / CLUSTER_SIZE) * CLUSTER_SIZE;
+    const int sizeX = std::min(CLUSTER_SIZE, width - originX);
+    const int sizeY = std::min(CLUSTER_SIZE, width - originY);
+
+    dist.assign(CLUSTER_SIZE * CLUSTER_SIZE, FLT_MAX);
+
+    // Local coordinates; the cluster box is convex, so a diagonal between two
+    // cells inside it only needs the two orthogonal cells, also inside
+    auto walkable = [&](int lx, int ly) {
+        return lx >= 0 && ly >= 0 && lx < sizeX && ly < sizeY && map.isWalkable(originX + lx, originY + ly);
+    };
+
+    std::vector<HeapEntry>& heap = t_heap;
+    heap.clear();
+    int startIndex = (y - originY) * CLUSTER_SIZE + (x - originX);
+    dist[startIndex] = 0.0f;
+    heap.push_back({0.0f, startIndex});
+
+    while (!heap.empty())
+    {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+        HeapEntry entry = heap.back();
+        heap.pop_back();
+        if (entry.dist > dist[entry.index])
+            continue;
+
+        int lx = entry.index % CLUSTER_SIZE;
+        int ly = entry.index / CLUSTER_SIZE;
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                if ((dx == 0 && dy == 0) || !walkable(lx + dx, ly + dy))
+                    continue;
+                if (dx != 0 && dy != 0 && (!walkable(lx + dx, ly) || !walkable(lx, ly + dy)))
+                    continue;
+
+                int next = (ly + dy) * CLUSTER_SIZE + (lx + dx);
+                float d = entry.dist + ((dx != 0 && dy != 0) ? SQRT2 : 1.0f);
+                if (d < dist[next])
+                {
+                    dist[next] = d;
+                    heap.push_back({d, next});
+                    std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+                }
+            }
+        }
+    }
+}
+
+void NavGraph::build(const Map& map)
+{
+    m_width = map.getWidth();
+    m_clustersPerRow = (m_width + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+    const int numCells = map.getNumCells();
+
+    // Connected components (4-way flood fill: with no corner cutting, 8-way
+    // movement connects exactly the same cells)
+    m_components.assign(static_cast<size_t>(numCells), 0);
+    m_componentCount = 0;
+    std::vector<int32_t> queue;
+    for (int cell = 0; cell < numCells; ++cell)
+    {
+        if (m_components[cell] != 0 || !map.isWalkable(cell))
+            continue;
+
+        uint32_t label = ++m_componentCount;
+        m_components[cell] = label;
+        queue.assign(1, cell);
+        for (size_t head = 0; head < queue.size(); ++head)
+        {
+            int x = queue[head] % m_width;
+            int y = queue[head] / m_width;
+            const int nx[4] = {x + 1, x - 1, x, x};
+            const int ny[4] = {y, y, y + 1, y - 1};
+            for (int i = 0; i < 4; ++i)
+            {
+                int next = map.cellIdFromCoords(nx[i], ny[i]);
+                if (next >= 0 && m_components[next] == 0 && map.isWalkable(next))
+                {
+                    m_components[next] = label;
+                    queue.push_back(next);
+                }
+            }
+        }
+    }
+
+    // Entrance nodes on both sides of every opening between two clusters
+    m_nodes.clear();
+    std::unordered_map<int32_t, uint32_t> nodeOfCell;
+    std::vector<std::pair<uint32_t, Edge>> edges;
+
+    auto nodeFor = [&](int32_t cell) {
+        auto it = nodeOfCell.find(cell);
+        if (it != nodeOfCell.end())
+            return it->second;
+        uint32_t index = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back({cell, 0, 0});
+        nodeOfCell[cell] = index;
+        return index;
+    };
+
+    auto addTransition = [&](int32_t a, int32_t b) {
+        uint32_t na = nodeFor(a);
+        uint32_t nb = nodeFor(b);
+        edges.push_back({na, {nb, 1.0f}});
+        edges.push_back({nb, {na, 1.0f}});
+    };
+
+    // cellsAt(i, a, b) gives the facing cell pair at step i along a border
+    auto scanBorder = [&](int length, auto cellsAt) {
+        int runStart = -1;
+        for (int i = 0; i <= length; ++i)
+        {
+            int32_t a = 0;
+            int32_t b = 0;
+            bool open = i < length && (cellsAt(i, a, b), map.isWalkable(a) && map.isWalkable(b));
+            if (open && runStart < 0)
+                runStart = i;
+            if (open || runStart < 0)
+                continue;
+
+            int runEnd = i - 1;
+            if (runEnd - runStart + 1 < WIDE_ENTRANCE)
+            {
+                cellsAt((runStart + runEnd) / 2, a, b);
+                addTransition(a, b);
+            }
+            else
+            {
+                cellsAt(runStart, a, b);
+                addTransition(a, b);
+                cellsAt(runEnd, a, b);
+                addTransition(a, b);
+            }
+            runStart = -1;
+        }
+    };
+
+    for (int cy = 0; cy < m_clustersPerRow; ++cy)
+    {
+        for (int cx = 0; cx < m_clustersPerRow; ++cx)
+        {
+            int x0 = cx * CLUSTER_SIZE;
+            int y0 = cy * CLUSTER_SIZE;
+            int x1 = std::min(x0 + CLUSTER_SIZE, m_width);
+            int y1 = std::min(y0 + CLUSTER_SIZE, m_width);
+
+            if (x1 < m_width)
+            {
+                scanBorder(y1 - y0, [&](int i, int32_t& a, int32_t& b) {
+                    a = (y0 + i) * m_width + (x1 - 1);
+                    b = a + 1;
+                });
+            }
+            if (y1 < m_width)
+            {
+                scanBorder(x1 - x0, [&](int i, int32_t& a, int32_t& b) {
+                    a = (y1 - 1) * m_width + (x0 + i);
+                    b = a + m_width;
+                });
+            }
+        }
+    }
+
+    // Edges between the entrances of each cluster, weighted by the walk
+    // that stays inside it
+    indexClusters();
+    std::vector<float> dist;
+    for (const std::vector<uint32_t>& clusterNodes : m_clusterNodes)
+    {
+        if (clusterNodes.size() < 2)
+            continue;
+
+        for (uint32_t from : clusterNodes)
+        {
+            int fx = m_nodes[from].cell % m_width;
+            int fy = m_nodes[from].cell / m_width;
+            clusterDistances(map, fx, fy, dist);
+
+            for (uint32_t to : clusterNodes)
+            {
+                if (to == from)
+                    continue;
+                int tx = m_nodes[to].cell % m_width;
+                int ty = m_nodes[to].cell / m_width;
+                float cost = dist[(ty % CLUSTER_SIZE) * CLUSTER_SIZE + (tx % CLUSTER_SIZE)];
+                if (cost < FLT_MAX)
+                    edges.push_back({from, {to, cost}});
+            }
+        }
+    }
+
+    // Group edges by their source node
+    std::stable_sort(edges.begin(), edges.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    m_edges.clear();
+    m_edges.reserve(edges.size());
+    for (const auto& [from, edge] : edges)
+    {
+        Node& node = m_nodes[from];
+        if (node.edgeCount == 0)
+            node.firstEdge = static_cast<uint32_t>(m_edges.size());
+        ++node.edgeCount;
+        m_edges.push_back(edge);
+    }
+}
+
+void NavGraph::indexClusters()
+{
+    m_clusterNodes.assign(static_cast<size_t>(m_clustersPerRow * m_clustersPerRow), {});
+    for (uint32_t i = 0; i < m_nodes.size(); ++i)
+    {
+        int x = m_nodes[i].cell % m_width;
+        int y = m_nodes[i].cell / m_width;
+        m_clusterNodes[getClusterOf(x, y)].push_back(i);
+    }
+}
+
+void NavGraph::write(StlBuffer& buf) const
+{
+    buf << NAV_MAGIC << NAV_VERSION << static_cast<int32_t>(m_width) << static_cast<int32_t>(CLUSTER_SIZE)
+        << m_componentCount;
+
+    buf << static_cast<uint32_t>(m_components.size());
+    for (uint32_t component : m_components)
+        buf << component;
+
+    buf << static_cast<uint32_t>(m_nodes.size());
+    for (const Node& node : m_nodes)
+        buf << node.cell << node.firstEdge << node.edgeCount;
+
+    buf << static_cast<uint32_t>(m_edges.size());
+    for (const Edge& edge : m_edges)
+        buf << edge.to << edge.cost;
+}
+
+bool NavGraph::read(StlBuffer& buf, int width)
+{
+    uint32_t magic = 0, version = 0, componentCount = 0;
+    int32_t fileWidth = 0, clusterSize = 0;
+    buf >> magic >> version >> fileWidth >> clusterSize >> componentCount;
+    if (buf.hasError() || magic != NAV_MAGIC || version != NAV_VERSION || fileWidth != width ||
+        clusterSize != CLUSTER_SIZE)
+        return false;
+
+    // Counts are checked against what is left so a corrupt file cannot
+    // trigger a huge allocation
+    auto remaining = [&buf]() { return buf.size() - buf.readPos(); };
+
+    uint32_t numCells = 0;
+    buf >> numCells;
+    if (numCells != static_cast<uint32_t>(width) * static_cast<uint32_t>(width) || remaining() < numCells * 4ull)
+        return false;
+    std::vector<uint32_t> components(numCells);
+    for (uint32_t& component : components)
+        buf >> component;
+
+    uint32_t numNodes = 0;
+    buf >> numNodes;
+    if (buf.hasError() || remaining() < numNodes * 12ull)
+        return false;
+    std::vector<Node> nodes(numNodes);
+    for (Node& node : nodes)
+        buf >> node.cell >> node.firstEdge >> node.edgeCount;
+
+    uint32_t numEdges = 0;
+    buf >> numEdges;
+    if (buf.hasError() || remaining() < numEdges * 8ull)
+        return false;
+    std::vector<Edge> edges(numEdges);
+    for (Edge& edge : edges)
+        buf >> edge.to >> edge.cost;
+
+    if (buf.hasError())
+        return false;
+
+    for (const Node& node : nodes)
+    {
+        if (node.cell < 0 || static_cast<uint32_t>(node.cell) >= numCells ||
+            static_cast<uint64_t>(node.firstEdge) + node.edgeCount > numEdges)
+            return false;
+    }
+    for (const Edge& edge : edges)
+    {
+        if (edge.to >= numNodes)
+            return false;
+    }
+
+    m_width = width;
+    m_clustersPerRow = (width + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+    m_componentCount = componentCount;
+    m_components = std::move(components);
+    m_nodes = std::move(nodes);
+    m_edges = std::move(edges);
+    indexClusters();
+    return true;
+}
@@ -0,0 +1,82 @@
+// NavGraph - Precomputed navigation data for one Map
+// Connected-component labels let the pathfinder reject an unreachable goal
+// in O(1) instead of flooding the whole region first. An HPA*-style graph of
+// cluster entrances (CLUSTER_SIZE square clusters, nodes on both sides of
+// every border opening, edges weighted by the walk inside each cluster) lets
+// long paths be planned over a few hundred nodes instead of the whole grid.
+// Built when a map is first loaded and stored in its server cache (.smap).
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Map;
+class StlBuffer;
+
+class NavGraph
+{
+public:
+    static constexpr int CLUSTER_SIZE = 16;
+
+    struct Edge
+    {
+        uint32_t to;
+        float cost;
+    };
+
+    struct Node
+    {
+        int32_t cell;
+        uint32_t firstEdge;     // Edges are stored per node, back to back
+        uint32_t edgeCount;
+    };
+
+    // Build from the map's cells
+    void build(const Map& map);
+
+    // Serialized form, stored after the cell flags in the map cache. read()
+    // fails (leaving the graph untouched) on anything malformed or built for
+    // another width.
+    void write(StlBuffer& buf) const;
+    bool read(StlBuffer& buf, int width);
+
+    // Component of a cell (0 = unwalkable or out of bounds)
+    uint32_t getComponent(int cellId) const
+    {
+        return cellId >= 0 && cellId < static_cast<int>(m_components.size()) ? m_components[cellId] : 0;
+    }
+    uint32_t getComponentCount() const { return m_componentCount; }
+
+    int getClusterOf(int x, int y) const { return (y / CLUSTER_SIZE) * m_clustersPerRow + x / CLUSTER_SIZE; }
+    const std::vector<uint32_t>& getClusterNodes(int cluster) const { return m_clusterNodes[cluster]; }
+
+    size_t getNodeCount() const { return m_nodes.size(); }
+    const Node& getNode(uint32_t index) const { return m_nodes[index]; }
+    const Edge* getEdges(const Node& node) const { return m_edges.data() + node.firstEdge; }
+    size_t getEdgeCount() const { return m_edges.size(); }
+
+    size_t getMemoryUsage() const
+    {
+        return m_components.size() * sizeof(uint32_t) + m_nodes.size() * sizeof(Node) +
+               m_edges.size() * sizeof(Edge) + m_nodes.size() * sizeof(uint32_t);
+    }
+
+    // Walking cost from (x, y) to every cell of its cluster without leaving
+    // it (8-way, no corner cutting). `dist` is indexed by the cell's offset
+    // inside the cluster (ly * CLUSTER_SIZE + lx); unreachable cells are
+    // FLT_MAX.
+    static void clusterDistances(const Map& map, int x, int y, std::vector<float>& dist);
+
+private:
+    void indexClusters();
+
+    int m_width = 0;
+    int m_clustersPerRow = 0;
+    uint32_t m_componentCount = 0;
+    std::vector<uint32_t> m_components;
+    std::vector<Node> m_nodes;
+    std::vector<Edge> m_edges;
+    std::vector<std::vector<uint32_t>> m_clusterNodes;  // Rebuilt from m_nodes, not cached
+};
@@ -184,6 +184,27 @@ void Npc::update(float deltaTime)
     NpcAI::update(this, deltaTime);
 }
 
+void Npc::wake(float elapsed)
+{
+    if (elapsed <= 0.0f)
+        return;
+
+    if (m_aiState == NpcAIState::Dead)
+    {
+        m_deathTimer += elapsed * 1000.0f;
+        return;
+    }
+
+    // Timers run out as if the NPC had been ticking; a wanderer or patroller
+    // resumes from where it stopped rather than replaying its movement
+    m_attackTimer += elapsed;
+    m_spellCooldown = std::max(0.0f, m_spellCooldown - elapsed);
+    m_wanderWaitTimer = std::max(0.0f, m_wanderWaitTimer - elapsed);
+    m_waypointWaitTimer = std::max(0.0f, m_waypointWaitTimer - elapsed);
+
+    getAuras().fastForward(static_cast<int32_t>(elapsed * 1000.0f));
+}
+
 // ============================================================================
 // Faction / Hostility
 // ============================================================================
@@ -276,6 +297,7 @@ void Npc::addThreat(Entity* attacker, int32_t amount)
     if (m_aiState == NpcAIState::Idle)
     {
         m_aiState = NpcAIState::Combat;
+        sWorldManager.wakeNpc(this);
         setTarget(attacker);
         // Mark as already having called for help to prevent cascade
         // (this NPC was already recruited via someone else's call for help)
@@ -285,11 +307,17 @@ void Npc::addThreat(Entity* attacker, int32_t amount)
     }
 }
 
+Entity* Npc::getTarget() const
+{
+    return m_targetGuid != 0 ? sWorldManager.getEntity(m_targetGuid) : nullptr;
+}
+
 void Npc::setTarget(Entity* target)
 {
-    if (m_target != target)
+    uint32_t targetGuid = target ? target->getGuid() : 0;
+    if (m_targetGuid != targetGuid)
     {
-        m_target = target;
+        m_targetGuid = targetGuid;
 
         if (target)
         {
@@ -349,22 +377,36 @@ void Npc::onDeath(Entity* killer)
     m_aiState = NpcAIState::Dead;
     m_deathTimer = 0.0f;
 
+    // Corpses stay where they fell; viewers stop the walk on the death update
+    m_moveSpline.stop();
+
     // Clear target and threat list
-    m_target = nullptr;
+    m_targetGuid = 0;
     m_threatManager.clear();
 
-    // Generate loot (Phase 6.4)
-    sLootManager.generateLoot(this, killer);
-
-    // Quest progress (Phase 7)
-    if (::Player* player = dynamic_cast<::Player*>(killer))
+    // Loot, quest credit, experience and the respawn timer are global
+    // systems: when this NPC died in a map job they run at the tick barrier,
+    // where the NPC and its killer are looked up again by handle and guid
+    sWorldManager.deferToBarrier([handle = m_handle, killerGuid = killer ? killer->getGuid() : 0]
     {
-        sQuestManager.onNpcKilled(player, m_entry);
-        sExperienceSystem.onNpcKilled(player, this);
-    }
+        Npc* npc = sWorldManager.getNpc(handle);
+        if (!npc)
+            return;
+        Entity* killer = killerGuid != 0 ? sWorldManager.getEntity(killerGuid) : nullptr;
+
+        // Generate loot (Phase 6.4)
+        sLootManager.generateLoot(npc, killer);
+
+        // Quest progress (Phase 7)
+        if (::Player* player = dynamic_cast<::Player*>(killer))
+        {
+            sQuestManager.onNpcKilled(player, npc->getEntry());
+            sExperienceSystem.onNpcKilled(player, npc);
+        }
 
-    // Schedule respawn (Phase 7.1)
-    sNpcSpawner.onNpcDeath(this);
+        // Schedule respawn (Phase 7.1)
+        sNpcSpawner.onNpcDeath(npc);
+    });
 
     // TODO: Broadcast death animation/corpse state
 }
@@ -375,6 +417,7 @@ void Npc::respawn()
              m_name.c_str(), m_entry, m_homeX, m_homeY);
 
     // Restore to home position
+    m_moveSpline.stop();
     setPosition(getMapId(), m_homeX, m_homeY);
     setOrientation(m_homeOrientation);
 
@@ -391,7 +434,7 @@ void Npc::respawn()
 
     // Reset AI state
     m_aiState = NpcAIState::Idle;
-    m_target = nullptr;
+    m_targetGuid = 0;
     m_deathTimer = 0.0f;
     m_waypointIndex = 0;
     m_waypointWaitTimer = 0.0f;
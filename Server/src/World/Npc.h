@@ -8,6 +8,7 @@
 #include "../Database/GameData.h"
 #include "../AI/NpcAI.h"
 #include "../AI/ThreatManager.h"
+#include "NpcHandle.h"
 #include <string>
 
 class Player;
@@ -81,10 +82,11 @@ public:
     NpcAIState getAIState() const { return m_aiState; }
     void setAIState(NpcAIState state) { m_aiState = state; }
 
-    // Combat target
-    Entity* getTarget() const { return m_target; }
+    // Combat target, kept by guid: nullptr once it has left the world
+    Entity* getTarget() const;
+    uint32_t getTargetGuid() const { return m_targetGuid; }
     void setTarget(Entity* target);
-    bool hasTarget() const { return m_target != nullptr; }
+    bool hasTarget() const { return m_targetGuid != 0; }
 
     // Home position (where NPC spawned)
     float getHomeX() const { return m_homeX; }
@@ -170,6 +172,19 @@ public:
     bool hasCalledForHelp() const { return m_calledForHelp; }
     void setCalledForHelp(bool called) { m_calledForHelp = called; }
 
+    // Dormancy: with no player nearby an idle (or dead) NPC skips update()
+    // while its map's MapNpcList counts the time; wake() replays the cheap
+    // timers for that time
+    bool canSleep() const { return m_aiState == NpcAIState::Idle || m_aiState == NpcAIState::Dead; }
+    void wake(float elapsed);
+
+    // Slot handle in WorldManager and index in the map's MapNpcList
+    static constexpr size_t NoMapSlot = static_cast<size_t>(-1);
+    NpcHandle getHandle() const { return m_handle; }
+    void setHandle(NpcHandle handle) { m_handle = handle; }
+    size_t getMapSlot() const { return m_mapSlot; }
+    void setMapSlot(size_t slot) { m_mapSlot = slot; }
+
 private:
     // Initialize stats from template
     void initFromTemplate(const NpcTemplate& tmpl);
@@ -204,7 +219,7 @@ private:
 
     // AI state
     NpcAIState m_aiState = NpcAIState::Idle;
-    Entity* m_target = nullptr;
+    uint32_t m_targetGuid = 0;
     ThreatManager m_threatManager;
     float m_attackTimer = 0.0f;  // Time since last melee attack
     float m_spellCooldown = 0.0f;  // Time until spell can be cast again
@@ -236,4 +251,8 @@ private:
 
     // Combat coordination
     bool m_calledForHelp = false;
+
+    // World storage
+    NpcHandle m_handle;
+    size_t m_mapSlot = NoMapSlot;
 };
@@ -0,0 +1,23 @@
+// NpcHandle - Stable reference to an NPC slot in WorldManager
+// The generation changes when the slot is freed, so a handle kept past the
+// NPC's removal resolves to nothing instead of a dangling pointer.
+
+#pragma once
+
+#include <cstdint>
+
+struct NpcHandle
+{
+    static constexpr uint32_t InvalidIndex = 0xFFFFFFFF;
+
+    uint32_t index = InvalidIndex;
+    uint32_t generation = 0;
+
+    bool isValid() const { return index != InvalidIndex; }
+
+    bool operator==(const NpcHandle& other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const NpcHandle& other) const { return !(*this == other); }
+};
@@ -112,15 +112,19 @@ void NpcSpawner::loadSpawnsForMap(int mapId)
     if (m_loadedMaps.count(mapId) > 0)
         return;
 
-    m_loadedMaps.insert(mapId);
-    loadGroups();
+    addSpawnsForMap(mapId, querySpawns(mapId));
+}
+
+std::vector<NpcSpawnInfo> NpcSpawner::querySpawns(int mapId)
+{
+    std::vector<NpcSpawnInfo> spawns;
 
     sqlite3* db = nullptr;
     if (sqlite3_open_v2(sConfig.getGameDbPath().c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
     {
         LOG_ERROR("NpcSpawner: Failed to open game database: %s", sqlite3_errmsg(db));
         sqlite3_close(db);
-        return;
+        return spawns;
     }
 
     const char* sql = "SELECT guid, entry, map, position_x, position_y, orientation, path_id, "
@@ -131,12 +135,11 @@ void NpcSpawner::loadSpawnsForMap(int mapId)
     {
         LOG_ERROR("NpcSpawner: Failed to prepare npc spawn query: %s", sqlite3_errmsg(db));
         sqlite3_close(db);
-        return;
+        return spawns;
     }
 
     sqlite3_bind_int(stmt, 1, mapId);
 
-    int loaded = 0;
     while (sqlite3_step(stmt) == SQLITE_ROW)
     {
         NpcSpawnInfo info;
@@ -155,21 +158,66 @@ void NpcSpawner::loadSpawnsForMap(int mapId)
         if (info.respawnSeconds <= 0)
             info.respawnSeconds = 60;
 
+        spawns.push_back(info);
+    }
+
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+    return spawns;
+}
+
+void NpcSpawner::addSpawnsForMap(int mapId, const std::vector<NpcSpawnInfo>& spawns)
+{
+    if (m_loadedMaps.count(mapId) > 0)
+        return;
+
+    m_loadedMaps.insert(mapId);
+    loadGroups();
+
+    std::vector<int32_t>& mapSpawns = m_spawnsByMap[mapId];
+    for (const NpcSpawnInfo& info : spawns)
+    {
         m_spawns[info.spawnId] = info;
-        m_spawnsByMap[mapId].push_back(info.spawnId);
-        ++loaded;
+        mapSpawns.push_back(info.spawnId);
 
         if (info.pathId > 0)
             loadWaypoints(info.pathId);
     }
 
-    sqlite3_finalize(stmt);
-    sqlite3_close(db);
-
-    LOG_INFO("NpcSpawner: Loaded %d spawns for map %d", loaded, mapId);
+    LOG_INFO("NpcSpawner: Loaded %zu spawns for map %d", spawns.size(), mapId);
     spawnAllForMap(mapId);
 }
 
+size_t NpcSpawner::unloadMap(int mapId)
+{
+    size_t removed = 0;
+
+    auto it = m_spawnsByMap.find(mapId);
+    if (it != m_spawnsByMap.end())
+    {
+        for (int32_t spawnId : it->second)
+        {
+            auto guidIt = m_spawnToNpcGuid.find(spawnId);
+            if (guidIt != m_spawnToNpcGuid.end())
+            {
+                if (Npc* npc = sWorldManager.getNpc(guidIt->second))
+                {
+                    sWorldManager.removeNpc(npc);
+                    ++removed;
+                }
+                m_spawnToNpcGuid.erase(guidIt);
+            }
+            m_respawnTimers.erase(spawnId);
+            m_spawns.erase(spawnId);
+        }
+        m_spawnsByMap.erase(it);
+    }
+
+    m_loadedMaps.erase(mapId);
+    return removed;
+}
+
+
 void NpcSpawner::spawnAllForMap(int mapId)
 {
     auto it = m_spawnsByMap.find(mapId);
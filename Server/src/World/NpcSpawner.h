@@ -33,6 +33,18 @@ public:
     static NpcSpawner& instance();
 
     void loadSpawnsForMap(int mapId);
+
+    // Read a map's spawns from game.db on its own connection, so a
+    // background map load can do it off the tick thread
+    static std::vector<NpcSpawnInfo> querySpawns(int mapId);
+
+    // Register spawns read by querySpawns and spawn their NPCs (no-op if the
+    // map's spawns are already loaded)
+    void addSpawnsForMap(int mapId, const std::vector<NpcSpawnInfo>& spawns);
+
+    // Despawn and forget every spawn of a map being unloaded, so it can be
+    // loaded again later. Returns how many NPCs were removed.
+    size_t unloadMap(int mapId);
     void spawnAllForMap(int mapId);
     void onNpcDeath(Npc* npc);
     void update(float deltaTime);
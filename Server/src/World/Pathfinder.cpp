@@ -0,0 +1,607 @@
+#include "stdafx.h"
+#include "World/Pathfinder.h"
+#include "World/Map.h"
+#include "Core/Logger.h"
+
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+    constexpr float SQRT2 = 1.41421356f;
+
+    // Search state of one cell; only valid when its generation is current
+    struct CellState
+    {
+        uint32_t generation = 0;
+        int32_t parent = -1;
+        float g = FLT_MAX;
+        bool closed = false;
+    };
+
+    struct OpenNode
+    {
+        float f;
+        float g;
+        int32_t cell;
+    };
+
+    // Search state of one cluster-graph node, stamped like CellState
+    struct NodeState
+    {
+        uint32_t generation = 0;
+        int32_t parent = -1;
+        float g = FLT_MAX;
+        bool closed = false;
+    };
+
+    struct OpenNodeGreater
+    {
+        bool operator()(const OpenNode& a, const OpenNode& b) const { return a.f > b.f; }
+    };
+
+    // Per-thread scratch memory, reused by every query on that thread
+    struct Scratch
+    {
+        std::vector<CellState> cells;
+        std::vector<OpenNode> open;
+        std::vector<int32_t> jumpPoints;
+        std::vector<MoveSpline::Point> points;
+        std::vector<NodeState> nodes;
+        std::vector<uint32_t> nodePath;
+        std::vector<float> startDist;
+        std::vector<float> goalDist;
+        uint32_t generation = 0;
+
+        void begin(size_t numCells, size_t numNodes = 0)
+        {
+            if (cells.size() < numCells)
+                cells.resize(numCells);
+            if (nodes.size() < numNodes)
+                nodes.resize(numNodes);
+
+            // New generation invalidates every cell at once; on wrap-around
+            // the stamps have to be reset for real
+            if (++generation == 0)
+            {
+                for (CellState& cell : cells)
+                    cell.generation = 0;
+                for (NodeState& node : nodes)
+                    node.generation = 0;
+                generation = 1;
+            }
+
+            open.clear();
+            jumpPoints.clear();
+            points.clear();
+        }
+
+        CellState& state(int32_t cell)
+        {
+            CellState& s = cells[static_cast<size_t>(cell)];
+            if (s.generation != generation)
+                s = CellState{generation, -1, FLT_MAX, false};
+            return s;
+        }
+
+        NodeState& node(uint32_t index)
+        {
+            NodeState& s = nodes[index];
+            if (s.generation != generation)
+                s = NodeState{generation, -1, FLT_MAX, false};
+            return s;
+        }
+    };
+
+    thread_local Scratch t_scratch;
+    thread_local uint32_t t_budgetLeft = 0;
+    thread_local bool t_budgetLimited = false;
+
+    std::atomic<uint64_t> s_queries{0};
+    std::atomic<uint64_t> s_found{0};
+    std::atomic<uint64_t> s_noPath{0};
+    std::atomic<uint64_t> s_deferred{0};
+    std::atomic<uint64_t> s_rejected{0};
+    std::atomic<uint64_t> s_abstract{0};
+    std::atomic<uint64_t> s_expansions{0};
+    std::atomic<uint64_t> s_micros{0};
+
+    float octile(int dx, int dy)
+    {
+        int ax = std::abs(dx);
+        int ay = std::abs(dy);
+        return static_cast<float>(std::max(ax, ay)) + (SQRT2 - 1.0f) * static_cast<float>(std::min(ax, ay));
+    }
+
+    int sign(int v) { return (v > 0) - (v < 0); }
+
+    // Jump Point Search without corner cutting: a diagonal step needs both
+    // orthogonal neighbours walkable, so forced neighbours only arise on
+    // straight moves. Straight moves scan the walk bitsets 64 cells at a
+    // time (columns through the transposed layer).
+    class JumpSearch
+    {
+    public:
+        JumpSearch(const Map& map, int goalX, int goalY)
+            : m_rows(map.getWalkLayer()), m_columns(map.getWalkLayerTransposed()),
+              m_width(map.getWidth()), m_goalX(goalX), m_goalY(goalY)
+        {
+        }
+
+        bool walkable(int x, int y) const { return !m_rows.isBlocked(x, y); }
+        int32_t cellId(int x, int y) const { return y * m_width + x; }
+
+        // Walk from (x, y) in direction (dx, dy) until a jump point (returned)
+        // or a wall (-1)
+        int32_t jump(int x, int y, int dx, int dy) const
+        {
+            if (dx == 0 || dy == 0)
+                return jumpStraight(x, y, dx, dy);
+
+            for (;;)
+            {
+                if (!walkable(x, y))
+                    return -1;
+                if (x == m_goalX && y == m_goalY)
+                    return cellId(x, y);
+
+                if (jumpStraight(x + dx, y, dx, 0) >= 0 || jumpStraight(x, y + dy, 0, dy) >= 0)
+                    return cellId(x, y);
+
+                if (!walkable(x + dx, y) || !walkable(x, y + dy))
+                    return -1;
+                x += dx;
+                y += dy;
+            }
+        }
+
+        // Directions worth searching from (x, y) when reached from (px, py)
+        // (px < 0 for the start cell). Returns how many were written.
+        int directions(int x, int y, int px, int py, int (&out)[8][2]) const
+        {
+            int count = 0;
+            auto add = [&](int dx, int dy) { out[count][0] = dx; out[count][1] = dy; ++count; };
+
+            if (px < 0)
+            {
+                for (int dy = -1; dy <= 1; ++dy)
+                {
+                    for (int dx = -1; dx <= 1; ++dx)
+                    {
+                        if (dx == 0 && dy == 0)
+                            continue;
+                        if (dx != 0 && dy != 0 && (!walkable(x + dx, y) || !walkable(x, y + dy)))
+                            continue;
+                        if (walkable(x + dx, y + dy))
+                            add(dx, dy);
+                    }
+                }
+                return count;
+            }
+
+            int dx = sign(x - px);
+            int dy = sign(y - py);
+
+            if (dx != 0 && dy != 0)
+            {
+                bool vertical = walkable(x, y + dy);
+                bool horizontal = walkable(x + dx, y);
+                if (vertical)
+                    add(0, dy);
+                if (horizontal)
+                    add(dx, 0);
+                if (vertical && horizontal)
+                    add(dx, dy);
+            }
+            else if (dx != 0)
+            {
+                bool next = walkable(x + dx, y);
+                bool up = walkable(x, y + 1);
+                bool down = walkable(x, y - 1);
+                if (next)
+                {
+                    add(dx, 0);
+                    if (up)
+                        add(dx, 1);
+                    if (down)
+                        add(dx, -1);
+                }
+                if (up)
+                    add(0, 1);
+                if (down)
+                    add(0, -1);
+            }
+            else
+            {
+                bool next = walkable(x, y + dy);
+                bool right = walkable(x + 1, y);
+                bool left = walkable(x - 1, y);
+                if (next)
+                {
+                    add(0, dy);
+                    if (right)
+                        add(1, dy);
+                    if (left)
+                        add(-1, dy);
+                }
+                if (right)
+                    add(1, 0);
+                if (left)
+                    add(-1, 0);
+            }
+            return count;
+        }
+
+    private:
+        // The first stop along the row (or column) is a wall, the goal, or a
+        // cell with a forced neighbour
+        int32_t jumpStraight(int x, int y, int dx, int dy) const
+        {
+            if (!walkable(x, y))
+                return -1;
+
+            if (dy == 0)
+            {
+                int stop = m_rows.findRowStop(x, y, dx);
+                if (y == m_goalY && (m_goalX - x) * dx >= 0 && (stop - m_goalX) * dx >= 0)
+                    return cellId(m_goalX, y);
+                return walkable(stop, y) ? cellId(stop, y) : -1;
+            }
+
+            int stop = m_columns.findRowStop(y, x, dy);
+            if (x == m_goalX && (m_goalY - y) * dy >= 0 && (stop - m_goalY) * dy >= 0)
+                return cellId(x, m_goalY);
+            return walkable(x, stop) ? cellId(x, stop) : -1;
+        }
+
+        const CollisionLayer& m_rows;
+        const CollisionLayer& m_columns;
+        int m_width;
+        int m_goalX;
+        int m_goalY;
+    };
+
+    bool hasLos(const Map& map, const MoveSpline::Point& from, const MoveSpline::Point& to)
+    {
+        return map.getWalkLayer().isSegmentClear(from.x, from.y, to.x, to.y);
+    }
+
+    // JPS over the cells; the start is inside the map and the goal walkable
+    PathResult searchGrid(const Map& map, float fromX, float fromY, float toX, float toY,
+                          std::vector<MoveSpline::Point>& out, uint32_t limit, bool limitIsBudget,
+                          uint32_t& expansions)
+    {
+        int width = map.getWidth();
+        int startX = static_cast<int>(std::floor(fromX));
+        int startY = static_cast<int>(std::floor(fromY));
+        int goalX = static_cast<int>(std::floor(toX));
+        int goalY = static_cast<int>(std::floor(toY));
+
+        Scratch& scratch = t_scratch;
+        scratch.begin(static_cast<size_t>(map.getNumCells()));
+
+        JumpSearch jps(map, goalX, goalY);
+        int32_t startId = jps.cellId(startX, startY);
+        int32_t goalId = jps.cellId(goalX, goalY);
+
+        scratch.state(startId).g = 0.0f;
+        scratch.open.push_back({octile(goalX - startX, goalY - startY), 0.0f, startId});
+
+        bool found = false;
+        while (!scratch.open.empty())
+        {
+            std::pop_heap(scratch.open.begin(), scratch.open.end(), OpenNodeGreater());
+            OpenNode node = scratch.open.back();
+            scratch.open.pop_back();
+
+            CellState& current = scratch.state(node.cell);
+            if (current.closed || node.g > current.g)
+                continue;  // Stale entry; a cheaper one was already expanded
+            current.closed = true;
+
+            if (node.cell == goalId)
+            {
+                found = true;
+                break;
+            }
+
+            if (expansions >= limit)
+                return limitIsBudget ? PathResult::Deferred : PathResult::NoPath;
+            ++expansions;
+
+            int x = node.cell % width;
+            int y = node.cell / width;
+            int px = -1;
+            int py = -1;
+            if (current.parent >= 0)
+            {
+                px = current.parent % width;
+                py = current.parent / width;
+            }
+
+            int dirs[8][2];
+            int count = jps.directions(x, y, px, py, dirs);
+            for (int i = 0; i < count; ++i)
+            {
+                int32_t jumpPoint = jps.jump(x + dirs[i][0], y + dirs[i][1], dirs[i][0], dirs[i][1]);
+                if (jumpPoint < 0)
+                    continue;
+
+                CellState& next = scratch.state(jumpPoint);
+                if (next.closed)
+                    continue;
+
+                int jx = jumpPoint % width;
+                int jy = jumpPoint / width;
+                float g = node.g + octile(jx - x, jy - y);
+                if (g >= next.g)
+                    continue;
+
+                next.g = g;
+                next.parent = node.cell;
+                scratch.open.push_back({g + octile(goalX - jx, goalY - jy), g, jumpPoint});
+                std::push_heap(scratch.open.begin(), scratch.open.end(), OpenNodeGreater());
+            }
+        }
+
+        if (!found)
+            return PathResult::NoPath;
+
+        // Jump points from goal back to start (the start itself is left out)
+        for (int32_t cell = goalId; cell != startId; cell = scratch.state(cell).parent)
+            scratch.jumpPoints.push_back(cell);
+
+        // Cell centres in walking order; the last point is the exact target
+        for (auto it = scratch.jumpPoints.rbegin(); it != scratch.jumpPoints.rend(); ++it)
+        {
+            scratch.points.push_back({static_cast<float>(*it % width) + 0.5f,
+                                      static_cast<float>(*it / width) + 0.5f});
+        }
+        scratch.points.back() = {toX, toY};
+
+        // Drop every point the unit can see past
+        MoveSpline::Point anchor{fromX, fromY};
+        for (size_t i = 0; i < scratch.points.size(); ++i)
+        {
+            bool last = i + 1 == scratch.points.size();
+            if (!last && hasLos(map, anchor, scratch.points[i + 1]))
+                continue;
+
+            out.push_back(scratch.points[i]);
+            anchor = scratch.points[i];
+        }
+
+        return PathResult::Found;
+    }
+
+    // A* over the map's cluster entrances from a walkable start to a walkable
+    // goal in the same region, then JPS for the first leg only: the walk to
+    // the first entrance at least LEG_DISTANCE away. The caller asks again
+    // once it gets there, so only the part being walked is ever refined.
+    constexpr int LEG_DISTANCE = 2 * NavGraph::CLUSTER_SIZE;
+
+    PathResult searchAbstract(const Map& map, float fromX, float fromY, float toX, float toY,
+                              std::vector<MoveSpline::Point>& out, uint32_t limit, bool limitIsBudget,
+                              uint32_t& expansions)
+    {
+        const NavGraph& nav = map.getNav();
+        const uint32_t startNode = static_cast<uint32_t>(nav.getNodeCount());
+        const uint32_t goalNode = startNode + 1;
+        const int CS = NavGraph::CLUSTER_SIZE;
+
+        int width = map.getWidth();
+        int startX = static_cast<int>(std::floor(fromX));
+        int startY = static_cast<int>(std::floor(fromY));
+        int goalX = static_cast<int>(std::floor(toX));
+        int goalY = static_cast<int>(std::floor(toY));
+        int goalCluster = nav.getClusterOf(goalX, goalY);
+
+        Scratch& scratch = t_scratch;
+        scratch.begin(0, nav.getNodeCount() + 2);
+
+        auto nodeX = [&](uint32_t node) { return nav.getNode(node).cell % width; };
+        auto nodeY = [&](uint32_t node) { return nav.getNode(node).cell / width; };
+        auto localIndex = [CS](int x, int y) { return (y % CS) * CS + (x % CS); };
+
+        auto relax = [&](uint32_t node, int32_t parent, float g) {
+            NodeState& next = scratch.node(node);
+            if (next.closed || g >= next.g)
+                return;
+            next.g = g;
+            next.parent = parent;
+            float h = node == goalNode ? 0.0f : octile(goalX - nodeX(node), goalY - nodeY(node));
+            scratch.open.push_back({g + h, g, static_cast<int32_t>(node)});
+            std::push_heap(scratch.open.begin(), scratch.open.end(), OpenNodeGreater());
+        };
+
+        // The start and goal join the graph through the entrances of their
+        // own clusters
+        NavGraph::clusterDistances(map, startX, startY, scratch.startDist);
+        NavGraph::clusterDistances(map, goalX, goalY, scratch.goalDist);
+
+        scratch.node(startNode).g = 0.0f;
+        scratch.node(startNode).closed = true;
+        for (uint32_t node : nav.getClusterNodes(nav.getClusterOf(startX, startY)))
+        {
+            float d = scratch.startDist[localIndex(nodeX(node), nodeY(node))];
+            if (d < FLT_MAX)
+                relax(node, static_cast<int32_t>(startNode), d);
+        }
+
+        bool found = false;
+        while (!scratch.open.empty())
+        {
+            std::pop_heap(scratch.open.begin(), scratch.open.end(), OpenNodeGreater());
+            OpenNode entry = scratch.open.back();
+            scratch.open.pop_back();
+
+            uint32_t index = static_cast<uint32_t>(entry.cell);
+            NodeState& current = scratch.node(index);
+            if (current.closed || entry.g > current.g)
+                continue;
+            current.closed = true;
+
+            if (index == goalNode)
+            {
+                found = true;
+                break;
+            }
+
+            if (expansions >= limit)
+                return limitIsBudget ? PathResult::Deferred : PathResult::NoPath;
+            ++expansions;
+
+            const NavGraph::Node& node = nav.getNode(index);
+            const NavGraph::Edge* edges = nav.getEdges(node);
+            for (uint32_t i = 0; i < node.edgeCount; ++i)
+                relax(edges[i].to, entry.cell, entry.g + edges[i].cost);
+
+            int x = node.cell % width;
+            int y = node.cell / width;
+            if (nav.getClusterOf(x, y) == goalCluster)
+            {
+                float d = scratch.goalDist[localIndex(x, y)];
+                if (d < FLT_MAX)
+                    relax(goalNode, entry.cell, entry.g + d);
+            }
+        }
+
+        if (!found)
+            return PathResult::NoPath;
+
+        // Entrances in walking order (start and goal left out)
+        scratch.nodePath.clear();
+        for (int32_t node = scratch.node(goalNode).parent; node != static_cast<int32_t>(startNode);
+             node = scratch.node(static_cast<uint32_t>(node)).parent)
+            scratch.nodePath.push_back(static_cast<uint32_t>(node));
+
+        for (auto it = scratch.nodePath.rbegin(); it != scratch.nodePath.rend(); ++it)
+        {
+            int x = nodeX(*it);
+            int y = nodeY(*it);
+            if (octile(x - startX, y - startY) >= LEG_DISTANCE)
+            {
+                return searchGrid(map, fromX, fromY, static_cast<float>(x) + 0.5f,
+                                  static_cast<float>(y) + 0.5f, out, limit, limitIsBudget, expansions);
+            }
+        }
+        return searchGrid(map, fromX, fromY, toX, toY, out, limit, limitIsBudget, expansions);
+    }
+
+    PathResult search(const Map& map, float fromX, float fromY, float toX, float toY,
+                      std::vector<MoveSpline::Point>& out, uint32_t limit, bool limitIsBudget,
+                      uint32_t& expansions)
+    {
+        int width = map.getWidth();
+        int startX = static_cast<int>(std::floor(fromX));
+        int startY = static_cast<int>(std::floor(fromY));
+        int goalX = static_cast<int>(std::floor(toX));
+        int goalY = static_cast<int>(std::floor(toY));
+
+        if (startX < 0 || startY < 0 || startX >= width || startY >= width)
+            return PathResult::NoPath;
+        if (!map.isWalkable(goalX, goalY))
+            return PathResult::NoPath;
+
+        if (startX == goalX && startY == goalY)
+        {
+            out.push_back({toX, toY});
+            return PathResult::Found;
+        }
+
+        // Different regions can never connect. A unit standing on a blocked
+        // cell (component 0) still gets a real search to walk out of it.
+        const NavGraph& nav = map.getNav();
+        uint32_t startComponent = nav.getComponent(startY * width + startX);
+        if (startComponent != 0 && startComponent != nav.getComponent(goalY * width + goalX))
+        {
+            ++s_rejected;
+            return PathResult::NoPath;
+        }
+
+        if (startComponent != 0 && nav.getNodeCount() > 0 &&
+            octile(goalX - startX, goalY - startY) > static_cast<float>(LEG_DISTANCE))
+        {
+            ++s_abstract;
+            return searchAbstract(map, fromX, fromY, toX, toY, out, limit, limitIsBudget, expansions);
+        }
+
+        return searchGrid(map, fromX, fromY, toX, toY, out, limit, limitIsBudget, expansions);
+    }
+}
+
+PathResult Pathfinder::findPath(const Map& map, float fromX, float fromY, float toX, float toY,
+                                std::vector<MoveSpline::Point>& out, uint32_t maxExpansions)
+{
+    out.clear();
+    ++s_queries;
+
+    // A query may use what is left of the tick budget; running into that
+    // (rather than its own limit) means "try again next tick"
+    uint32_t limit = maxExpansions;
+    bool limitIsBudget = false;
+    if (t_budgetLimited && t_budgetLeft < limit)
+    {
+        if (t_budgetLeft == 0)
+        {
+            ++s_deferred;
+            return PathResult::Deferred;
+        }
+        limit = t_budgetLeft;
+        limitIsBudget = true;
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    uint32_t expansions = 0;
+    PathResult result = search(map, fromX, fromY, toX, toY, out, limit, limitIsBudget, expansions);
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - started).count();
+
+    if (t_budgetLimited)
+        t_budgetLeft -= std::min(t_budgetLeft, expansions);
+
+    s_expansions += expansions;
+    s_micros += static_cast<uint64_t>(micros);
+    switch (result)
+    {
+        case PathResult::Found:    ++s_found; break;
+        case PathResult::NoPath:   ++s_noPath; break;
+        case PathResult::Deferred: ++s_deferred; break;
+    }
+
+    if (result != PathResult::Found)
+        out.clear();
+    return result;
+}
+
+void Pathfinder::setTickBudget(uint32_t expansions)
+{
+    t_budgetLeft = expansions;
+    t_budgetLimited = expansions > 0;
+}
+
+void Pathfinder::logStats()
+{
+    uint64_t queries = s_queries.exchange(0);
+    uint64_t found = s_found.exchange(0);
+    uint64_t noPath = s_noPath.exchange(0);
+    uint64_t deferred = s_deferred.exchange(0);
+    uint64_t rejected = s_rejected.exchange(0);
+    uint64_t abstract = s_abstract.exchange(0);
+    uint64_t expansions = s_expansions.exchange(0);
+    uint64_t micros = s_micros.exchange(0);
+    if (queries == 0)
+        return;
+
+    LOG_INFO("Pathfinding: %llu queries (%llu found, %llu no path [%llu by region], %llu deferred, "
+             "%llu over the cluster graph), %llu expansions, avg %.1f us",
+             static_cast<unsigned long long>(queries),
+             static_cast<unsigned long long>(found),
+             static_cast<unsigned long long>(noPath),
+             static_cast<unsigned long long>(rejected),
+             static_cast<unsigned long long>(deferred),
+             static_cast<unsigned long long>(abstract),
+             static_cast<unsigned long long>(expansions),
+             static_cast<double>(micros) / static_cast<double>(queries));
+}
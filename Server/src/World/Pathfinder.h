@@ -0,0 +1,45 @@
+// Pathfinder - 8-way A* with Jump Point Search over a Map's walkable cells
+// Positions are in cell units, as in MapLogic and the spawn data (NPCs stand
+// at cell centres, x.5). Diagonal steps never cut a blocked corner. Each
+// thread keeps its own scratch arrays, stamped with a query generation so
+// nothing is cleared between searches. The jump points are then pulled tight
+// with a walkability line test (the cells MapLogic::checkLosToC visits) so
+// NPCs walk straight wherever they can.
+// The map's NavGraph rejects goals in another region without searching, and
+// long queries are planned over its cluster entrances first; only the first
+// leg of those is turned into cells, so the result ends at a waypoint on
+// the way and the caller asks again from there.
+
+#pragma once
+
+#include "World/MoveSpline.h"
+
+#include <cstdint>
+#include <vector>
+
+class Map;
+
+enum class PathResult : uint8_t
+{
+    Found,      // out holds the waypoints (start excluded, destination or next leg's end last)
+    NoPath,     // destination blocked, not connected, or too far to search
+    Deferred    // this thread's tick budget is spent; ask again next tick
+};
+
+namespace Pathfinder
+{
+    // Node expansions a single query may use before giving up (NoPath)
+    constexpr uint32_t MAX_QUERY_EXPANSIONS = 4096;
+
+    // Find a walkable path from (fromX, fromY) to (toX, toY)
+    PathResult findPath(const Map& map, float fromX, float fromY, float toX, float toY,
+                        std::vector<MoveSpline::Point>& out,
+                        uint32_t maxExpansions = MAX_QUERY_EXPANSIONS);
+
+    // Expansions the calling thread may spend until the next call (each map
+    // job sets it before ticking its NPCs; 0 = unlimited)
+    void setTickBudget(uint32_t expansions);
+
+    // Log and reset the query counters (called with the periodic stats)
+    void logStats();
+}
@@ -12,6 +12,7 @@
 #include "StlBuffer.h"
 #include "GamePacketServer.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 
@@ -129,7 +130,67 @@ void Player::update(float deltaTime)
         }
     }
 
-    // Future: update movement interpolation, combat, buffs, etc.
+    updateMovement(deltaTime);
+}
+
+// ============================================================================
+// Movement
+// ============================================================================
+
+float Player::getMoveSpeed() const
+{
+    int32_t pct = getVariable(ObjDefines::Variable::MoveSpeedPct);
+    if (pct <= 0)
+        pct = 100;
+
+    return std::min(Handlers::DEFAULT_MOVE_SPEED * pct / 100.0f, Handlers::MAX_MOVE_SPEED);
+}
+
+void Player::moveTo(float destX, float destY)
+{
+    if (!isMoving())
+    {
+        m_visibilityX = getX();
+        m_visibilityY = getY();
+    }
+
+    m_moveSpline.start(getX(), getY(), {{destX, destY}}, getMoveSpeed());
+}
+
+void Player::stopMoving()
+{
+    if (!isMoving())
+        return;
+
+    m_moveSpline.stop();
+
+    // Settle visibility and the saved position where the player stopped
+    sWorldManager.onPlayerMoved(this);
+    markDirty();
+}
+
+void Player::updateMovement(float deltaTime)
+{
+    if (!isMoving())
+        return;
+
+    float x = getX();
+    float y = getY();
+    bool arrived = m_moveSpline.advance(deltaTime, x, y);
+    setPosition(x, y);
+
+    // Visibility follows the walked position, refreshed every few steps
+    float dx = x - m_visibilityX;
+    float dy = y - m_visibilityY;
+    if (arrived || dx * dx + dy * dy >= VISIBILITY_STEP * VISIBILITY_STEP)
+    {
+        sWorldManager.onPlayerMoved(this);
+        m_visibilityX = x;
+        m_visibilityY = y;
+    }
+
+    if (arrived)
+        markDirty();
 }
 
 void Player::sendPacket(const StlBuffer& packet)
@@ -137,6 +198,11 @@ void Player::sendPacket(const StlBuffer& packet)
     m_session.sendPacket(packet);
 }
 
+void Player::sendPacket(const SharedPacketPtr& packet)
+{
+    m_session.sendPacket(packet);
+}
+
 void Player::addExperience(int32_t amount)
 {
     if (amount <= 0)
@@ -512,21 +578,31 @@ void Player::onDeath(Entity* killer)
     LOG_INFO("Player '%s' died (killer=%lu)", m_characterName.c_str(),
              killer ? killer->getGuid() : 0);
 
-    // Stop movement
-    setMoving(false);
+    // Stopping re-files the player in the grid and refreshes visibility,
+    // which reach past the map: when an NPC killed it in a map job the rest
+    // runs at the tick barrier
+    sWorldManager.deferToBarrier([guid = getGuid()]
+    {
+        Player* player = sWorldManager.getPlayer(guid);
+        if (!player || !player->isDead())
+            return;
 
-    // Clear combat state
-    setVariable(ObjDefines::Variable::InCombat, 0);
+        // Stop movement
+        player->stopMoving();
 
-    // Reduce equipment durability on death
-    if (m_equipment.reduceDurabilityOnDeath())
-    {
-        // Send equipment update to client so they see the durability change
-        sendEquipment();
-    }
+        // Clear combat state
+        player->setVariable(ObjDefines::Variable::InCombat, 0);
 
-    // Mark for save (death state should be saved)
-    markDirty();
+        // Reduce equipment durability on death
+        if (player->m_equipment.reduceDurabilityOnDeath())
+        {
+            // Send equipment update to client so they see the durability change
+            player->sendEquipment();
+        }
+
+        // Mark for save (death state should be saved)
+        player->markDirty();
+    });
 }
 
 // ============================================================================
@@ -602,8 +678,11 @@ void Player::respawn()
 
 void Player::teleportTo(float x, float y)
 {
+    m_moveSpline.stop();
+
     setPosition(x, y);
     broadcastTeleport();
+    sWorldManager.onPlayerMoved(this);
     markDirty();
 
     LOG_DEBUG("Player: '%s' teleported to (%.1f, %.1f)", m_characterName.c_str(), x, y);
@@ -613,8 +692,18 @@ void Player::teleportTo(int mapId, float x, float y)
 {
     if (mapId != getMapId())
     {
-        // Cross-map teleport - use WorldManager
-        sWorldManager.changePlayerMap(this, mapId, x, y, getOrientation());
+        // Cross-map teleport - use WorldManager once the map is in memory. A
+        // map that is not loaded yet loads in the background and the player
+        // moves when it is ready, so the tick never waits on the disk; the
+        // player may have logged out by then, hence the lookup by guid.
+        uint32_t guid = getGuid();
+        sMapManager.whenLoaded(mapId, [guid, mapId, x, y](Map* map)
+        {
+            Player* player = sWorldManager.getPlayer(guid);
+            if (!map || !player)
+                return;
+            sWorldManager.changePlayerMap(player, mapId, x, y, player->getOrientation());
+        });
     }
     else
     {
@@ -755,6 +844,7 @@ void Player::sendInventory()
 
     StlBuffer buf;
     uint16_t opcode = packet.getOpcode();
+    buf.reserve(sizeof(opcode) + packet.sizeHint());
     buf << opcode;
     packet.pack(buf);
 
@@ -7,6 +7,7 @@
 #include "../Systems/Equipment.h"
 #include "../Systems/BankSystem.h"
 #include "../Systems/PlayerQuestLog.h"
+#include "../Network/SharedPacket.h"
 
 #include <string>
 #include <vector>
@@ -70,6 +71,7 @@ public:
 
     // Packet sending helper
     void sendPacket(const StlBuffer& packet);
+    void sendPacket(const SharedPacketPtr& packet);
 
     // Persistence
     void save();
@@ -81,9 +83,11 @@ public:
     // Time tracking
     void updatePlayedTime();
 
-    // Movement
-    bool isMoving() const { return m_isMoving; }
-    void setMoving(bool moving) { m_isMoving = moving; }
+    // Movement: the position advances along the move spline in update()
+    bool isMoving() const { return m_moveSpline.isActive(); }
+    void moveTo(float destX, float destY);
+    void stopMoving();
+    float getMoveSpeed() const;  // Cells per second, MoveSpeedPct applied
 
     // Combat
     bool isInCombat() const;
@@ -189,7 +193,13 @@ public:
     // Save interval constant (seconds)
     static constexpr float SAVE_INTERVAL = 30.0f;
 
+    // Distance (cells) walked between visibility refreshes while moving
+    static constexpr float VISIBILITY_STEP = 0.5f;
+
 private:
+    // Walk the move spline (called from update)
+    void updateMovement(float deltaTime);
+
     void loadStatBonuses();
     void saveStatBonuses();
     // Bound session
@@ -211,7 +221,8 @@ private:
     int32_t m_playedTime = 0;
 
     // State
-    bool m_isMoving = false;
+    float m_visibilityX = 0.0f;  // Position of the last visibility refresh
+    float m_visibilityY = 0.0f;
     bool m_needsSave = false;
     uint32_t m_selectedTarget = 0;  // Currently selected target GUID
     uint32_t m_gossipTargetGuid = 0;  // Last gossip NPC GUID
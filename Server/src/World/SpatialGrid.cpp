@@ -0,0 +1,118 @@
+#include "stdafx.h"
+#include "World/SpatialGrid.h"
+#include "World/Entity.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : m_cellSize(cellSize)
+    , m_invCellSize(cellSize > 0.0f ? 1.0f / cellSize : 0.0f)
+{
+}
+
+int32_t SpatialGrid::cellCoord(float pos) const
+{
+    if (m_cellSize <= 0.0f)
+        return 0;
+
+    return static_cast<int32_t>(std::floor(pos * m_invCellSize));
+}
+
+SpatialGrid::CellKey SpatialGrid::keyFor(const Entity* entity) const
+{
+    return makeKey(cellCoord(entity->getX()), cellCoord(entity->getY()));
+}
+
+void SpatialGrid::insert(Entity* entity)
+{
+    if (!entity || m_cellOf.count(entity))
+        return;
+
+    CellKey key = keyFor(entity);
+    m_cells[key].push_back(entity);
+    m_cellOf[entity] = key;
+}
+
+void SpatialGrid::remove(Entity* entity)
+{
+    auto it = m_cellOf.find(entity);
+    if (it == m_cellOf.end())
+        return;
+
+    unlink(entity, it->second);
+    m_cellOf.erase(it);
+}
+
+bool SpatialGrid::update(Entity* entity)
+{
+    auto it = m_cellOf.find(entity);
+    if (it == m_cellOf.end())
+        return false;
+
+    CellKey key = keyFor(entity);
+    if (key == it->second)
+        return false;
+
+    unlink(entity, it->second);
+    m_cells[key].push_back(entity);
+    it->second = key;
+    return true;
+}
+
+void SpatialGrid::queryRadius(float x, float y, float radius, std::vector<SpatialHit>& out) const
+{
+    float radiusSq = radius * radius;
+    auto visit = [&](const std::vector<Entity*>& cell)
+    {
+        for (Entity* entity : cell)
+        {
+            float dx = entity->getX() - x;
+            float dy = entity->getY() - y;
+            float distSq = dx * dx + dy * dy;
+            if (radius <= 0.0f || distSq <= radiusSq)
+                out.push_back({entity, distSq});
+        }
+    };
+
+    int32_t minX = cellCoord(x - radius), maxX = cellCoord(x + radius);
+    int32_t minY = cellCoord(y - radius), maxY = cellCoord(y + radius);
+    uint64_t span = static_cast<uint64_t>(maxX - minX + 1) * static_cast<uint64_t>(maxY - minY + 1);
+
+    // Huge radius (or a single-cell grid): walking the occupied cells is cheaper
+    if (radius <= 0.0f || span >= m_cells.size())
+    {
+        for (const auto& [key, cell] : m_cells)
+            visit(cell);
+        return;
+    }
+
+    for (int32_t cy = minY; cy <= maxY; ++cy)
+    {
+        for (int32_t cx = minX; cx <= maxX; ++cx)
+        {
+            auto it = m_cells.find(makeKey(cx, cy));
+            if (it != m_cells.end())
+                visit(it->second);
+        }
+    }
+}
+
+void SpatialGrid::unlink(Entity* entity, CellKey key)
+{
+    auto cellIt = m_cells.find(key);
+    if (cellIt == m_cells.end())
+        return;
+
+    // Cells hold a handful of entities; order within a cell does not matter
+    std::vector<Entity*>& cell = cellIt->second;
+    auto pos = std::find(cell.begin(), cell.end(), entity);
+    if (pos != cell.end())
+    {
+        *pos = cell.back();
+        cell.pop_back();
+    }
+
+    if (cell.empty())
+        m_cells.erase(cellIt);
+}
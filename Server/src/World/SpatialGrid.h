@@ -0,0 +1,81 @@
+// SpatialGrid - Uniform cell grid over one map's entities
+// Cells are as wide as the query radius (the map's view distance), so every
+// entity within range of a point is in that point's cell or one of its eight
+// neighbours. Entities are re-filed incrementally as they move.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Entity;
+
+// One query result: the entity and its squared distance from the query point
+struct SpatialHit
+{
+    Entity* entity;
+    float distSq;
+};
+
+class SpatialGrid
+{
+public:
+    // cellSize <= 0 puts everything in one cell (unlimited view distance)
+    explicit SpatialGrid(float cellSize);
+
+    float getCellSize() const { return m_cellSize; }
+    size_t size() const { return m_cellOf.size(); }
+    bool empty() const { return m_cellOf.empty(); }
+
+    // File an entity under its current position (no-op if already present)
+    void insert(Entity* entity);
+    void remove(Entity* entity);
+
+    // Re-file an entity after it moved. Returns true if it changed cell.
+    bool update(Entity* entity);
+
+    // Call fn(Entity*) for every entity in the 3x3 cells around (x, y)
+    template<typename Fn>
+    void forEachNear(float x, float y, Fn&& fn) const
+    {
+        int32_t cx = cellCoord(x);
+        int32_t cy = cellCoord(y);
+        int32_t reach = m_cellSize > 0.0f ? 1 : 0;
+
+        for (int32_t dy = -reach; dy <= reach; ++dy)
+        {
+            for (int32_t dx = -reach; dx <= reach; ++dx)
+            {
+                auto it = m_cells.find(makeKey(cx + dx, cy + dy));
+                if (it == m_cells.end())
+                    continue;
+
+                for (Entity* entity : it->second)
+                    fn(entity);
+            }
+        }
+    }
+
+    // Append every entity within radius of (x, y) to `out` (radius <= 0 =
+    // everything). Only the cells the circle overlaps are visited.
+    void queryRadius(float x, float y, float radius, std::vector<SpatialHit>& out) const;
+
+private:
+    using CellKey = uint64_t;
+
+    int32_t cellCoord(float pos) const;
+    static CellKey makeKey(int32_t cx, int32_t cy)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+    CellKey keyFor(const Entity* entity) const;
+
+    void unlink(Entity* entity, CellKey key);
+
+    float m_cellSize;
+    float m_invCellSize;
+
+    std::unordered_map<CellKey, std::vector<Entity*>> m_cells;
+    std::unordered_map<Entity*, CellKey> m_cellOf;
+};
@@ -7,16 +7,22 @@
 #include "World/WorldManager.h"
 #include "World/Player.h"
 #include "World/Npc.h"
+#include "World/MapManager.h"
 #include "World/NpcSpawner.h"
+#include "World/Pathfinder.h"
 #include "Systems/QuestManager.h"
 #include "Systems/DuelSystem.h"
 #include "Network/Session.h"
+#include "Network/SharedPacket.h"
 #include "Core/Logger.h"
+#include "Core/Config.h"
 #include "GamePacketServer.h"
 #include "StlBuffer.h"
 #include "ObjDefines.h"
 
 #include <cmath>
+#include <algorithm>
+#include <chrono>
 
 WorldManager& WorldManager::instance()
 {
@@ -26,16 +32,21 @@ WorldManager& WorldManager::instance()
 
 void WorldManager::initialize()
 {
+    m_mapUpdater.activate(sConfig.getMapThreads());
     LOG_INFO("WorldManager initialized");
 }
 
 void WorldManager::shutdown()
 {
+    m_mapUpdater.deactivate();
+
     std::lock_guard<std::mutex> lock(m_mutex);
 
     // Note: We don't delete players here - Session owns them
     m_players.clear();
     m_playersByMap.clear();
+    m_playerGrids.clear();
+    m_npcGrids.clear();
 
     LOG_INFO("WorldManager shutdown");
 }
@@ -59,6 +70,7 @@ void WorldManager::addPlayer(Player* player)
 
     // Add to per-map set
     m_playersByMap[mapId].insert(player);
+    playerGrid(mapId).insert(player);
 
     LOG_DEBUG("WorldManager: Added player '%s' (guid=%u) to map %d. Total players: %zu",
               player->getName().c_str(), guid, mapId, m_players.size());
@@ -76,6 +88,7 @@ void WorldManager::removePlayer(Player* player)
 
     // Remove from global map
     m_players.erase(guid);
+    player->clearDirtyVariables();
 
     // Remove from per-map set
     auto mapIt = m_playersByMap.find(mapId);
@@ -90,6 +103,8 @@ void WorldManager::removePlayer(Player* player)
         }
     }
 
+    removeFromGrid(m_playerGrids, mapId, player);
+
     LOG_DEBUG("WorldManager: Removed player '%s' (guid=%u) from map %d. Total players: %zu",
               player->getName().c_str(), guid, mapId, m_players.size());
 }
@@ -102,6 +117,49 @@ Player* WorldManager::getPlayer(uint32_t guid) const
     return it != m_players.end() ? it->second : nullptr;
 }
 
+Entity* WorldManager::getEntity(uint32_t guid) const
+{
+    if (isNpcGuid(guid))
+        return getNpc(guid);
+    return getPlayer(guid);
+}
+
+std::vector<Player*> WorldManager::resolvePlayers(const std::set<uint32_t>& guids) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return resolvePlayersLocked(guids);
+}
+
+std::vector<Player*> WorldManager::resolvePlayersLocked(const std::set<uint32_t>& guids) const
+{
+    std::vector<Player*> players;
+    players.reserve(guids.size());
+    for (uint32_t guid : guids)
+    {
+        if (isNpcGuid(guid))
+            break;  // Sorted: the rest are NPCs
+
+        auto it = m_players.find(guid);
+        if (it != m_players.end())
+            players.push_back(it->second);
+    }
+    return players;
+}
+
+std::vector<Npc*> WorldManager::resolveNpcs(const std::set<uint32_t>& guids) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<Npc*> npcs;
+    for (auto it = guids.lower_bound(NPC_GUID_BASE); it != guids.end(); ++it)
+    {
+        auto slotIt = m_npcSlotByGuid.find(*it);
+        if (slotIt != m_npcSlotByGuid.end() && m_npcSlots[slotIt->second].npc)
+            npcs.push_back(m_npcSlots[slotIt->second].npc.get());
+    }
+    return npcs;
+}
+
 Player* WorldManager::getPlayerByName(const std::string& name) const
 {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -158,6 +216,130 @@ size_t WorldManager::getPlayerCountOnMap(int mapId) const
     return it != m_playersByMap.end() ? it->second.size() : 0;
 }
 
+SpatialGrid& WorldManager::playerGrid(int mapId)
+{
+    auto it = m_playerGrids.find(mapId);
+    if (it == m_playerGrids.end())
+        it = m_playerGrids.emplace(mapId, SpatialGrid(sConfig.getViewDistance(mapId))).first;
+    return it->second;
+}
+
+SpatialGrid& WorldManager::npcGrid(int mapId)
+{
+    auto it = m_npcGrids.find(mapId);
+    if (it == m_npcGrids.end())
+        it = m_npcGrids.emplace(mapId, SpatialGrid(sConfig.getViewDistance(mapId))).first;
+    return it->second;
+}
+
+void WorldManager::removeFromGrid(std::unordered_map<int, SpatialGrid>& grids, int mapId, Entity* entity)
+{
+    auto it = grids.find(mapId);
+    if (it == grids.end())
+        return;
+
+    it->second.remove(entity);
+    if (it->second.empty())
+        grids.erase(it);
+}
+
+std::vector<Player*> WorldManager::getPlayersNear(Player* player, size_t* mapPlayerCount) const
+{
+    if (mapPlayerCount)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto mapIt = m_playersByMap.find(player->getMapId());
+        *mapPlayerCount = mapIt != m_playersByMap.end() ? mapIt->second.size() - 1 : 0;
+    }
+
+    std::vector<Player*> result = getPlayersAround(player->getMapId(), player->getX(), player->getY());
+    result.erase(std::remove(result.begin(), result.end(), player), result.end());
+    return result;
+}
+
+std::vector<Player*> WorldManager::getPlayersAround(int mapId, float x, float y) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<Player*> result;
+    auto it = m_playerGrids.find(mapId);
+    if (it != m_playerGrids.end())
+    {
+        it->second.forEachNear(x, y, [&](Entity* entity)
+        {
+            result.push_back(static_cast<Player*>(entity));
+        });
+    }
+    return result;
+}
+
+size_t WorldManager::queryRadius(int mapId, float x, float y, float radius,
+                                 const SpatialFilter& filter, std::vector<SpatialHit>& out) const
+{
+    out.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (filter.types & SpatialFilter::Players)
+        {
+            auto it = m_playerGrids.find(mapId);
+            if (it != m_playerGrids.end())
+                it->second.queryRadius(x, y, radius, out);
+        }
+        if (filter.types & SpatialFilter::Npcs)
+        {
+            auto it = m_npcGrids.find(mapId);
+            if (it != m_npcGrids.end())
+                it->second.queryRadius(x, y, radius, out);
+        }
+    }
+
+    out.erase(std::remove_if(out.begin(), out.end(), [&filter](const SpatialHit& hit)
+    {
+        Entity* entity = hit.entity;
+        if (entity == filter.exclude)
+            return true;
+        if (filter.aliveOnly && entity->isDead())
+            return true;
+        if (filter.npcFaction >= 0 && entity->getType() == MutualObject::Type::Npc &&
+            static_cast<Npc*>(entity)->getFaction() != filter.npcFaction)
+            return true;
+        return filter.predicate && !filter.predicate(entity);
+    }), out.end());
+
+    return out.size();
+}
+
+size_t WorldManager::queryNearestN(int mapId, float x, float y, float radius, size_t n,
+                                   const SpatialFilter& filter, std::vector<SpatialHit>& out) const
+{
+    queryRadius(mapId, x, y, radius, filter, out);
+
+    auto byDistance = [](const SpatialHit& a, const SpatialHit& b) { return a.distSq < b.distSq; };
+    if (out.size() > n)
+    {
+        std::nth_element(out.begin(), out.begin() + n, out.end(), byDistance);
+        out.resize(n);
+    }
+    std::sort(out.begin(), out.end(), byDistance);
+    return out.size();
+}
+
+std::vector<Npc*> WorldManager::getNpcsAround(int mapId, float x, float y) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<Npc*> result;
+    auto it = m_npcGrids.find(mapId);
+    if (it != m_npcGrids.end())
+    {
+        it->second.forEachNear(x, y, [&](Entity* entity)
+        {
+            result.push_back(static_cast<Npc*>(entity));
+        });
+    }
+    return result;
+}
+
 // ============================================================================
 // Spawn/Despawn with Broadcasts
 // ============================================================================
@@ -172,26 +354,15 @@ void WorldManager::spawnPlayer(Player* player)
     // First, add to tracking (must be done before getting other players)
     addPlayer(player);
 
-    // Get all other players on the same map
-    std::vector<Player*> playersOnMap;
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        auto it = m_playersByMap.find(mapId);
-        if (it != m_playersByMap.end())
-        {
-            for (Player* p : it->second)
-            {
-                if (p != player)
-                    playersOnMap.push_back(p);
-            }
-        }
-    }
+    // Only players in the surrounding grid cells can be in view range
+    size_t mapPlayerCount = 0;
+    std::vector<Player*> nearbyPlayers = getPlayersNear(player, &mapPlayerCount);
 
     // Count how many players we actually notify (for logging)
     size_t visibleCount = 0;
 
-    // For each player on the map, check visibility and exchange spawn packets
-    for (Player* other : playersOnMap)
+    // For each nearby player, check visibility and exchange spawn packets
+    for (Player* other : nearbyPlayers)
     {
         if (canPlayersSeeEachOther(player, other))
         {
@@ -211,18 +382,12 @@ void WorldManager::spawnPlayer(Player* player)
         }
     }
 
-    // Send all NPCs on this map to the new player (Task 5.14)
-    std::vector<Npc*> npcsOnMap = getNpcsOnMap(mapId);
-    for (Npc* npc : npcsOnMap)
-    {
-        if (npc->isSpawned())
-        {
-            sendNpcTo(player, npc);
-        }
-    }
+    // Send the NPCs in range to the new player (Task 5.14)
+    updateNpcVisibility(player);
 
-    LOG_INFO("WorldManager: Player '%s' spawned on map %d. Visible to %zu of %zu players, %zu NPCs.",
-             player->getName().c_str(), mapId, visibleCount, playersOnMap.size(), npcsOnMap.size());
+    LOG_INFO("WorldManager: Player '%s' spawned on map %d. Visible to %zu of %zu players, sees %zu NPCs.",
+             player->getName().c_str(), mapId, visibleCount, mapPlayerCount,
+             player->getCanSee().size() - visibleCount);
 }
 
 void WorldManager::despawnPlayer(Player* player)
@@ -235,19 +400,7 @@ void WorldManager::despawnPlayer(Player* player)
 
     // Get all players who can see this player (from visibility sets)
     // We use visibleTo because those are the players who need to be notified
-    std::vector<Player*> viewers;
-    {
-        const auto& visibleTo = player->getVisibleTo();
-        viewers.reserve(visibleTo.size());
-
-        for (Entity* entity : visibleTo)
-        {
-            if (Player* viewer = dynamic_cast<Player*>(entity))
-            {
-                viewers.push_back(viewer);
-            }
-        }
-    }
+    std::vector<Player*> viewers = resolvePlayers(player->getVisibleTo());
 
     // Clean up visibility tracking from both sides
     for (Player* viewer : viewers)
@@ -259,10 +412,14 @@ void WorldManager::despawnPlayer(Player* player)
         sendDestroyTo(viewer, guid);
     }
 
-    // Also clean up the canSee set (players this player was watching)
-    for (Entity* entity : player->getCanSee())
+    // Also clean up the canSee set (players and NPCs this player was watching)
+    for (Player* other : resolvePlayers(player->getCanSee()))
+    {
+        other->removeVisibleTo(player);
+    }
+    for (Npc* npc : resolveNpcs(player->getCanSee()))
     {
-        entity->removeVisibleTo(player);
+        npc->removeVisibleTo(player);
     }
 
     // Clear this player's visibility sets
@@ -281,29 +438,34 @@ void WorldManager::changePlayerMap(Player* player, int newMapId, float x, float
     if (!player)
         return;
 
+    // Leaving a map touches two maps' state: do it at the barrier
+    if (inMapUpdate())
+    {
+        deferToBarrier([this, guid = player->getGuid(), newMapId, x, y, orientation]
+        {
+            if (Player* player = getPlayer(guid))
+                changePlayerMap(player, newMapId, x, y, orientation);
+        });
+        return;
+    }
+
+    // A map change or teleport ends any walk in progress
+    player->getMoveSpline().stop();
+
     int oldMapId = player->getMapId();
     uint32_t guid = player->getGuid();
 
-    // Skip if same map
+    // Same map: just a move
     if (oldMapId == newMapId)
     {
         player->setPosition(x, y);
         player->setOrientation(orientation);
+        onPlayerMoved(player);
         return;
     }
 
     // Clean up visibility on old map - notify all viewers and clean up tracking
-    std::vector<Player*> oldViewers;
-    {
-        const auto& visibleTo = player->getVisibleTo();
-        for (Entity* entity : visibleTo)
-        {
-            if (Player* viewer = dynamic_cast<Player*>(entity))
-            {
-                oldViewers.push_back(viewer);
-            }
-        }
-    }
+    std::vector<Player*> oldViewers = resolvePlayers(player->getVisibleTo());
 
     // Notify viewers on old map and clean up their tracking
     for (Player* viewer : oldViewers)
@@ -312,10 +474,14 @@ void WorldManager::changePlayerMap(Player* player, int newMapId, float x, float
         sendDestroyTo(viewer, guid);
     }
 
-    // Clean up players this player was watching
-    for (Entity* entity : player->getCanSee())
+    // Clean up players and NPCs this player was watching
+    for (Player* other : resolvePlayers(player->getCanSee()))
     {
-        entity->removeVisibleTo(player);
+        other->removeVisibleTo(player);
+    }
+    for (Npc* npc : resolveNpcs(player->getCanSee()))
+    {
+        npc->removeVisibleTo(player);
     }
 
     // Clear this player's visibility sets
@@ -328,29 +494,25 @@ void WorldManager::changePlayerMap(Player* player, int newMapId, float x, float
         m_playersByMap[oldMapId].erase(player);
         if (m_playersByMap[oldMapId].empty())
             m_playersByMap.erase(oldMapId);
+
+        removeFromGrid(m_playerGrids, oldMapId, player);
     }
 
     // Update player position
     player->setPosition(newMapId, x, y);
     player->setOrientation(orientation);
+    player->setMap(sMapManager.getMap(newMapId));
 
-    // Add to new map tracking and get players on new map
-    std::vector<Player*> newMapPlayers;
+    // Add to new map tracking
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_playersByMap[newMapId].insert(player);
-
-        auto it = m_playersByMap.find(newMapId);
-        if (it != m_playersByMap.end())
-        {
-            for (Player* p : it->second)
-            {
-                if (p != player)
-                    newMapPlayers.push_back(p);
-            }
-        }
+        playerGrid(newMapId).insert(player);
     }
 
+    size_t mapPlayerCount = 0;
+    std::vector<Player*> nearbyPlayers = getPlayersNear(player, &mapPlayerCount);
+
     // Send NewWorld to the player
     {
         GP_Server_NewWorld packet;
@@ -365,7 +527,7 @@ void WorldManager::changePlayerMap(Player* player, int newMapId, float x, float
 
     // Set up visibility on new map with range checking
     size_t visibleCount = 0;
-    for (Player* other : newMapPlayers)
+    for (Player* other : nearbyPlayers)
     {
         if (canPlayersSeeEachOther(player, other))
         {
@@ -383,8 +545,10 @@ void WorldManager::changePlayerMap(Player* player, int newMapId, float x, float
         }
     }
 
+    updateNpcVisibility(player);
+
     LOG_INFO("WorldManager: Player '%s' changed map %d -> %d at (%.1f, %.1f). Visible to %zu of %zu players.",
-             player->getName().c_str(), oldMapId, newMapId, x, y, visibleCount, newMapPlayers.size());
+             player->getName().c_str(), oldMapId, newMapId, x, y, visibleCount, mapPlayerCount);
 }
 
 // ============================================================================
@@ -407,9 +571,24 @@ void WorldManager::broadcastToMap(int mapId, const StlBuffer& packet, Player* ex
         }
     }
 
+    sendToPlayers(recipients, packet);
+}
+
+void WorldManager::sendToPlayers(const std::vector<Player*>& recipients, const StlBuffer& packet)
+{
+    if (recipients.size() == 1)
+    {
+        recipients[0]->sendPacket(packet);
+        return;
+    }
+    if (recipients.empty())
+        return;
+
+    // Frame once; every recipient queues the same bytes
+    SharedPacketPtr shared = SharedPacket::create(packet);
     for (Player* recipient : recipients)
     {
-        recipient->sendPacket(packet);
+        recipient->sendPacket(shared);
     }
 }
 
@@ -425,10 +604,7 @@ void WorldManager::broadcastGlobal(const StlBuffer& packet, Player* excludePlaye
         }
     }
 
-    for (Player* recipient : recipients)
-    {
-        recipient->sendPacket(packet);
-    }
+    sendToPlayers(recipients, packet);
 }
 
 // ============================================================================
@@ -437,9 +613,9 @@ void WorldManager::broadcastGlobal(const StlBuffer& packet, Player* excludePlaye
 
 void WorldManager::update(float deltaTime)
 {
-    // Get snapshot of players and NPCs to avoid holding lock during update
+    // Snapshot players, and NPCs per map, to avoid holding the lock during update
     std::vector<Player*> players;
-    std::vector<Npc*> npcs;
+    std::vector<MapJob> maps;
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         players.reserve(m_players.size());
@@ -448,33 +624,178 @@ void WorldManager::update(float deltaTime)
             players.push_back(player);
         }
 
-        npcs.reserve(m_npcs.size());
-        for (const auto& [guid, npc] : m_npcs)
+        // Map jobs walk the per-map lists in place: nothing adds or removes
+        // NPCs while they run (spawns and deaths settle at the barrier)
+        maps.reserve(m_npcLists.size());
+        for (auto& [mapId, npcs] : m_npcLists)
         {
-            npcs.push_back(npc.get());
+            if (npcs.empty())
+                continue;
+
+            MapJob& job = maps.emplace_back();
+            job.npcs = &npcs;
+
+            auto playersIt = m_playersByMap.find(mapId);
+            if (playersIt != m_playersByMap.end())
+            {
+                job.players.reserve(playersIt->second.size());
+                for (Player* player : playersIt->second)
+                    job.players.emplace_back(player->getX(), player->getY());
+            }
         }
     }
 
-    // Update all players
+    // Update all players. Player updates reach into global systems (saves,
+    // spell completion, duels, quests), so they stay on the tick thread.
     for (Player* player : players)
     {
         player->update(deltaTime);
     }
 
-    // Update all NPCs (Task 5.14)
-    for (Npc* npc : npcs)
+    // Update each map's NPCs as an independent job. A map job only touches
+    // its own NPCs and the players on that map; anything else it triggers is
+    // deferred to the barrier below.
+    if (!maps.empty())
     {
-        if (!npc->isSpawned())
-            continue;
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point phaseStart = Clock::now();
 
-        npc->update(deltaTime);
+        float activationDistance = sConfig.getActivationDistance();
+        uint32_t pathBudget = sConfig.getPathBudget();
+        m_inMapUpdate.store(true, std::memory_order_release);
+        for (const MapJob& job : maps)
+        {
+            m_mapUpdater.schedule([this, &job, deltaTime, activationDistance, pathBudget]
+            {
+                Clock::time_point start = Clock::now();
+                Pathfinder::setTickBudget(pathBudget);
+                NpcActivity activity;
+                updateMapNpcs(job, deltaTime, activationDistance, activity);
+                uint64_t micros = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+
+                std::lock_guard<std::mutex> lock(m_mapStatsMutex);
+                m_mapStats.npcs.active += activity.active;
+                m_mapStats.npcs.dormant += activity.dormant;
+                m_mapStats.npcs.woken += activity.woken;
+                m_mapStats.jobs += 1;
+                m_mapStats.jobMicros += micros;
+                m_mapStats.maxJobMicros = std::max(m_mapStats.maxJobMicros, micros);
+            });
+        }
+        m_mapUpdater.wait();
+        m_inMapUpdate.store(false, std::memory_order_release);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mapStatsMutex);
+            m_mapStats.ticks += 1;
+            m_mapStats.phaseMicros += static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - phaseStart).count());
+        }
+
+        // Barrier: cross-map and global work queued by the map jobs
+        runDeferred();
     }
 
+    // Install maps loaded in the background, unload idle ones
+    sMapManager.update(deltaTime);
+
     // Update NPC respawn timers (Task 7.1)
     sNpcSpawner.update(deltaTime);
 
     // Update duel system (Task 8.8)
     sDuelManager.update(deltaTime);
+
+    // Everything that changed this tick (handlers ran before us) goes out now
+    flushEntityUpdates();
+}
+
+static uint64_t regionKey(float x, float y, float invRegionSize, int32_t dx = 0, int32_t dy = 0)
+{
+    int32_t rx = static_cast<int32_t>(std::floor(x * invRegionSize)) + dx;
+    int32_t ry = static_cast<int32_t>(std::floor(y * invRegionSize)) + dy;
+    return (static_cast<uint64_t>(static_cast<uint32_t>(rx)) << 32) | static_cast<uint32_t>(ry);
+}
+
+void WorldManager::updateMapNpcs(const MapJob& job, float deltaTime, float activationDistance,
+                                 NpcActivity& activity)
+{
+    // Regions are one activation distance wide. A region is awake when a
+    // player is in it or in one of its eight neighbours, so every NPC within
+    // the distance of a player is awake (and some a little further out).
+    bool alwaysAwake = activationDistance <= 0.0f;
+    float invRegionSize = alwaysAwake ? 0.0f : 1.0f / activationDistance;
+
+    std::unordered_set<uint64_t> awakeRegions;
+    if (!alwaysAwake)
+    {
+        awakeRegions.reserve(job.players.size() * 9);
+        for (const auto& [x, y] : job.players)
+        {
+            for (int32_t dy = -1; dy <= 1; ++dy)
+                for (int32_t dx = -1; dx <= 1; ++dx)
+                    awakeRegions.insert(regionKey(x, y, invRegionSize, dx, dy));
+        }
+    }
+
+    MapNpcList& list = *job.npcs;
+    for (size_t i = 0; i < list.size(); ++i)
+    {
+        bool awake = alwaysAwake ||
+            awakeRegions.count(regionKey(list.x[i], list.y[i], invRegionSize)) != 0;
+
+        // NPCs in combat or walking home finish that even with nobody near
+        if (!awake && list.sleepy[i])
+        {
+            list.dormantTime[i] += deltaTime;
+            ++activity.dormant;
+            continue;
+        }
+
+        Npc* npc = list.npcs[i];
+        if (list.dormantTime[i] > 0.0f)
+        {
+            npc->wake(list.dormantTime[i]);
+            list.dormantTime[i] = 0.0f;
+            ++activity.woken;
+        }
+
+        npc->update(deltaTime);
+        list.sleepy[i] = npc->canSleep() ? 1 : 0;
+        ++activity.active;
+    }
+}
+
+void WorldManager::deferToBarrier(std::function<void()> fn)
+{
+    if (!fn)
+        return;
+
+    if (!inMapUpdate())
+    {
+        fn();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_deferredMutex);
+    m_deferred.push_back(std::move(fn));
+}
+
+void WorldManager::runDeferred()
+{
+    std::vector<std::function<void()>> deferred;
+    {
+        std::lock_guard<std::mutex> lock(m_deferredMutex);
+        deferred.swap(m_deferred);
+    }
+
+    for (std::function<void()>& fn : deferred)
+    {
+        fn();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mapStatsMutex);
+    m_mapStats.deferred += deferred.size();
 }
 
 // ============================================================================
@@ -490,12 +811,13 @@ bool WorldManager::canPlayersSeeEachOther(Player* a, Player* b) const
     if (a->getMapId() != b->getMapId())
         return false;
 
-    // If view distance is 0 or negative, unlimited visibility (whole map)
-    if (WORLD_VIEW_DISTANCE <= 0.0f)
+    // If view distance is 0, unlimited visibility (whole map)
+    float viewDistance = sConfig.getViewDistance(a->getMapId());
+    if (viewDistance <= 0.0f)
         return true;
 
     // Check distance
-    return a->isInRange(b, WORLD_VIEW_DISTANCE);
+    return a->isInRange(b, viewDistance);
 }
 
 void WorldManager::updateVisibility(Player* player)
@@ -503,121 +825,187 @@ void WorldManager::updateVisibility(Player* player)
     if (!player)
         return;
 
-    int mapId = player->getMapId();
+    // Players that may have come into view: only the surrounding grid cells
+    std::vector<Player*> nearbyPlayers = getPlayersNear(player);
 
-    // Get all other players on same map
-    std::vector<Player*> playersOnMap;
+    for (Player* other : nearbyPlayers)
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        auto it = m_playersByMap.find(mapId);
-        if (it != m_playersByMap.end())
-        {
-            for (Player* p : it->second)
-            {
-                if (p != player)
-                    playersOnMap.push_back(p);
-            }
-        }
+        if (player->canSee(other) || !canPlayersSeeEachOther(player, other))
+            continue;
+
+        // Player just came into view - send spawn packets
+        player->addCanSee(other);
+        other->addVisibleTo(player);
+
+        // Send other player to this player
+        sendPlayerTo(player, other);
+
+        // Send this player to other player (mutual visibility)
+        other->addCanSee(player);
+        player->addVisibleTo(other);
+        sendPlayerTo(other, player);
+
+        LOG_DEBUG("Visibility: '%s' and '%s' can now see each other",
+                  player->getName().c_str(), other->getName().c_str());
     }
 
-    // Check each player on the map
-    for (Player* other : playersOnMap)
+    // Players that may have left view: the ones currently visible
+    for (Player* other : resolvePlayers(player->getCanSee()))
     {
-        bool shouldSee = canPlayersSeeEachOther(player, other);
-        bool currentlySees = player->getCanSee().count(other) > 0;
+        if (canPlayersSeeEachOther(player, other))
+            continue;
 
-        if (shouldSee && !currentlySees)
-        {
-            // Player just came into view - send spawn packets
-            player->addCanSee(other);
-            other->addVisibleTo(player);
+        // Player left view range - send despawn packets
+        player->removeCanSee(other);
+        other->removeVisibleTo(player);
 
-            // Send other player to this player
-            sendPlayerTo(player, other);
+        // Despawn other player for this player
+        sendDestroyTo(player, other->getGuid());
 
-            // Send this player to other player (mutual visibility)
-            other->addCanSee(player);
-            player->addVisibleTo(other);
-            sendPlayerTo(other, player);
+        // Despawn this player for other player (mutual)
+        other->removeCanSee(player);
+        player->removeVisibleTo(other);
+        sendDestroyTo(other, player->getGuid());
 
-            LOG_DEBUG("Visibility: '%s' and '%s' can now see each other",
-                      player->getName().c_str(), other->getName().c_str());
-        }
-        else if (!shouldSee && currentlySees)
-        {
-            // Player left view range - send despawn packets
-            player->removeCanSee(other);
-            other->removeVisibleTo(player);
+        LOG_DEBUG("Visibility: '%s' and '%s' can no longer see each other",
+                  player->getName().c_str(), other->getName().c_str());
+    }
+
+    updateNpcVisibility(player);
+}
+
+bool WorldManager::canPlayerSeeNpc(Player* player, Npc* npc) const
+{
+    if (!player || !npc || !npc->isSpawned())
+        return false;
 
-            // Despawn other player for this player
-            sendDestroyTo(player, other->getGuid());
+    if (player->getMapId() != npc->getMapId())
+        return false;
 
-            // Despawn this player for other player (mutual)
-            other->removeCanSee(player);
-            player->removeVisibleTo(other);
-            sendDestroyTo(other, player->getGuid());
+    float viewDistance = sConfig.getViewDistance(player->getMapId());
+    if (viewDistance <= 0.0f)
+        return true;
 
-            LOG_DEBUG("Visibility: '%s' and '%s' can no longer see each other",
-                      player->getName().c_str(), other->getName().c_str());
-        }
-    }
+    return player->isInRange(npc, viewDistance);
 }
 
-void WorldManager::onPlayerMoved(Player* player, float oldX, float oldY)
+void WorldManager::showNpcTo(Player* player, Npc* npc)
 {
-    if (!player)
-        return;
+    // NPCs do not look back: only the player's canSee and the NPC's visibleTo
+    player->addCanSee(npc);
+    npc->addVisibleTo(player);
+    sendNpcTo(player, npc);
+}
 
-    // Calculate how far the player moved
-    float dx = player->getX() - oldX;
-    float dy = player->getY() - oldY;
-    float distMoved = std::sqrt(dx * dx + dy * dy);
+void WorldManager::hideNpcFrom(Player* player, Npc* npc)
+{
+    player->removeCanSee(npc);
+    npc->removeVisibleTo(player);
+    sendDestroyTo(player, npc->getGuid());
+}
 
-    // Only update visibility if player moved a significant distance
-    // This prevents constant visibility recalculation during smooth movement
-    // Use 10% of view distance as threshold, or 50 pixels if unlimited view
-    float threshold = (WORLD_VIEW_DISTANCE > 0.0f) ? WORLD_VIEW_DISTANCE * 0.1f : 50.0f;
+void WorldManager::updateNpcVisibility(Player* player)
+{
+    for (Npc* npc : getNpcsAround(player->getMapId(), player->getX(), player->getY()))
+    {
+        if (!player->canSee(npc) && canPlayerSeeNpc(player, npc))
+            showNpcTo(player, npc);
+    }
 
-    if (distMoved >= threshold)
+    for (Npc* npc : resolveNpcs(player->getCanSee()))
     {
-        updateVisibility(player);
+        if (!canPlayerSeeNpc(player, npc))
+            hideNpcFrom(player, npc);
     }
 }
 
-void WorldManager::broadcastToVisible(Player* player, const StlBuffer& packet, bool includeSelf)
+void WorldManager::onNpcMoved(Npc* npc)
 {
-    if (!player)
+    if (!npc || !npc->isSpawned())
         return;
 
-    // Get list of players who can see this player
-    std::vector<Player*> viewers;
     {
-        // Copy the visibleTo set to avoid issues with concurrent modification
-        const auto& visibleTo = player->getVisibleTo();
-        viewers.reserve(visibleTo.size() + 1);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_npcGrids.find(npc->getMapId());
+        if (it != m_npcGrids.end())
+            it->second.update(npc);
 
-        for (Entity* entity : visibleTo)
-        {
-            if (Player* viewer = dynamic_cast<Player*>(entity))
-            {
-                viewers.push_back(viewer);
-            }
-        }
+        auto listIt = m_npcLists.find(npc->getMapId());
+        if (listIt != m_npcLists.end())
+            listIt->second.syncPosition(npc);
     }
 
-    // Send to all viewers
-    for (Player* viewer : viewers)
+    for (Player* player : getPlayersAround(npc->getMapId(), npc->getX(), npc->getY()))
     {
-        viewer->sendPacket(packet);
+        if (!npc->isVisibleTo(player) && canPlayerSeeNpc(player, npc))
+            showNpcTo(player, npc);
     }
 
-    // Optionally send to self
-    if (includeSelf)
+    for (Player* player : getNpcViewers(npc))
     {
-        player->sendPacket(packet);
+        if (!canPlayerSeeNpc(player, npc))
+            hideNpcFrom(player, npc);
     }
 }
 
+void WorldManager::wakeNpc(Npc* npc)
+{
+    if (!npc)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_npcLists.find(npc->getMapId());
+    if (it != m_npcLists.end())
+        it->second.wake(npc);
+}
+
+void WorldManager::onPlayerMoved(Player* player)
+{
+    if (!player)
+        return;
+
+    // Re-file the player under its new cell
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_playerGrids.find(player->getMapId());
+        if (it != m_playerGrids.end())
+            it->second.update(player);
+    }
+
+    // With the grid a visibility pass only touches the surrounding cells, so
+    // it runs on every move instead of waiting for a distance threshold
+    updateVisibility(player);
+}
+
+std::vector<Player*> WorldManager::getPlayerViewers(Player* player) const
+{
+    // Out-of-range players have not been sent this player; an update would spawn it
+    std::vector<Player*> viewers = resolvePlayers(player->getVisibleTo());
+    viewers.insert(viewers.begin(), player);
+    return viewers;
+}
+
+std::vector<Player*> WorldManager::getNpcViewers(Npc* npc) const
+{
+    return resolvePlayers(npc->getVisibleTo());
+}
+
+size_t WorldManager::broadcastToVisible(Entity* entity, const StlBuffer& packet, bool includeSelf)
+{
+    if (!entity)
+        return 0;
+
+    // Get list of players who can see this entity
+    std::vector<Player*> viewers = resolvePlayers(entity->getVisibleTo());
+
+    // Send to all viewers, and optionally to self
+    if (includeSelf && entity->getType() == MutualObject::Type::Player)
+        viewers.push_back(static_cast<Player*>(entity));
+
+    sendToPlayers(viewers, packet);
+    return viewers.size();
+}
+
 // ============================================================================
 // Internal Helpers
 // ============================================================================
@@ -627,6 +1015,15 @@ void WorldManager::sendPlayerTo(Player* target, Player* playerToSend)
     if (!target || !playerToSend)
         return;
 
+    target->sendPacket(buildPlayerSnapshot(playerToSend));
+
+    // The snapshot is a position; a walk in progress is only sent when it starts
+    if (playerToSend->getMoveSpline().isActive())
+        target->sendPacket(buildMoveSpline(playerToSend));
+}
+
+StlBuffer WorldManager::buildPlayerSnapshot(Player* playerToSend) const
+{
     GP_Server_Player packet;
     packet.m_guid = playerToSend->getGuid();
     packet.m_name = playerToSend->getName();
@@ -639,19 +1036,21 @@ void WorldManager::sendPlayerTo(Player* target, Player* playerToSend)
     packet.m_orientation = playerToSend->getOrientation();
 
     // Variables
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Health)] = playerToSend->getHealth();
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::MaxHealth)] = playerToSend->getMaxHealth();
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Mana)] = playerToSend->getMana();
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::MaxMana)] = playerToSend->getMaxMana();
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Level)] = playerToSend->getLevel();
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::Health), playerToSend->getHealth());
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::MaxHealth), playerToSend->getMaxHealth());
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::Mana), playerToSend->getMana());
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::MaxMana), playerToSend->getMaxMana());
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::Level), playerToSend->getLevel());
+    sortPacketPairs(packet.m_variables);
 
     // TODO: Equipment in Phase 6
 
     StlBuffer buf;
     uint16_t opcode = packet.getOpcode();
+    buf.reserve(sizeof(opcode) + packet.sizeHint());
     buf << opcode;
     packet.pack(buf);
-    target->sendPacket(buf);
+    return buf;
 }
 
 void WorldManager::sendDestroyTo(Player* target, uint32_t guid)
@@ -687,9 +1086,24 @@ Npc* WorldManager::spawnNpc(const NpcTemplate& tmpl, int mapId, float x, float y
 
     Npc* npcPtr = npc.get();
 
-    // Store in maps
-    m_npcs[guid] = std::move(npc);
-    m_npcsByMap[mapId].insert(npcPtr);
+    // Take a free slot (or a new one); the handle carries its generation
+    uint32_t index;
+    if (!m_freeNpcSlots.empty())
+    {
+        index = m_freeNpcSlots.back();
+        m_freeNpcSlots.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_npcSlots.size());
+        m_npcSlots.emplace_back();
+    }
+
+    NpcSlot& slot = m_npcSlots[index];
+    npcPtr->setHandle({index, slot.generation});
+    slot.npc = std::move(npc);
+    m_npcSlotByGuid[guid] = index;
+    m_npcLists[mapId].add(npcPtr);
 
     LOG_DEBUG("WorldManager: Spawned NPC '{}' (entry={}, guid={}) at map {} ({:.1f}, {:.1f})",
               npcPtr->getName(), tmpl.entry, guid, mapId, x, y);
@@ -704,10 +1118,16 @@ void WorldManager::despawnNpc(Npc* npc)
 
     // Note: NPC is kept for respawn, just marked as despawned
     npc->setSpawned(false);
+    npc->clearDirtyVariables();
 
     // Broadcast despawn to all players on the map
     broadcastNpcDespawn(npc);
 
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto listIt = m_npcLists.find(npc->getMapId());
+    if (listIt != m_npcLists.end())
+        listIt->second.remove(npc);
+
     LOG_DEBUG("WorldManager: Despawned NPC '{}' (guid={})",
               npc->getName(), npc->getGuid());
 }
@@ -723,16 +1143,30 @@ void WorldManager::removeNpc(Npc* npc)
     int mapId = npc->getMapId();
 
     // Remove from per-map tracking
-    auto mapIt = m_npcsByMap.find(mapId);
-    if (mapIt != m_npcsByMap.end())
+    auto listIt = m_npcLists.find(mapId);
+    if (listIt != m_npcLists.end())
     {
-        mapIt->second.erase(npc);
-        if (mapIt->second.empty())
-            m_npcsByMap.erase(mapIt);
+        listIt->second.remove(npc);
+        if (listIt->second.empty())
+            m_npcLists.erase(listIt);
     }
 
-    // Remove from main map (this deletes the NPC)
-    m_npcs.erase(guid);
+    removeFromGrid(m_npcGrids, mapId, npc);
+
+    // Viewers stop listing it
+    for (Player* viewer : resolvePlayersLocked(npc->getVisibleTo()))
+        viewer->removeCanSee(npc);
+
+    // Free the slot (this deletes the NPC); handles to it go stale
+    auto slotIt = m_npcSlotByGuid.find(guid);
+    if (slotIt != m_npcSlotByGuid.end())
+    {
+        NpcSlot& slot = m_npcSlots[slotIt->second];
+        slot.npc.reset();
+        ++slot.generation;
+        m_freeNpcSlots.push_back(slotIt->second);
+        m_npcSlotByGuid.erase(slotIt);
+    }
 
     LOG_DEBUG("WorldManager: Removed NPC guid={}", guid);
 }
@@ -741,25 +1175,33 @@ Npc* WorldManager::getNpc(uint32_t guid) const
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    auto it = m_npcs.find(guid);
-    return it != m_npcs.end() ? it->second.get() : nullptr;
+    auto it = m_npcSlotByGuid.find(guid);
+    return it != m_npcSlotByGuid.end() ? m_npcSlots[it->second].npc.get() : nullptr;
+}
+
+Npc* WorldManager::getNpc(NpcHandle handle) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (handle.index >= m_npcSlots.size())
+        return nullptr;
+
+    const NpcSlot& slot = m_npcSlots[handle.index];
+    if (slot.generation != handle.generation || !slot.npc || !slot.npc->isSpawned())
+        return nullptr;
+
+    return slot.npc.get();
 }
 
 std::vector<Npc*> WorldManager::getNpcsOnMap(int mapId) const
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    std::vector<Npc*> result;
-    auto it = m_npcsByMap.find(mapId);
-    if (it != m_npcsByMap.end())
-    {
-        result.reserve(it->second.size());
-        for (Npc* npc : it->second)
-        {
-            result.push_back(npc);
-        }
-    }
-    return result;
+    auto it = m_npcLists.find(mapId);
+    if (it == m_npcLists.end())
+        return {};
+
+    return it->second.npcs;
 }
 
 std::vector<Npc*> WorldManager::getAllNpcs() const
@@ -767,10 +1209,11 @@ std::vector<Npc*> WorldManager::getAllNpcs() const
     std::lock_guard<std::mutex> lock(m_mutex);
 
     std::vector<Npc*> result;
-    result.reserve(m_npcs.size());
-    for (const auto& [guid, npc] : m_npcs)
+    result.reserve(m_npcSlotByGuid.size());
+    for (const NpcSlot& slot : m_npcSlots)
     {
-        result.push_back(npc.get());
+        if (slot.npc)
+            result.push_back(slot.npc.get());
     }
     return result;
 }
@@ -778,7 +1221,7 @@ std::vector<Npc*> WorldManager::getAllNpcs() const
 size_t WorldManager::getNpcCount() const
 {
     std::lock_guard<std::mutex> lock(m_mutex);
-    return m_npcs.size();
+    return m_npcSlotByGuid.size();
 }
 
 void WorldManager::sendNpcTo(Player* target, Npc* npc)
@@ -786,6 +1229,34 @@ void WorldManager::sendNpcTo(Player* target, Npc* npc)
     if (!target || !npc || !npc->isSpawned())
         return;
 
+    target->sendPacket(buildNpcSnapshot(target, npc));
+
+    if (npc->getMoveSpline().isActive())
+        target->sendPacket(buildMoveSpline(npc));
+}
+
+StlBuffer WorldManager::buildMoveSpline(Entity* entity) const
+{
+    const MoveSpline& spline = entity->getMoveSpline();
+
+    GP_Server_UnitSpline packet;
+    packet.m_guid = static_cast<uint32_t>(entity->getGuid());
+    packet.m_startX = entity->getX();
+    packet.m_startY = entity->getY();
+    for (const MoveSpline::Point& point : spline.getRemainingPath())
+        packet.m_spline.push_back({point.x, point.y});
+    packet.m_slide = false;
+    packet.m_silent = packet.m_spline.empty();  // Empty = silent stop
+
+    StlBuffer buf;
+    uint16_t opcode = packet.getOpcode();
+    buf << opcode;
+    packet.pack(buf);
+    return buf;
+}
+
+StlBuffer WorldManager::buildNpcSnapshot(Player* target, Npc* npc) const
+{
     GP_Server_Npc packet;
     packet.m_guid = npc->getGuid();
     packet.m_entry = npc->getEntry();
@@ -794,41 +1265,43 @@ void WorldManager::sendNpcTo(Player* target, Npc* npc)
     packet.m_orientation = npc->getOrientation();
 
     // Send key variables
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Health)] =
-        npc->getVariable(ObjDefines::Variable::Health);
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::MaxHealth)] =
-        npc->getVariable(ObjDefines::Variable::MaxHealth);
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Level)] =
-        npc->getVariable(ObjDefines::Variable::Level);
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Faction)] =
-        npc->getVariable(ObjDefines::Variable::Faction);
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::ModelId)] =
-        npc->getVariable(ObjDefines::Variable::ModelId);
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::ModelScale)] =
-        npc->getVariable(ObjDefines::Variable::ModelScale);
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::MoveSpeedPct)] =
-        npc->getVariable(ObjDefines::Variable::MoveSpeedPct);
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::DynGossipStatus)] =
-        static_cast<int32_t>(sQuestManager.getGossipStatus(target, npc));
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Elite)] =
-        npc->getVariable(ObjDefines::Variable::Elite);
-    packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Boss)] =
-        npc->getVariable(ObjDefines::Variable::Boss);
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::Health),
+                                    npc->getVariable(ObjDefines::Variable::Health));
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::MaxHealth),
+                                    npc->getVariable(ObjDefines::Variable::MaxHealth));
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::Level),
+                                    npc->getVariable(ObjDefines::Variable::Level));
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::Faction),
+                                    npc->getVariable(ObjDefines::Variable::Faction));
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::ModelId),
+                                    npc->getVariable(ObjDefines::Variable::ModelId));
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::ModelScale),
+                                    npc->getVariable(ObjDefines::Variable::ModelScale));
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::MoveSpeedPct),
+                                    npc->getVariable(ObjDefines::Variable::MoveSpeedPct));
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::DynGossipStatus),
+                                    static_cast<int32_t>(sQuestManager.getGossipStatus(target, npc)));
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::Elite),
+                                    npc->getVariable(ObjDefines::Variable::Elite));
+    packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::Boss),
+                                    npc->getVariable(ObjDefines::Variable::Boss));
 
     // Mana if applicable
     int32_t maxMana = npc->getVariable(ObjDefines::Variable::MaxMana);
     if (maxMana > 0)
     {
-        packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::Mana)] =
-            npc->getVariable(ObjDefines::Variable::Mana);
-        packet.m_variables[static_cast<int32_t>(ObjDefines::Variable::MaxMana)] = maxMana;
+        packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::Mana),
+                                        npc->getVariable(ObjDefines::Variable::Mana));
+        packet.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::MaxMana), maxMana);
     }
+    sortPacketPairs(packet.m_variables);
 
     StlBuffer buf;
     uint16_t opcode = packet.getOpcode();
+    buf.reserve(sizeof(opcode) + packet.sizeHint());
     buf << opcode;
     packet.pack(buf);
-    target->sendPacket(buf);
+    return buf;
 }
 
 void WorldManager::broadcastNpcSpawn(Npc* npc)
@@ -836,16 +1309,30 @@ void WorldManager::broadcastNpcSpawn(Npc* npc)
     if (!npc || !npc->isSpawned())
         return;
 
+    // File it under its (possibly reset) position
     int mapId = npc->getMapId();
-    std::vector<Player*> playersOnMap = getPlayersOnMap(mapId);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        SpatialGrid& grid = npcGrid(mapId);
+        grid.insert(npc);
+        grid.update(npc);
 
-    for (Player* player : playersOnMap)
+        // Back in the map's list, awake, at its current position
+        m_npcLists[mapId].add(npc);
+    }
+
+    size_t viewers = 0;
+    for (Player* player : getPlayersAround(mapId, npc->getX(), npc->getY()))
     {
-        sendNpcTo(player, npc);
+        if (canPlayerSeeNpc(player, npc))
+        {
+            showNpcTo(player, npc);
+            viewers++;
+        }
     }
 
     LOG_DEBUG("WorldManager: Broadcast NPC '{}' spawn to {} players",
-              npc->getName(), playersOnMap.size());
+              npc->getName(), viewers);
 }
 
 void WorldManager::broadcastNpcDespawn(Npc* npc)
@@ -853,15 +1340,14 @@ void WorldManager::broadcastNpcDespawn(Npc* npc)
     if (!npc)
         return;
 
-    int mapId = npc->getMapId();
-    uint32_t guid = npc->getGuid();
-
-    std::vector<Player*> playersOnMap = getPlayersOnMap(mapId);
-
-    for (Player* player : playersOnMap)
+    for (Player* player : getNpcViewers(npc))
     {
-        sendDestroyTo(player, guid);
+        hideNpcFrom(player, npc);
     }
+    npc->clearVisibleTo();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    removeFromGrid(m_npcGrids, npc->getMapId(), npc);
 }
 
 // ============================================================================
@@ -875,14 +1361,10 @@ void WorldManager::broadcastPlayerUpdate(Player* player)
     if (!player)
         return;
 
-    // Resend full player packet to all viewers (includes updated variables)
-    std::vector<Player*> playersOnMap = getPlayersOnMap(player->getMapId());
-
-    for (Player* viewer : playersOnMap)
-    {
-        // Send to self and all other players
-        sendPlayerTo(viewer, player);
-    }
+    // Resend full player packet to all viewers (includes updated variables).
+    // It is the same for every viewer, including the player itself.
+    std::vector<Player*> playersOnMap = getPlayerViewers(player);
+    sendToPlayers(playersOnMap, buildPlayerSnapshot(player));
 
     LOG_DEBUG("WorldManager: Broadcast player '{}' update to {} viewers",
               player->getName(), playersOnMap.size());
@@ -893,9 +1375,8 @@ void WorldManager::broadcastNpcUpdate(Npc* npc)
     if (!npc || !npc->isSpawned())
         return;
 
-    // Resend full NPC packet to all players on map (includes updated variables)
-    int mapId = npc->getMapId();
-    std::vector<Player*> playersOnMap = getPlayersOnMap(mapId);
+    // Resend full NPC packet to the players that have it spawned
+    std::vector<Player*> playersOnMap = getNpcViewers(npc);
 
     for (Player* player : playersOnMap)
     {
@@ -905,3 +1386,161 @@ void WorldManager::broadcastNpcUpdate(Npc* npc)
     LOG_DEBUG("WorldManager: Broadcast NPC '{}' update to {} players",
               npc->getName(), playersOnMap.size());
 }
+
+// ============================================================================
+// Batched Entity Updates
+// Variable changes are collected per entity during the tick and sent once at
+// the end of it. With EntityUpdates=immediate every change is sent on the spot
+// like before; with EntityUpdates=delta only the changed variables are sent.
+// ============================================================================
+
+void WorldManager::queueEntityUpdate(Entity* entity)
+{
+    if (!entity)
+        return;
+
+    // Immediate mode still queues during map jobs: the update counters and
+    // the snapshot build are tick-thread only
+    if (sConfig.getEntityUpdates() == "immediate" && !inMapUpdate())
+    {
+        sendEntityUpdate(entity);
+        return;
+    }
+
+    PendingUpdate entry{};
+    entry.isPlayer = entity->getType() == MutualObject::Type::Player;
+    if (entry.isPlayer)
+        entry.guid = static_cast<uint32_t>(entity->getGuid());
+    else
+        entry.npc = static_cast<Npc*>(entity)->getHandle();
+
+    std::lock_guard<std::mutex> lock(m_pendingUpdatesMutex);
+    m_pendingUpdates.push_back(entry);
+}
+
+void WorldManager::flushEntityUpdates()
+{
+    std::vector<PendingUpdate> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingUpdatesMutex);
+        if (m_pendingUpdates.empty())
+            return;
+        pending.swap(m_pendingUpdates);
+    }
+
+    for (const PendingUpdate& entry : pending)
+    {
+        // Resolve again: the entity may have left the world since it was queued
+        Entity* entity = entry.isPlayer ? static_cast<Entity*>(getPlayer(entry.guid))
+                                        : static_cast<Entity*>(getNpc(entry.npc));
+        if (entity)
+            sendEntityUpdate(entity);
+    }
+}
+
+void WorldManager::sendEntityUpdate(Entity* entity)
+{
+    const Entity::VariableMask& dirty = entity->getDirtyVariables();
+    uint32_t changes = entity->getPendingVariableChanges();
+    if (dirty.none())
+        return;
+
+    Npc* npc = entity->getType() == MutualObject::Type::Npc ? static_cast<Npc*>(entity) : nullptr;
+    if (npc && !npc->isSpawned())
+    {
+        entity->clearDirtyVariables();
+        return;
+    }
+
+    std::vector<Player*> viewers = npc ? getNpcViewers(npc)
+                                       : getPlayerViewers(static_cast<Player*>(entity));
+    size_t snapshotBytes = 0;
+    size_t sentBytes = 0;
+
+    if (sConfig.getEntityUpdates() == "delta")
+    {
+        for (size_t var = 0; var < dirty.size(); ++var)
+        {
+            if (!dirty.test(var))
+                continue;
+
+            GP_Server_ObjectVariable packet;
+            packet.m_guid = entity->getGuid();
+            packet.m_variableId = static_cast<int32_t>(var);
+            packet.m_value = entity->getVariable(static_cast<ObjDefines::Variable>(var));
+            StlBuffer buf = packet.build();
+            sentBytes += buf.size() * viewers.size();
+            sendToPlayers(viewers, buf);
+        }
+
+        // Size the snapshot once; only the NPC gossip status differs per viewer
+        if (!viewers.empty())
+        {
+            snapshotBytes = (npc ? buildNpcSnapshot(viewers[0], npc).size()
+                                 : buildPlayerSnapshot(static_cast<Player*>(entity)).size()) * viewers.size();
+        }
+    }
+    else if (npc)
+    {
+        for (Player* viewer : viewers)
+        {
+            StlBuffer buf = buildNpcSnapshot(viewer, npc);
+            sentBytes += buf.size();
+            viewer->sendPacket(buf);
+        }
+        snapshotBytes = sentBytes;
+    }
+    else
+    {
+        StlBuffer buf = buildPlayerSnapshot(static_cast<Player*>(entity));
+        sentBytes = buf.size() * viewers.size();
+        snapshotBytes = sentBytes;
+        sendToPlayers(viewers, buf);
+    }
+
+    m_updateStats.changes += changes;
+    m_updateStats.updates += 1;
+    m_updateStats.bytesSent += sentBytes;
+    m_updateStats.snapshotBytes += snapshotBytes * changes;
+
+    entity->clearDirtyVariables();
+}
+
+void WorldManager::logUpdateStats()
+{
+    MapUpdateStats mapStats;
+    {
+        std::lock_guard<std::mutex> lock(m_mapStatsMutex);
+        mapStats = m_mapStats;
+        m_mapStats = MapUpdateStats();
+    }
+    if (mapStats.ticks > 0)
+    {
+        // Speedup = serial job time over the wall time the phase took
+        double speedup = mapStats.phaseMicros > 0 ?
+            static_cast<double>(mapStats.jobMicros) / mapStats.phaseMicros : 0.0;
+        LOG_INFO("Map updates (%zu threads): %.1f maps/tick, %.2f ms/tick, slowest map %.2f ms, "
+                 "%.2fx parallel, %llu deferred",
+                 m_mapUpdater.getThreadCount(),
+                 static_cast<double>(mapStats.jobs) / mapStats.ticks,
+                 mapStats.phaseMicros / 1000.0 / mapStats.ticks,
+                 mapStats.maxJobMicros / 1000.0, speedup,
+                 static_cast<unsigned long long>(mapStats.deferred));
+        LOG_INFO("NPC activity: %.1f active, %.1f dormant per tick, %llu woken",
+                 static_cast<double>(mapStats.npcs.active) / mapStats.ticks,
+                 static_cast<double>(mapStats.npcs.dormant) / mapStats.ticks,
+                 static_cast<unsigned long long>(mapStats.npcs.woken));
+    }
+
+    UpdateStats stats = m_updateStats;
+    m_updateStats = UpdateStats();
+    if (stats.changes == 0)
+        return;
+
+    uint64_t saved = stats.snapshotBytes > stats.bytesSent ? stats.snapshotBytes - stats.bytesSent : 0;
+    LOG_INFO("Entity updates (%s): %llu variable changes sent as %llu updates, %.1f KB sent, %.1f KB saved",
+             sConfig.getEntityUpdates().c_str(),
+             static_cast<unsigned long long>(stats.changes),
+             static_cast<unsigned long long>(stats.updates),
+             stats.bytesSent / 1024.0, saved / 1024.0);
+}
@@ -6,21 +6,43 @@
 #pragma once
 
 #include <cstdint>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <mutex>
 #include <memory>
+#include <functional>
+#include <atomic>
+
+#include "World/SpatialGrid.h"
+#include "World/MapUpdater.h"
+#include "World/MapNpcList.h"
+#include "World/NpcHandle.h"
 
 class Player;
 class Entity;
+class StlBuffer;
 class Npc;
 struct NpcTemplate;
 
-// View distance for visibility system (in pixels)
-// Set to 0 for unlimited visibility (all players on same map can see each other)
-// Typical values: 800-1200 for limited visibility, 0 for full map visibility
-constexpr float WORLD_VIEW_DISTANCE = 0.0f;
+// What a spatial query keeps. Cheap fields are checked first; the predicate
+// runs last, outside the world lock, so it may call back into WorldManager.
+struct SpatialFilter
+{
+    enum Types : uint8_t
+    {
+        Players = 0x1,
+        Npcs    = 0x2,
+        All     = Players | Npcs
+    };
+
+    uint8_t types = All;
+    const Entity* exclude = nullptr;   // Usually the querying entity
+    bool aliveOnly = false;
+    int32_t npcFaction = -1;           // NPCs of this faction only (-1 = any)
+    std::function<bool(Entity*)> predicate;
+};
 
 // Manages all entities in the world, tracks players per map,
 // handles spawn/despawn broadcasts with visibility filtering
@@ -39,6 +61,18 @@ public:
     Player* getPlayer(uint32_t guid) const;
     Player* getPlayerByName(const std::string& name) const;
 
+    // NPC guids start at NPC_GUID_BASE; everything below is a player
+    static constexpr uint32_t NPC_GUID_BASE = 0x80000000;
+    static bool isNpcGuid(uint32_t guid) { return guid >= NPC_GUID_BASE; }
+
+    // Player or NPC by guid (nullptr once it has left the world)
+    Entity* getEntity(uint32_t guid) const;
+
+    // Resolve visibility sets (Entity::getVisibleTo / getCanSee): the players
+    // / NPCs among the guids that are still in the world
+    std::vector<Player*> resolvePlayers(const std::set<uint32_t>& guids) const;
+    std::vector<Npc*> resolveNpcs(const std::set<uint32_t>& guids) const;
+
     // Get all players on a specific map
     std::vector<Player*> getPlayersOnMap(int mapId) const;
 
@@ -60,28 +94,67 @@ public:
     // Map transitions
     void changePlayerMap(Player* player, int newMapId, float x, float y, float orientation);
 
-    // Update all entities (called each tick)
+    // Update all entities (called each tick). Players update on the tick
+    // thread; each map's NPCs update as one job on the map threads
+    // ([World] MapThreads), then deferred work runs at the barrier.
     void update(float deltaTime);
 
+    // Run fn now, or at the end of the map update phase if called from a map
+    // job. For work that reaches outside the map: global systems (loot,
+    // quests, respawns) and map transfers.
+    void deferToBarrier(std::function<void()> fn);
+
+    // True while map jobs are running
+    bool inMapUpdate() const { return m_inMapUpdate.load(std::memory_order_acquire); }
+
     // Visibility system (Task 4.7)
     // Updates which players can see which - call after significant movement
     void updateVisibility(Player* player);
 
     // Called when a player moves - updates visibility and broadcasts position
-    void onPlayerMoved(Player* player, float oldX, float oldY);
+    void onPlayerMoved(Player* player);
 
-    // Check if two players can see each other (based on view distance)
+    // Check if two players can see each other (based on the map's view distance,
+    // [World] ViewDistance in the config)
     bool canPlayersSeeEachOther(Player* a, Player* b) const;
 
+    // Same range rule for a player looking at an NPC (which must be spawned)
+    bool canPlayerSeeNpc(Player* player, Npc* npc) const;
+
+    // Called after an NPC moved - re-files it and updates which players see it
+    void onNpcMoved(Npc* npc);
+
+    // An NPC was pulled into combat from outside its own update (attacked,
+    // called for help): make sure the next map tick updates it
+    void wakeNpc(Npc* npc);
+
     // Broadcast to all players on a map (except sender)
     void broadcastToMap(int mapId, const class StlBuffer& packet, Player* excludePlayer = nullptr);
 
-    // Broadcast to all players who can see the given player
-    void broadcastToVisible(Player* player, const class StlBuffer& packet, bool includeSelf = false);
+    // Broadcast to all players who can see the given player or NPC
+    // (includeSelf only applies to players). Returns the number of recipients.
+    size_t broadcastToVisible(Entity* entity, const class StlBuffer& packet, bool includeSelf = false);
 
     // Broadcast to all players globally (except sender)
     void broadcastGlobal(const class StlBuffer& packet, Player* excludePlayer = nullptr);
 
+    // Send one packet to a list of players, framing it only once
+    void sendToPlayers(const std::vector<Player*>& recipients, const class StlBuffer& packet);
+
+    // =========================================================================
+    // Spatial Queries (players and spawned NPCs, through the per-map grids)
+    // Results go into caller-owned storage, which is cleared first, so hot
+    // callers can keep one scratch vector. radius <= 0 means the whole map.
+    // =========================================================================
+
+    // Everything within radius, in no particular order. Returns the count.
+    size_t queryRadius(int mapId, float x, float y, float radius,
+                       const SpatialFilter& filter, std::vector<SpatialHit>& out) const;
+
+    // The n nearest within radius, nearest first. Returns the count.
+    size_t queryNearestN(int mapId, float x, float y, float radius, size_t n,
+                         const SpatialFilter& filter, std::vector<SpatialHit>& out) const;
+
     // =========================================================================
     // NPC Management (Task 5.14)
     // =========================================================================
@@ -98,6 +171,9 @@ public:
     // Get NPC by GUID
     Npc* getNpc(uint32_t guid) const;
 
+    // Resolve a handle: nullptr once the NPC was removed or while despawned
+    Npc* getNpc(NpcHandle handle) const;
+
     // Get all NPCs on a specific map
     std::vector<Npc*> getNpcsOnMap(int mapId) const;
 
@@ -107,13 +183,17 @@ public:
     // Get NPC count
     size_t getNpcCount() const;
 
-    // Send NPC spawn packet to a player
+    // Send NPC spawn packet to a player (plus its spline if it is walking)
     void sendNpcTo(Player* target, Npc* npc);
 
-    // Broadcast NPC to all players on map
+    // Framed GP_Server_UnitSpline for the rest of the entity's current walk,
+    // from its current position (empty path = stopped there)
+    StlBuffer buildMoveSpline(Entity* entity) const;
+
+    // NPC entered the world (spawn or respawn): send it to players in range
     void broadcastNpcSpawn(Npc* npc);
 
-    // Broadcast NPC despawn to all players on map
+    // NPC left the world: destroy it for the players that could see it
     void broadcastNpcDespawn(Npc* npc);
 
     // Broadcast entity updates (resend full entity packet for variable changes)
@@ -121,32 +201,154 @@ public:
     void broadcastPlayerUpdate(Player* player);
     void broadcastNpcUpdate(Npc* npc);
 
+    // Batched variable updates: Entity::broadcastVariable queues the entity once,
+    // flushEntityUpdates() (end of update()) sends one update per entity per viewer
+    void queueEntityUpdate(Entity* entity);
+    void flushEntityUpdates();
+
+    // Log and reset the update batching and map job counters (called with the
+    // periodic stats)
+    void logUpdateStats();
+
 private:
     WorldManager() = default;
     ~WorldManager() = default;
     WorldManager(const WorldManager&) = delete;
     WorldManager& operator=(const WorldManager&) = delete;
 
-    // Send player packet to a specific player (for spawn visibility)
+    // Send player packet to a specific player (for spawn visibility), plus
+    // its spline if it is walking
     void sendPlayerTo(Player* target, Player* playerToSend);
 
     // Send destroy packet to a specific player
     void sendDestroyTo(Player* target, uint32_t guid);
 
+    // Framed GP_Server_Player / GP_Server_Npc packets (the NPC one depends on the viewer)
+    StlBuffer buildPlayerSnapshot(Player* player) const;
+    StlBuffer buildNpcSnapshot(Player* viewer, Npc* npc) const;
+
+    // The player itself and everyone it is visible to
+    std::vector<Player*> getPlayerViewers(Player* player) const;
+
+    // Players that have this NPC spawned
+    std::vector<Player*> getNpcViewers(Npc* npc) const;
+
+    // Send one entity's dirty variables to everyone that has it spawned
+    void sendEntityUpdate(Entity* entity);
+
+    // Entities with dirty variables, in the order they first changed this tick
+    struct PendingUpdate
+    {
+        uint32_t guid;     // Players
+        NpcHandle npc;     // NPCs
+        bool isPlayer;
+    };
+    std::vector<PendingUpdate> m_pendingUpdates;
+    std::mutex m_pendingUpdatesMutex;  // Map jobs queue updates concurrently
+
+    // What batching saved, compared to one full snapshot per change
+    struct UpdateStats
+    {
+        uint64_t changes = 0;        // broadcastVariable calls
+        uint64_t updates = 0;        // Entity updates sent (one per entity per tick)
+        uint64_t bytesSent = 0;      // Bytes queued to viewers for those updates
+        uint64_t snapshotBytes = 0;  // Bytes the unbatched path would have queued
+    };
+    UpdateStats m_updateStats;
+
+    // Map update phase: worker pool, barrier queue and timing
+    MapUpdater m_mapUpdater;
+    std::atomic<bool> m_inMapUpdate{false};
+    std::vector<std::function<void()>> m_deferred;
+    std::mutex m_deferredMutex;
+
+    // What one map job works on, snapshotted under m_mutex
+    struct MapJob
+    {
+        MapNpcList* npcs;
+        std::vector<std::pair<float, float>> players;  // Player positions
+    };
+
+    // NPCs updated / left asleep / woken up by map jobs
+    struct NpcActivity
+    {
+        uint64_t active = 0;
+        uint64_t dormant = 0;
+        uint64_t woken = 0;
+    };
+
+    // Update one map's spawned NPCs (one map job). Idle NPCs with no player
+    // within activationDistance sleep instead, without being dereferenced.
+    static void updateMapNpcs(const MapJob& job, float deltaTime, float activationDistance,
+                              NpcActivity& activity);
+
+    // Run what map jobs deferred, in the order it was queued
+    void runDeferred();
+
+    struct MapUpdateStats
+    {
+        uint64_t ticks = 0;          // Ticks with at least one map job
+        uint64_t jobs = 0;           // Map jobs run
+        uint64_t phaseMicros = 0;    // Wall time from first job queued to barrier
+        uint64_t jobMicros = 0;      // Sum of job run times (serial cost)
+        uint64_t maxJobMicros = 0;   // Slowest single map job
+        uint64_t deferred = 0;       // Actions run at the barrier
+        NpcActivity npcs;            // Summed over ticks
+    };
+    MapUpdateStats m_mapStats;
+    std::mutex m_mapStatsMutex;
+
     // All players by GUID
     std::unordered_map<uint32_t, Player*> m_players;
 
     // Players grouped by map ID for efficient map-local operations
     std::unordered_map<int, std::unordered_set<Player*>> m_playersByMap;
 
-    // All NPCs by GUID (owns the Npc objects)
-    std::unordered_map<uint32_t, std::unique_ptr<Npc>> m_npcs;
+    // Players on each map filed by position, cells one view distance wide
+    std::unordered_map<int, SpatialGrid> m_playerGrids;
+
+    // Spawned NPCs filed the same way
+    std::unordered_map<int, SpatialGrid> m_npcGrids;
+
+    // Grid for a map, created on first use (caller holds m_mutex)
+    SpatialGrid& playerGrid(int mapId);
+    SpatialGrid& npcGrid(int mapId);
+    void removeFromGrid(std::unordered_map<int, SpatialGrid>& grids, int mapId, Entity* entity);
+
+    // resolvePlayers() for a caller that holds m_mutex
+    std::vector<Player*> resolvePlayersLocked(const std::set<uint32_t>& guids) const;
+
+    // Other players in the grid cells around a player; only these can be in
+    // view range. Also reports how many players the map holds.
+    std::vector<Player*> getPlayersNear(Player* player, size_t* mapPlayerCount = nullptr) const;
+
+    // Players / spawned NPCs in the grid cells around a point
+    std::vector<Player*> getPlayersAround(int mapId, float x, float y) const;
+    std::vector<Npc*> getNpcsAround(int mapId, float x, float y) const;
+
+    // Start or stop a player seeing an NPC (spawn / destroy packet included)
+    void showNpcTo(Player* player, Npc* npc);
+    void hideNpcFrom(Player* player, Npc* npc);
+
+    // NPC half of updateVisibility: NPCs entering and leaving the player's range
+    void updateNpcVisibility(Player* player);
+
+    // All NPCs (owns the Npc objects). A slot's generation changes when it
+    // is freed so old handles stop resolving; freed slots are reused.
+    struct NpcSlot
+    {
+        std::unique_ptr<Npc> npc;
+        uint32_t generation = 0;
+    };
+    std::vector<NpcSlot> m_npcSlots;
+    std::vector<uint32_t> m_freeNpcSlots;
+    std::unordered_map<uint32_t, uint32_t> m_npcSlotByGuid;
 
-    // NPCs grouped by map ID for efficient map-local operations
-    std::unordered_map<int, std::unordered_set<Npc*>> m_npcsByMap;
+    // Spawned NPCs per map, in the dense arrays the map jobs walk
+    std::unordered_map<int, MapNpcList> m_npcLists;
 
     // GUID counter for NPCs (uses high bits to distinguish from players)
-    uint32_t m_nextNpcGuid = 0x80000000;  // Start NPCs at high GUID range
+    uint32_t m_nextNpcGuid = NPC_GUID_BASE;  // Start NPCs at high GUID range
 
     // Thread safety
     mutable std::mutex m_mutex;
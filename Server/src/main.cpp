@@ -13,16 +13,22 @@
 #include "Network/Session.h"
 #include "Network/SessionManager.h"
 #include "Network/PacketRouter.h"
+#include "Network/NetIoService.h"
+#include "Network/PacketCapture.h"
+#include "Network/PacketReplay.h"
 #include "World/WorldManager.h"
 #include "World/MapManager.h"
+#include "World/Pathfinder.h"
+#include "AI/NpcAI.h"
 #include "Systems/VendorSystem.h"
 #include "Systems/GossipSystem.h"
 #include "Systems/GuildSystem.h"
 #include "SfSocket.h"
-#include <SFML/Network/TcpListener.hpp>
-#include <SFML/Network/SocketSelector.hpp>
 #include <csignal>
 #include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
 
 // Global flag for graceful shutdown
 static std::atomic<bool> g_running{true};
@@ -36,10 +42,44 @@ void signalHandler(int signum)
     }
 }
 
+// Command line: --capture <file> | --replay <file> [--replay-speed recorded|max]
+struct LaunchOptions
+{
+    std::string captureFile;
+    std::string replayFile;
+    PacketReplay::Speed replaySpeed = PacketReplay::Speed::Recorded;
+};
+
+static bool parseArgs(int argc, char* argv[], LaunchOptions& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--capture") == 0 && hasValue) {
+            options.captureFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && hasValue) {
+            options.replayFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay-speed") == 0 && hasValue) {
+            const char* speed = argv[++i];
+            if (std::strcmp(speed, "max") == 0) {
+                options.replaySpeed = PacketReplay::Speed::Max;
+            } else if (std::strcmp(speed, "recorded") != 0) {
+                LOG_ERROR("Unknown replay speed '%s' (expected recorded or max)", speed);
+                return false;
+            }
+        } else {
+            LOG_ERROR("Usage: %s [--capture <file>] [--replay <file> [--replay-speed recorded|max]]", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
 int main(int argc, char* argv[])
 {
-    (void)argc;
-    (void)argv;
+    LaunchOptions options;
+    if (!parseArgs(argc, argv, options)) {
+        return 1;
+    }
 
     // Register signal handlers
     std::signal(SIGINT, signalHandler);
@@ -96,6 +136,11 @@ int main(int argc, char* argv[])
     if (!sMapManager.initialize(mapsDir)) {
         LOG_WARN("MapManager initialization failed (maps may not load)");
     }
+    else if (sConfig.getPreloadMaps())
+    {
+        // Every map up front, so entering one never waits on a load
+        sMapManager.preloadAllMaps(sConfig.getMapLoadThreads());
+    }
     else
     {
         // Preload default start map to seed NPC spawns
@@ -108,23 +153,41 @@ int main(int argc, char* argv[])
     // Start async saver
     sAsyncSaver.start();
 
+    // Replay mode: captured input instead of the network
+    bool replaying = !options.replayFile.empty();
+    if (replaying && !sPacketReplay.open(options.replayFile, options.replaySpeed)) {
+        return 1;
+    }
+
     // Start game clock
-    sGameClock.setTickRate(20); // 20 ticks per second
+    // 20 ticks per second, or whatever rate the replayed capture ran at
+    int tickRate = 20;
+    if (replaying && sPacketReplay.getTickRate() > 0) {
+        tickRate = sPacketReplay.getTickRate();
+    }
+    sGameClock.setTickRate(tickRate);
+    sGameClock.setFixedStep(replaying && options.replaySpeed == PacketReplay::Speed::Max);
     sGameClock.start();
 
-    // Create TCP listener
-    sf::TcpListener listener;
-    listener.setBlocking(false);
+    if (!replaying) {
+        // Start network I/O and listen for connections
+        if (!sNetIo.start(sConfig.getServerPort(), sConfig.getNetworkBackend(), sConfig.getIoThreads())) {
+            LOG_ERROR("Failed to bind to port %d", sConfig.getServerPort());
+            return 1;
+        }
+        LOG_INFO("Listening on port %d (%s backend)", sConfig.getServerPort(), sNetIo.getBackendName());
 
-    if (listener.listen(sConfig.getServerPort()) != sf::Socket::Done) {
-        LOG_ERROR("Failed to bind to port %d", sConfig.getServerPort());
-        return 1;
+        // Record inbound packets for later replay
+        std::string captureFile = !options.captureFile.empty() ? options.captureFile : sConfig.getCaptureFile();
+        if (!captureFile.empty()) {
+            sPacketCapture.open(captureFile, sGameClock.getTickRate(), sGameClock.getTickCount());
+        }
     }
-    LOG_INFO("Listening on port %d", sConfig.getServerPort());
 
-    // Socket selector for efficient polling
-    sf::SocketSelector selector;
-    selector.add(listener);
+    // Hand sockets back to their I/O thread before sessions are destroyed
+    sSessionManager.setRemoveCallback([](Session& session) {
+        sNetIo.releaseSession(session);
+    });
 
     LOG_INFO("Server started. Press Ctrl+C to shutdown.");
 
@@ -134,125 +197,66 @@ int main(int argc, char* argv[])
             // Update game clock
             bool shouldTick = sGameClock.tick();
 
-            // Poll for network activity (short timeout to maintain responsiveness)
-            if (selector.wait(sf::milliseconds(10))) {
-                // Check for new connections
-                if (selector.isReady(listener)) {
-                    Session* session = sSessionManager.createSession();
-                    if (session) {
-                        auto socket = std::make_unique<SfSocket>(SfSocket::Type::ServerSide);
-                        sf::TcpSocket* rawSocket = socket->getSocket();
-
-                        if (listener.accept(*rawSocket) == sf::Socket::Done) {
-                            rawSocket->setBlocking(false);
-                            LOG_INFO("Session %u connected from %s",
-                                     session->getId(),
-                                     rawSocket->getRemoteAddress().toString().c_str());
-
-                            session->setSocket(std::move(socket));
-                            selector.add(*session->getSocket()->getSocket());
-                        } else {
-                            LOG_WARN("Failed to accept connection");
-                            sSessionManager.removeSession(session->getId());
-                        }
-                    } else {
-                        // Accept and immediately close to reject connection
-                        sf::TcpSocket rejector;
-                        listener.accept(rejector);
-                        LOG_WARN("Connection rejected (server full)");
-                    }
-                }
-
-                // Process existing sessions
-                std::vector<uint32_t> sessionsToRemove;
-
-                sSessionManager.forEachSession([&](Session& session) {
-                    try {
-                        SfSocket* socket = session.getSocket();
-                        if (!socket || !socket->isConnected()) {
-                            sessionsToRemove.push_back(session.getId());
-                            return;
-                        }
-
-                        sf::TcpSocket* rawSocket = socket->getSocket();
-                        if (selector.isReady(*rawSocket)) {
-                            // Receive packets
-                            std::vector<std::unique_ptr<StlBuffer>> packets;
-                            socket->receive(packets);
-
-                            // Check for disconnection
-                            if (!socket->isConnected()) {
-                                LOG_INFO("Session %u disconnected", session.getId());
-                                selector.remove(*rawSocket);
-                                sessionsToRemove.push_back(session.getId());
-                                return;
-                            }
-
-                            // Process received packets
-                            for (auto& packet : packets) {
-                                if (packet->size() < 2) {
-                                    LOG_WARN("Session %u: Malformed packet (size=%zu)",
-                                             session.getId(), packet->size());
-                                    continue;
-                                }
-
-                                uint16_t opcode;
-                                *packet >> opcode;
-                                sPacketRouter.dispatch(session, opcode, *packet);
-                            }
-                        }
-                    } catch (const std::exception& e) {
-                        LOG_ERROR("Session %u: Network error: %s", session.getId(), e.what());
-                        sessionsToRemove.push_back(session.getId());
-                    } catch (...) {
-                        LOG_ERROR("Session %u: Unknown network error", session.getId());
-                        sessionsToRemove.push_back(session.getId());
-                    }
-                });
-
-                // Remove disconnected sessions (remove from selector first)
-                for (uint32_t id : sessionsToRemove) {
-                    Session* session = sSessionManager.getSession(id);
-                    if (session && session->getSocket() && session->getSocket()->getSocket()) {
-                        selector.remove(*session->getSocket()->getSocket());
-                    }
-                    sSessionManager.removeSession(id);
+            // Wait for the next tick. Without I/O threads this is where sockets
+            // are read and written; packets are queued here and only dispatched
+            // in the tick's input phase below.
+            if (!shouldTick) {
+                if (replaying) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(sGameClock.getMillisecondsUntilNextTick()));
+                } else {
+                    sNetIo.poll(sGameClock.getMillisecondsUntilNextTick());
                 }
+                continue;
             }
 
             // On each tick, update game systems
-            if (shouldTick) {
-                // Update session manager (timeout checks)
-                sSessionManager.update();
-
-                // Remove timed out sessions from selector
-                sSessionManager.forEachSession([&](Session& session) {
-                    if (session.shouldRemove()) {
-                        if (session.getSocket() && session.getSocket()->getSocket()) {
-                            selector.remove(*session.getSocket()->getSocket());
-                        }
-                    }
-                });
-
-                // Update world manager (updates all players) with error handling
-                try {
-                    sWorldManager.update(sGameClock.getDeltaTime());
-                } catch (const std::exception& e) {
-                    LOG_ERROR("World update error: %s", e.what());
-                } catch (...) {
-                    LOG_ERROR("Unknown world update error");
-                }
+            auto tickStart = std::chrono::steady_clock::now();
+
+            // Dispatch packets received since the last tick
+            if (replaying) {
+                sPacketReplay.processInput(sGameClock.getTickCount());
+            } else {
+                sNetIo.processInput();
+            }
+
+            // Update session manager (timeout checks)
+            sSessionManager.update();
+
+            // Update world manager (updates all players) with error handling
+            try {
+                sWorldManager.update(sGameClock.getDeltaTime());
+            } catch (const std::exception& e) {
+                LOG_ERROR("World update error: %s", e.what());
+            } catch (...) {
+                LOG_ERROR("Unknown world update error");
+            }
 
-                // Periodic status logging (every ~60 seconds)
-                static uint64_t lastStatusTick = 0;
-                if (sGameClock.getTickCount() - lastStatusTick >= 60ULL * sGameClock.getTickRate()) {
-                    lastStatusTick = sGameClock.getTickCount();
-                    LOG_INFO("Uptime: %s | Sessions: %zu | Ticks: %llu",
-                             sGameClock.getUptimeString().c_str(),
-                             sSessionManager.getSessionCount(),
-                             static_cast<unsigned long long>(sGameClock.getTickCount()));
+            // Hand everything queued this tick to the I/O threads
+            sSessionManager.flushOutput();
+
+            if (replaying) {
+                sPacketReplay.recordTickTime(std::chrono::steady_clock::now() - tickStart);
+                if (sPacketReplay.isFinished()) {
+                    g_running = false;
                 }
             }
+
+            // Periodic status logging (every ~60 seconds)
+            static uint64_t lastStatusTick = 0;
+            if (sGameClock.getTickCount() - lastStatusTick >= 60ULL * sGameClock.getTickRate()) {
+                lastStatusTick = sGameClock.getTickCount();
+                LOG_INFO("Uptime: %s | Sessions: %zu | Ticks: %llu",
+                         sGameClock.getUptimeString().c_str(),
+                         sSessionManager.getSessionCount(),
+                         static_cast<unsigned long long>(sGameClock.getTickCount()));
+                sSessionManager.logNetworkStats();
+                sNetIo.logStats();
+                sWorldManager.logUpdateStats();
+                sMapManager.logStats();
+                NpcAI::logMovementStats();
+                Pathfinder::logStats();
+                sPacketCapture.flush();
+            }
         } catch (const std::exception& e) {
             LOG_ERROR("Main loop exception: %s - server continues", e.what());
         } catch (...) {
@@ -265,31 +269,30 @@ int main(int argc, char* argv[])
     // ========================================
     LOG_INFO("Initiating graceful shutdown...");
 
-    // 1. Stop accepting new connections
-    listener.close();
+    if (replaying) {
+        sPacketReplay.logSummary();
+    }
+
+    // 1. Stop accepting new connections and join the I/O threads
+    sNetIo.stop();
     LOG_INFO("Stopped accepting connections");
 
+    sPacketCapture.close();
+
     // 2. Disconnect all sessions with message
     sSessionManager.disconnectAll("Server shutting down");
 
-    // 3. Remove remaining sessions from selector
-    sSessionManager.forEachSession([&](Session& session) {
-        if (session.getSocket() && session.getSocket()->getSocket()) {
-            selector.remove(*session.getSocket()->getSocket());
-        }
-    });
-
-    // 4. Shutdown world manager
+    // 3. Shutdown world manager
     sWorldManager.shutdown();
 
-    // 5. Flush and stop async saver
+    // 4. Flush and stop async saver
     sAsyncSaver.flush();
     sAsyncSaver.stop();
 
-    // 6. Close database
+    // 5. Close database
     sDatabase.close();
 
-    // 7. Final statistics
+    // 6. Final statistics
     LOG_INFO("Final uptime: %s", sGameClock.getUptimeString().c_str());
     LOG_INFO("Total ticks processed: %llu",
              static_cast<unsigned long long>(sGameClock.getTickCount()));
@@ -0,0 +1,443 @@
+// Buffer Bench - StlBuffer packing microbenchmark
+// Usage: DreadmystBufferBench [iterations]
+// Packs and unpacks GP_Server_Player, GP_Server_Npc, GP_Server_InspectReveal
+// and GP_Server_Inventory the way the server does (fresh buffer per send,
+// opcode then pack()) and compares that with the original byte-at-a-time
+// std::map encoder kept below as a reference. Also checks that both produce
+// identical bytes and that sizeHint() is exact.
+
+#include "GamePacketServer.h"
+#include "ObjDefines.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// The encoder StlBuffer used before it switched to memcpy: one push_back per
+// byte on write, one bounds-checked byte per read
+namespace Legacy
+{
+
+struct Buffer
+{
+    std::vector<uint8_t> data;
+    size_t readPos = 0;
+
+    Buffer& operator<<(uint8_t val)
+    {
+        data.push_back(val);
+        return *this;
+    }
+
+    Buffer& operator<<(uint16_t val)
+    {
+        data.push_back(static_cast<uint8_t>(val & 0xFF));
+        data.push_back(static_cast<uint8_t>((val >> 8) & 0xFF));
+        return *this;
+    }
+
+    Buffer& operator<<(uint32_t val)
+    {
+        data.push_back(static_cast<uint8_t>(val & 0xFF));
+        data.push_back(static_cast<uint8_t>((val >> 8) & 0xFF));
+        data.push_back(static_cast<uint8_t>((val >> 16) & 0xFF));
+        data.push_back(static_cast<uint8_t>((val >> 24) & 0xFF));
+        return *this;
+    }
+
+    Buffer& operator<<(int32_t val) { return *this << static_cast<uint32_t>(val); }
+
+    Buffer& operator<<(float val)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &val, sizeof(bits));
+        return *this << bits;
+    }
+
+    Buffer& operator<<(const std::string& val)
+    {
+        *this << static_cast<uint16_t>(val.size());
+        data.insert(data.end(), val.begin(), val.end());
+        return *this;
+    }
+
+    Buffer& operator>>(uint8_t& val)
+    {
+        val = readPos < data.size() ? data[readPos++] : 0;
+        return *this;
+    }
+
+    Buffer& operator>>(uint16_t& val)
+    {
+        uint8_t b0, b1;
+        *this >> b0 >> b1;
+        val = static_cast<uint16_t>(b0 | (b1 << 8));
+        return *this;
+    }
+
+    Buffer& operator>>(uint32_t& val)
+    {
+        uint8_t b0, b1, b2, b3;
+        *this >> b0 >> b1 >> b2 >> b3;
+        val = static_cast<uint32_t>(b0) | (static_cast<uint32_t>(b1) << 8) |
+              (static_cast<uint32_t>(b2) << 16) | (static_cast<uint32_t>(b3) << 24);
+        return *this;
+    }
+
+    Buffer& operator>>(int32_t& val)
+    {
+        uint32_t u;
+        *this >> u;
+        val = static_cast<int32_t>(u);
+        return *this;
+    }
+
+    Buffer& operator>>(float& val)
+    {
+        uint32_t bits;
+        *this >> bits;
+        std::memcpy(&val, &bits, sizeof(val));
+        return *this;
+    }
+
+    Buffer& operator>>(std::string& val)
+    {
+        uint16_t len;
+        *this >> len;
+        if (readPos + len <= data.size()) {
+            val.assign(reinterpret_cast<const char*>(data.data() + readPos), len);
+            readPos += len;
+        } else {
+            val.clear();
+        }
+        return *this;
+    }
+};
+
+// These were std::map members filled with map[key] = value; replay the pairs
+// into a map first so the bytes are the ones the old builders sent
+template<typename K, typename V>
+void packMap(Buffer& buf, const PacketPairs<K, V>& pairs)
+{
+    std::map<K, V> m;
+    for (const auto& [key, val] : pairs) {
+        m[key] = val;
+    }
+    buf << static_cast<uint16_t>(m.size());
+    for (const auto& [key, val] : m) {
+        buf << key << val;
+    }
+}
+
+template<typename K, typename V>
+void unpackMap(Buffer& buf, std::map<K, V>& m)
+{
+    uint16_t count;
+    buf >> count;
+    m.clear();
+    for (uint16_t i = 0; i < count; ++i) {
+        K key;
+        V val;
+        buf >> key >> val;
+        m[key] = val;
+    }
+}
+
+void pack(Buffer& buf, const GP_Server_Player& p)
+{
+    buf << p.m_guid << p.m_name << p.m_subName << p.m_classId << p.m_gender << p.m_portraitId;
+    buf << p.m_x << p.m_y << p.m_orientation;
+    packMap(buf, p.m_equipment);
+    packMap(buf, p.m_variables);
+}
+
+void unpack(Buffer& buf, GP_Server_Player& p)
+{
+    // These were std::map members before the packet schema; decode the old way
+    std::map<int32_t, int32_t> equipment;
+    std::map<int32_t, int32_t> variables;
+    buf >> p.m_guid >> p.m_name >> p.m_subName >> p.m_classId >> p.m_gender >> p.m_portraitId;
+    buf >> p.m_x >> p.m_y >> p.m_orientation;
+    unpackMap(buf, equipment);
+    unpackMap(buf, variables);
+    p.m_equipment.assign(equipment.begin(), equipment.end());
+    p.m_variables.assign(variables.begin(), variables.end());
+}
+
+void pack(Buffer& buf, const GP_Server_Npc& p)
+{
+    buf << p.m_guid << p.m_entry << p.m_x << p.m_y << p.m_orientation;
+    packMap(buf, p.m_variables);
+}
+
+void unpack(Buffer& buf, GP_Server_Npc& p)
+{
+    std::map<int32_t, int32_t> variables;
+    buf >> p.m_guid >> p.m_entry >> p.m_x >> p.m_y >> p.m_orientation;
+    unpackMap(buf, variables);
+    p.m_variables.assign(variables.begin(), variables.end());
+}
+
+void pack(Buffer& buf, const GP_Server_InspectReveal& p)
+{
+    buf << p.m_targetGuid << p.m_classId << p.m_guildName;
+    packMap(buf, p.m_equipment);
+    packMap(buf, p.m_variables);
+}
+
+void unpack(Buffer& buf, GP_Server_InspectReveal& p)
+{
+    std::map<int32_t, int32_t> equipment;
+    std::map<int32_t, int32_t> variables;
+    buf >> p.m_targetGuid >> p.m_classId >> p.m_guildName;
+    unpackMap(buf, equipment);
+    unpackMap(buf, variables);
+    p.m_equipment.assign(equipment.begin(), equipment.end());
+    p.m_variables.assign(variables.begin(), variables.end());
+}
+
+void pack(Buffer& buf, const GP_Server_Inventory& p)
+{
+    buf << p.m_gold << static_cast<uint16_t>(p.m_slots.size());
+    for (const auto& slot : p.m_slots) {
+        const auto& item = slot.itemId;
+        buf << slot.slot;
+        buf << item.m_itemId << item.m_affix1 << item.m_affix2 << item.m_gem1 << item.m_gem2 << item.m_gem3;
+        buf << slot.stackCount;
+    }
+}
+
+void unpack(Buffer& buf, GP_Server_Inventory& p)
+{
+    uint16_t count;
+    buf >> p.m_gold >> count;
+    p.m_slots.clear();
+    p.m_slots.reserve(count);
+    for (uint16_t i = 0; i < count; ++i) {
+        GP_Server_Inventory::Slot slot;
+        auto& item = slot.itemId;
+        buf >> slot.slot;
+        buf >> item.m_itemId >> item.m_affix1 >> item.m_affix2 >> item.m_gem1 >> item.m_gem2 >> item.m_gem3;
+        buf >> slot.stackCount;
+        p.m_slots.push_back(slot);
+    }
+}
+
+} // namespace Legacy
+
+using Clock = std::chrono::steady_clock;
+
+static GP_Server_Player makePlayer()
+{
+    GP_Server_Player packet;
+    packet.m_guid = 123456;
+    packet.m_name = "Benchmarker";
+    packet.m_subName = "<Bench Guild>";
+    packet.m_classId = 2;
+    packet.m_gender = 1;
+    packet.m_portraitId = 7;
+    packet.m_x = 1024.5f;
+    packet.m_y = 768.25f;
+    packet.m_orientation = 1.57f;
+    for (int32_t slot = 0; slot < 10; ++slot) {
+        packet.m_equipment.emplace_back(slot, 1000 + slot);
+    }
+    for (int32_t var = 0; var < 12; ++var) {
+        packet.m_variables.emplace_back(var, var * 37);
+    }
+    return packet;
+}
+
+static void addVariable(PacketPairs<int32_t, int32_t>& variables, ObjDefines::Variable var, int32_t value)
+{
+    variables.emplace_back(static_cast<int32_t>(var), value);
+}
+
+// Variables in the order WorldManager::buildNpcSnapshot adds them (not
+// sorted by id), then sorted the way it sends them
+static GP_Server_Npc makeNpc()
+{
+    using ObjDefines::Variable;
+    GP_Server_Npc packet;
+    packet.m_guid = 0x80001234;
+    packet.m_entry = 1042;
+    packet.m_x = 312.5f;
+    packet.m_y = 87.75f;
+    packet.m_orientation = 3.14f;
+    addVariable(packet.m_variables, Variable::Health, 850);
+    addVariable(packet.m_variables, Variable::MaxHealth, 900);
+    addVariable(packet.m_variables, Variable::Level, 14);
+    addVariable(packet.m_variables, Variable::Faction, 3);
+    addVariable(packet.m_variables, Variable::ModelId, 221);
+    addVariable(packet.m_variables, Variable::ModelScale, 100);
+    addVariable(packet.m_variables, Variable::MoveSpeedPct, 100);
+    addVariable(packet.m_variables, Variable::DynGossipStatus, 0);
+    addVariable(packet.m_variables, Variable::Elite, 1);
+    addVariable(packet.m_variables, Variable::Boss, 0);
+    addVariable(packet.m_variables, Variable::Mana, 120);
+    addVariable(packet.m_variables, Variable::MaxMana, 150);
+    sortPacketPairs(packet.m_variables);
+    return packet;
+}
+
+// As handleSetSelected builds GP_Server_InspectReveal
+static GP_Server_InspectReveal makeInspect()
+{
+    using ObjDefines::Variable;
+    GP_Server_InspectReveal packet;
+    packet.m_targetGuid = 654321;
+    packet.m_classId = 3;
+    packet.m_guildName = "Bench Guild";
+    for (int32_t slot = 1; slot < 12; slot += 2) {
+        packet.m_equipment.emplace_back(slot, 2000 + slot);
+    }
+    addVariable(packet.m_variables, Variable::Level, 20);
+    addVariable(packet.m_variables, Variable::MaxHealth, 1400);
+    addVariable(packet.m_variables, Variable::MaxMana, 600);
+    addVariable(packet.m_variables, Variable::Health, 1320);
+    addVariable(packet.m_variables, Variable::Mana, 410);
+    sortPacketPairs(packet.m_variables);
+    return packet;
+}
+
+static GP_Server_Inventory makeInventory()
+{
+    GP_Server_Inventory packet;
+    packet.m_gold = 98765;
+    for (int32_t i = 0; i < 40; ++i) {
+        GP_Server_Inventory::Slot slot;
+        slot.slot = i;
+        slot.itemId.m_itemId = 500 + i;
+        slot.itemId.m_affix1 = i % 5;
+        slot.itemId.m_affix2 = i % 3;
+        slot.itemId.m_gem1 = i % 7;
+        slot.stackCount = 1 + i % 20;
+        packet.m_slots.push_back(slot);
+    }
+    return packet;
+}
+
+// Same framing as the server's send path: opcode, then pack()
+static StlBuffer buildCurrent(const GamePacket& packet)
+{
+    StlBuffer buf;
+    uint16_t opcode = packet.getOpcode();
+    buf.reserve(sizeof(opcode) + packet.sizeHint());
+    buf << opcode;
+    packet.pack(buf);
+    return buf;
+}
+
+template<typename Packet>
+static Legacy::Buffer buildLegacy(const Packet& packet)
+{
+    Legacy::Buffer buf;
+    buf << packet.getOpcode();
+    Legacy::pack(buf, packet);
+    return buf;
+}
+
+template<typename Fn>
+static double timeNsPerOp(int iterations, Fn&& fn)
+{
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+}
+
+static void report(const char* what, double legacyNs, double currentNs)
+{
+    std::printf("  %-8s legacy %8.1f ns   current %8.1f ns   speedup %5.2fx\n",
+                what, legacyNs, currentNs, legacyNs / currentNs);
+}
+
+template<typename Packet>
+static bool bench(const char* name, const Packet& packet, int iterations)
+{
+    StlBuffer current = buildCurrent(packet);
+    Legacy::Buffer legacy = buildLegacy(packet);
+
+    // Correctness first: a fast encoder that changes the bytes is no use
+    if (current.size() != legacy.data.size() ||
+        std::memcmp(current.data(), legacy.data.data(), current.size()) != 0) {
+        std::printf("%s: encoders disagree (%zu vs %zu bytes)\n", name, current.size(), legacy.data.size());
+        return false;
+    }
+    if (packet.sizeHint() + sizeof(uint16_t) != current.size()) {
+        std::printf("%s: sizeHint() is %zu, pack() wrote %zu\n", name,
+                    packet.sizeHint(), current.size() - sizeof(uint16_t));
+        return false;
+    }
+
+    size_t sink = 0;
+    double legacyPack = timeNsPerOp(iterations, [&] { sink += buildLegacy(packet).data.size(); });
+    double currentPack = timeNsPerOp(iterations, [&] { sink += buildCurrent(packet).size(); });
+
+    double legacyUnpack = timeNsPerOp(iterations, [&] {
+        Legacy::Buffer buf;
+        buf.data = legacy.data;
+        uint16_t opcode;
+        buf >> opcode;
+        Packet out;
+        Legacy::unpack(buf, out);
+        sink += buf.readPos;
+    });
+    double currentUnpack = timeNsPerOp(iterations, [&] {
+        StlBuffer buf = StlBuffer::view(current.data(), current.size());
+        uint16_t opcode;
+        buf >> opcode;
+        Packet out;
+        out.unpack(buf);
+        sink += buf.readPos() + (buf.hasError() ? 1 : 0);
+    });
+
+    std::printf("%s (%zu bytes, %d iterations)\n", name, current.size(), iterations);
+    report("pack", legacyPack, currentPack);
+    report("unpack", legacyUnpack, currentUnpack);
+    return sink != 0;
+}
+
+int main(int argc, char* argv[])
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200000;
+    if (iterations <= 0) {
+        std::printf("Usage: DreadmystBufferBench [iterations]\n");
+        return 1;
+    }
+
+    bool ok = bench("GP_Server_Player", makePlayer(), iterations);
+    ok = bench("GP_Server_Npc", makeNpc(), iterations) && ok;
+    ok = bench("GP_Server_InspectReveal", makeInspect(), iterations) && ok;
+    ok = bench("GP_Server_Inventory", makeInventory(), iterations) && ok;
+
+    // A repeated key keeps its last value, as it did in the std::map
+    GP_Server_Npc repeated = makeNpc();
+    repeated.m_variables.emplace_back(static_cast<int32_t>(ObjDefines::Variable::Health), 1);
+    Legacy::Buffer legacyRepeated = buildLegacy(repeated);
+    sortPacketPairs(repeated.m_variables);
+    StlBuffer currentRepeated = buildCurrent(repeated);
+    if (currentRepeated.size() != legacyRepeated.data.size() ||
+        std::memcmp(currentRepeated.data(), legacyRepeated.data.data(), currentRepeated.size()) != 0) {
+        std::printf("sortPacketPairs() does not match std::map for a repeated key\n");
+        ok = false;
+    }
+
+    // Truncated input must read as zeros and raise the error flag
+    StlBuffer truncated = buildCurrent(makeInventory());
+    StlBuffer view = StlBuffer::view(truncated.data(), truncated.size() / 2);
+    uint16_t opcode;
+    GP_Server_Inventory out;
+    view >> opcode;
+    out.unpack(view);
+    if (!view.hasError()) {
+        std::printf("Truncated GP_Server_Inventory did not set the error flag\n");
+        ok = false;
+    }
+
+    return ok ? 0 : 1;
+}
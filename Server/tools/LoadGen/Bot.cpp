@@ -0,0 +1,384 @@
+// Bot - One scripted headless client
+
+#include "Bot.h"
+#include "Core/Logger.h"
+#include "GamePacketBase.h"
+#include "GamePacketClient.h"
+#include "GamePacketServer.h"
+#include "SpellDefines.h"
+#include "StlBuffer.h"
+
+#include <SFML/Network.hpp>
+#include <algorithm>
+
+namespace LoadGen
+{
+
+const char* getRequestName(Request request)
+{
+    switch (request) {
+        case Request::Authenticate:  return "Authenticate";
+        case Request::CharacterList: return "CharacterList";
+        case Request::CharCreate:    return "CharCreate";
+        case Request::EnterWorld:    return "EnterWorld";
+        case Request::Move:          return "Move";
+        case Request::Cast:          return "Cast";
+        case Request::Chat:          return "Chat";
+        case Request::Loot:          return "Loot";
+        case Request::Ping:          return "Ping";
+        default:                     return "Unknown";
+    }
+}
+
+uint16_t getRequestOpcode(Request request)
+{
+    switch (request) {
+        case Request::Authenticate:  return Opcode::Client_Authenticate;
+        case Request::CharacterList: return Opcode::Client_CharacterList;
+        case Request::CharCreate:    return Opcode::Client_CharCreate;
+        case Request::EnterWorld:    return Opcode::Client_EnterWorld;
+        case Request::Move:          return Opcode::Client_RequestMove;
+        case Request::Cast:          return Opcode::Client_CastSpell;
+        case Request::Chat:          return Opcode::Client_ChatMsg;
+        case Request::Loot:          return Opcode::Client_CastSpell;
+        case Request::Ping:          return Opcode::Mutual_Ping;
+        default:                     return 0;
+    }
+}
+
+Bot::Bot(uint32_t index, const Scenario& scenario, BotStats& stats)
+    : m_index(index)
+    , m_scenario(scenario)
+    , m_stats(stats)
+    , m_name(makeName(scenario.namePrefix, index))
+    , m_rng(index * 2654435761u + 1)
+{
+    m_knownNpcs.reserve(MAX_KNOWN_NPCS);
+}
+
+std::string Bot::makeName(const std::string& prefix, uint32_t index)
+{
+    // Fixed width keeps names unique and sorted; 5 letters cover 11M bots
+    std::string suffix(5, 'a');
+    for (size_t i = suffix.size(); i-- > 0; ) {
+        suffix[i] = static_cast<char>('a' + index % 26);
+        index /= 26;
+    }
+    return prefix + suffix;
+}
+
+sf::SocketHandle Bot::getHandle() const
+{
+    return m_socket ? m_socket->getNativeHandle() : static_cast<sf::SocketHandle>(-1);
+}
+
+bool Bot::connect(Clock::time_point now)
+{
+    auto tcp = std::make_shared<sf::TcpSocket>();
+
+    // Blocking connect: SFML's timed connect uses select(), which cannot
+    // handle descriptors past FD_SETSIZE
+    tcp->setBlocking(true);
+    if (tcp->connect(sf::IpAddress(m_scenario.host), m_scenario.port) != sf::Socket::Done) {
+        fail("connect failed");
+        return false;
+    }
+    tcp->setBlocking(false);
+
+    m_socket = std::make_unique<SfSocket>(tcp, SfSocket::Type::ClientSide);
+    m_stats.connected.fetch_add(1, std::memory_order_relaxed);
+
+    GP_Client_Authenticate auth;
+    auth.m_token = m_name + ":" + m_scenario.password;
+    send(Request::Authenticate, auth, now);
+    m_state = State::Authenticating;
+    return true;
+}
+
+void Bot::close()
+{
+    if (m_state == State::InWorld) {
+        m_stats.inWorld.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if (m_socket) {
+        m_stats.connected.fetch_sub(1, std::memory_order_relaxed);
+        m_socket->disconnect();
+        m_socket.reset();
+    }
+    m_pending.clear();
+    m_state = State::Closed;
+}
+
+void Bot::fail(const char* reason)
+{
+    // Only the first few failures are worth a log line each
+    uint32_t failures = m_stats.failed.fetch_add(1, std::memory_order_relaxed);
+    if (failures < 10) {
+        LOG_WARN("Bot %s: %s", m_name.c_str(), reason);
+    }
+    close();
+}
+
+void Bot::send(Request request, const GamePacket& packet, Clock::time_point now)
+{
+    if (!m_socket)
+        return;
+
+    StlBuffer buffer = packet.build(StlBuffer{});
+    bool queued = m_socket->queue(buffer);
+    size_t bytes = buffer.size() + 4;
+
+    // Fence: the ping's echo arrives once the request has been handled
+    if (queued && request != Request::Ping) {
+        StlBuffer ping = GP_Mutual_Ping().build(StlBuffer{});
+        queued = m_socket->queue(ping);
+        bytes += ping.size() + 4;
+    }
+
+    if (!queued) {
+        fail("send queue full");
+        return;
+    }
+
+    m_pending.push_back({request, now});
+    m_stats.packetsOut.fetch_add(request == Request::Ping ? 1 : 2, std::memory_order_relaxed);
+    m_stats.bytesOut.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+bool Bot::flush()
+{
+    if (!m_socket)
+        return false;
+
+    if (!m_socket->flush()) {
+        fail("connection lost while sending");
+        return false;
+    }
+    return true;
+}
+
+void Bot::onReadable(Clock::time_point now)
+{
+    do {
+        if (!m_socket)
+            return;
+
+        m_received.clear();
+        m_socket->receive(m_received);
+
+        for (const SfSocket::PacketView& view : m_received) {
+            StlBuffer packet = StlBuffer::view(view.data, view.size);
+            uint16_t opcode;
+            packet >> opcode;
+
+            m_stats.packetsIn.fetch_add(1, std::memory_order_relaxed);
+            m_stats.bytesIn.fetch_add(view.size + 4, std::memory_order_relaxed);
+
+            handlePacket(opcode, packet, now);
+            if (!m_socket)
+                return;
+        }
+    } while (m_socket->hasUnreadInput());
+
+    if (!m_socket->isConnected()) {
+        fail("disconnected by server");
+    }
+}
+
+void Bot::onPong(Clock::time_point now)
+{
+    if (m_pending.empty())
+        return;
+
+    PendingRequest pending = m_pending.front();
+    m_pending.pop_front();
+
+    uint64_t us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(now - pending.sentAt).count());
+    m_stats.latency[static_cast<size_t>(pending.request)].record(us);
+
+    // The server reads a request at the start of a tick and replies at its
+    // end, so an on-time server answers within two tick intervals
+    ++m_stats.roundTrips;
+    if (us > 2000ULL * static_cast<uint64_t>(m_scenario.tickIntervalMs)) {
+        ++m_stats.tickOverruns;
+    }
+}
+
+void Bot::handlePacket(uint16_t opcode, StlBuffer& payload, Clock::time_point now)
+{
+    switch (opcode) {
+        case Opcode::Mutual_Ping:
+            onPong(now);
+            break;
+
+        case Opcode::Server_Validate: {
+            GP_Server_Validate validate;
+            validate.unpack(payload);
+            if (validate.m_result != 0) {
+                fail("authentication rejected");
+                return;
+            }
+            send(Request::CharacterList, GP_Client_CharacterList(), now);
+            m_state = State::CharacterList;
+            break;
+        }
+
+        case Opcode::Server_CharacterList: {
+            // Character creation may push its own list as well as ours
+            if (m_state != State::CharacterList)
+                break;
+
+            GP_Server_CharacterList list;
+            list.unpack(payload);
+            if (!list.m_characters.empty()) {
+                enterWorld(list.m_characters.front().guid, now);
+            } else if (!m_createdCharacter) {
+                GP_Client_CharCreate create;
+                create.m_name = m_name.substr(0, 12);
+                create.m_classId = static_cast<uint8_t>(m_scenario.classId);
+                send(Request::CharCreate, create, now);
+                send(Request::CharacterList, GP_Client_CharacterList(), now);
+                m_createdCharacter = true;
+            } else {
+                fail("character creation failed");
+            }
+            break;
+        }
+
+        case Opcode::Server_SetController: {
+            GP_Server_SetController controller;
+            controller.unpack(payload);
+            m_guid = controller.m_guid;
+            break;
+        }
+
+        case Opcode::Server_NewWorld:
+            if (m_state == State::Entering) {
+                m_state = State::InWorld;
+                m_stats.inWorld.fetch_add(1, std::memory_order_relaxed);
+                scheduleNextAction(now);
+            }
+            break;
+
+        case Opcode::Server_Player: {
+            // Our own spawn gives the point we wander around
+            uint32_t guid;
+            payload >> guid;
+            if (guid == m_guid && !m_hasHome) {
+                payload.resetRead();
+                uint16_t skipOpcode;
+                payload >> skipOpcode;
+                GP_Server_Player player;
+                player.unpack(payload);
+                m_homeX = player.m_x;
+                m_homeY = player.m_y;
+                m_hasHome = true;
+            }
+            break;
+        }
+
+        case Opcode::Server_Npc: {
+            uint32_t guid;
+            payload >> guid;
+            if (m_knownNpcs.size() < MAX_KNOWN_NPCS) {
+                m_knownNpcs.push_back(guid);
+            } else {
+                m_knownNpcs[m_nextNpcSlot] = guid;
+                m_nextNpcSlot = (m_nextNpcSlot + 1) % MAX_KNOWN_NPCS;
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+void Bot::enterWorld(uint32_t guid, Clock::time_point now)
+{
+    // Server_SetController confirms it, but our own spawn may arrive first
+    m_guid = guid;
+
+    GP_Client_EnterWorld enter;
+    enter.m_characterGuid = guid;
+    send(Request::EnterWorld, enter, now);
+    m_state = State::Entering;
+}
+
+void Bot::scheduleNextAction(Clock::time_point now)
+{
+    int mean = m_scenario.actionIntervalMs;
+    std::uniform_int_distribution<int> jitter(mean / 2, mean + mean / 2);
+    m_nextAction = now + std::chrono::milliseconds(jitter(m_rng));
+}
+
+void Bot::update(Clock::time_point now)
+{
+    if (m_state != State::InWorld || now < m_nextAction)
+        return;
+
+    performAction(now);
+    scheduleNextAction(now);
+}
+
+uint32_t Bot::pickNpc()
+{
+    if (m_knownNpcs.empty())
+        return 0;
+    std::uniform_int_distribution<size_t> pick(0, m_knownNpcs.size() - 1);
+    return m_knownNpcs[pick(m_rng)];
+}
+
+void Bot::performAction(Clock::time_point now)
+{
+    std::uniform_int_distribution<int> roll(0, m_scenario.totalWeight() - 1);
+    Action action = m_scenario.pickAction(roll(m_rng));
+
+    switch (action) {
+        case Action::Move: {
+            std::uniform_real_distribution<float> offset(-m_scenario.moveRadius, m_scenario.moveRadius);
+            GP_Client_RequestMove move;
+            move.m_destX = m_homeX + offset(m_rng);
+            move.m_destY = m_homeY + offset(m_rng);
+            send(Request::Move, move, now);
+            break;
+        }
+
+        case Action::Cast: {
+            if (m_scenario.spellIds.empty())
+                break;
+            std::uniform_int_distribution<size_t> pick(0, m_scenario.spellIds.size() - 1);
+            GP_Client_CastSpell cast;
+            cast.m_spellId = m_scenario.spellIds[pick(m_rng)];
+            cast.m_targetGuid = pickNpc();
+            send(Request::Cast, cast, now);
+            break;
+        }
+
+        case Action::Chat: {
+            GP_Client_ChatMsg chat;
+            chat.m_channelId = m_scenario.chatChannel;
+            chat.m_text = m_name + " ";
+            chat.m_text.resize(std::max(chat.m_text.size(), static_cast<size_t>(m_scenario.chatLength)), 'x');
+            send(Request::Chat, chat, now);
+            break;
+        }
+
+        case Action::Loot: {
+            // Looting starts with the loot spell on a corpse
+            GP_Client_CastSpell loot;
+            loot.m_spellId = SpellDefines::StaticSpells::LootUnit;
+            loot.m_targetGuid = pickNpc();
+            send(Request::Loot, loot, now);
+            break;
+        }
+
+        case Action::Ping:
+        default:
+            send(Request::Ping, GP_Mutual_Ping(), now);
+            break;
+    }
+}
+
+} // namespace LoadGen
@@ -0,0 +1,146 @@
+// Bot - One scripted headless client
+// Logs in (authenticate -> character list -> create if needed -> enter
+// world), then loops over the scenario's action mix. Every request is
+// followed by a ping: the server handles a session's packets in order, so the
+// ping's echo marks the request as handled and gives its round-trip time.
+
+#pragma once
+
+#include "LatencyStats.h"
+#include "Scenario.h"
+#include "SfSocket.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+class GamePacket;
+class StlBuffer;
+
+namespace LoadGen
+{
+
+using Clock = std::chrono::steady_clock;
+
+// Requests timed by the load generator
+enum class Request : uint8_t
+{
+    Authenticate,
+    CharacterList,
+    CharCreate,
+    EnterWorld,
+    Move,
+    Cast,
+    Chat,
+    Loot,
+    Ping,
+    Count
+};
+
+const char* getRequestName(Request request);
+uint16_t getRequestOpcode(Request request);
+
+// Per-thread results. Latencies are only read after the thread stops; the
+// counters are read live for progress reports.
+struct BotStats
+{
+    LatencyStats latency[static_cast<size_t>(Request::Count)];
+
+    // Round trips that waited more than a full server tick
+    uint64_t roundTrips = 0;
+    uint64_t tickOverruns = 0;
+
+    std::atomic<uint32_t> connected{0};
+    std::atomic<uint32_t> inWorld{0};
+    std::atomic<uint32_t> failed{0};
+    std::atomic<uint64_t> packetsOut{0};
+    std::atomic<uint64_t> bytesOut{0};
+    std::atomic<uint64_t> packetsIn{0};
+    std::atomic<uint64_t> bytesIn{0};
+};
+
+class Bot
+{
+public:
+    enum class State : uint8_t
+    {
+        Waiting,         // Not connected yet
+        Authenticating,
+        CharacterList,
+        Entering,
+        InWorld,
+        Closed
+    };
+
+    Bot(uint32_t index, const Scenario& scenario, BotStats& stats);
+
+    // Open the connection and send the login request
+    bool connect(Clock::time_point now);
+    void close();
+
+    // Handle everything the socket has received
+    void onReadable(Clock::time_point now);
+
+    // Run the action timer
+    void update(Clock::time_point now);
+
+    // Write queued output. Returns false if the connection failed.
+    bool flush();
+
+    State getState() const { return m_state; }
+    bool isOpen() const { return m_state != State::Waiting && m_state != State::Closed; }
+    bool hasPendingOutput() const { return m_socket && m_socket->hasPendingOutput(); }
+    sf::SocketHandle getHandle() const;
+    const std::string& getName() const { return m_name; }
+
+private:
+    struct PendingRequest
+    {
+        Request request;
+        Clock::time_point sentAt;
+    };
+
+    void send(Request request, const GamePacket& packet, Clock::time_point now);
+    void handlePacket(uint16_t opcode, StlBuffer& payload, Clock::time_point now);
+    void onPong(Clock::time_point now);
+    void enterWorld(uint32_t guid, Clock::time_point now);
+    void performAction(Clock::time_point now);
+    void scheduleNextAction(Clock::time_point now);
+    void fail(const char* reason);
+
+    // A random NPC seen since entering the world (0 if none)
+    uint32_t pickNpc();
+
+    // Bot names are letters only: prefix + index in base 26
+    static std::string makeName(const std::string& prefix, uint32_t index);
+
+    uint32_t m_index;
+    const Scenario& m_scenario;
+    BotStats& m_stats;
+    std::string m_name;
+    std::mt19937 m_rng;
+
+    std::unique_ptr<SfSocket> m_socket;
+    std::vector<SfSocket::PacketView> m_received;
+    State m_state = State::Waiting;
+    bool m_createdCharacter = false;
+
+    std::deque<PendingRequest> m_pending;
+    Clock::time_point m_nextAction;
+
+    uint32_t m_guid = 0;
+    float m_homeX = 0.0f;
+    float m_homeY = 0.0f;
+    bool m_hasHome = false;
+
+    static constexpr size_t MAX_KNOWN_NPCS = 32;
+    std::vector<uint32_t> m_knownNpcs;
+    size_t m_nextNpcSlot = 0;
+};
+
+} // namespace LoadGen
@@ -0,0 +1,118 @@
+// Bot Worker - Drives a slice of the bots on one thread
+
+#include "BotWorker.h"
+
+namespace LoadGen
+{
+
+BotWorker::BotWorker(const Scenario& scenario, uint32_t firstBot, uint32_t botStride,
+                     Clock::time_point start)
+    : m_scenario(scenario)
+    , m_start(start)
+{
+    for (uint32_t index = firstBot; index < static_cast<uint32_t>(scenario.bots); index += botStride) {
+        m_bots.push_back(std::make_unique<Bot>(index, scenario, m_stats));
+        m_botIndex.push_back(index);
+    }
+    m_pollFds.reserve(m_bots.size());
+    m_polledBots.reserve(m_bots.size());
+}
+
+BotWorker::~BotWorker()
+{
+    stop();
+}
+
+void BotWorker::startThread()
+{
+    m_running = true;
+    m_thread = std::thread(&BotWorker::run, this);
+}
+
+void BotWorker::stop()
+{
+    m_running = false;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void BotWorker::run()
+{
+    while (m_running.load(std::memory_order_relaxed)) {
+        Clock::time_point now = Clock::now();
+        connectDueBots(now);
+        pollSockets(now);
+    }
+
+    for (auto& bot : m_bots) {
+        if (bot->isOpen()) {
+            bot->close();
+        }
+    }
+}
+
+void BotWorker::connectDueBots(Clock::time_point now)
+{
+    // Global bot i connects i / RampPerSecond seconds into the run
+    while (m_nextToConnect < m_bots.size()) {
+        auto due = m_start + std::chrono::microseconds(
+            1000000LL * m_botIndex[m_nextToConnect] / m_scenario.rampPerSecond);
+        if (due > now)
+            break;
+
+        Bot& bot = *m_bots[m_nextToConnect++];
+        if (bot.connect(now)) {
+            bot.flush();
+        }
+    }
+}
+
+void BotWorker::pollSockets(Clock::time_point now)
+{
+    m_pollFds.clear();
+    m_polledBots.clear();
+    for (auto& bot : m_bots) {
+        if (!bot->isOpen())
+            continue;
+
+        short events = POLLIN;
+        if (bot->hasPendingOutput())
+            events |= POLLOUT;
+        m_pollFds.push_back({bot->getHandle(), events, 0});
+        m_polledBots.push_back(bot.get());
+    }
+
+    if (m_pollFds.empty()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(MAX_POLL_MS));
+        return;
+    }
+
+    int ready = ::poll(m_pollFds.data(), m_pollFds.size(), MAX_POLL_MS);
+    now = Clock::now();
+
+    for (size_t i = 0; ready > 0 && i < m_pollFds.size(); ++i) {
+        short revents = m_pollFds[i].revents;
+        if (revents == 0)
+            continue;
+        --ready;
+
+        Bot& bot = *m_polledBots[i];
+        if (revents & (POLLIN | POLLHUP | POLLERR)) {
+            bot.onReadable(now);
+        }
+    }
+
+    // Run action timers and write whatever they (and the replies above)
+    // queued
+    for (Bot* bot : m_polledBots) {
+        if (!bot->isOpen())
+            continue;
+        bot->update(now);
+        if (bot->hasPendingOutput()) {
+            bot->flush();
+        }
+    }
+}
+
+} // namespace LoadGen
@@ -0,0 +1,57 @@
+// Bot Worker - Drives a slice of the bots on one thread
+// Bots are connected on the scenario's ramp schedule, then one poll() loop
+// handles their sockets and action timers until the run ends.
+
+#pragma once
+
+#include "Bot.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+
+namespace LoadGen
+{
+
+class BotWorker
+{
+public:
+    BotWorker(const Scenario& scenario, uint32_t firstBot, uint32_t botStride,
+              Clock::time_point start);
+    ~BotWorker();
+
+    void startThread();
+
+    // Ask the thread to disconnect its bots and exit, then wait for it
+    void stop();
+
+    const BotStats& getStats() const { return m_stats; }
+
+private:
+    void run();
+    void connectDueBots(Clock::time_point now);
+    void pollSockets(Clock::time_point now);
+
+    // Longest poll() wait, so action timers and the ramp stay on schedule
+    static constexpr int MAX_POLL_MS = 5;
+
+    const Scenario& m_scenario;
+    Clock::time_point m_start;
+    BotStats m_stats;
+
+    // Bot i here is global bot firstBot + i * botStride
+    std::vector<std::unique_ptr<Bot>> m_bots;
+    std::vector<uint32_t> m_botIndex;
+    size_t m_nextToConnect = 0;
+
+    std::vector<pollfd> m_pollFds;
+    std::vector<Bot*> m_polledBots;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+};
+
+} // namespace LoadGen
@@ -0,0 +1,68 @@
+// Latency Stats - Round-trip latency histogram for the load generator
+
+#include "LatencyStats.h"
+
+#include <algorithm>
+
+namespace LoadGen
+{
+
+size_t LatencyStats::bucketFor(uint64_t us)
+{
+    // Values below 16us get a bucket each; above that, 16 buckets per
+    // power of two
+    if (us < SUB_BUCKETS)
+        return static_cast<size_t>(us);
+
+    size_t exponent = 0;
+    for (uint64_t v = us; v > 1; v >>= 1)
+        ++exponent;
+
+    size_t sub = static_cast<size_t>((us >> (exponent - 4)) & (SUB_BUCKETS - 1));
+    return std::min((exponent - 3) * SUB_BUCKETS + sub, BUCKETS - 1);
+}
+
+uint64_t LatencyStats::bucketUpperBound(size_t bucket)
+{
+    if (bucket < SUB_BUCKETS)
+        return bucket;
+
+    size_t exponent = bucket / SUB_BUCKETS + 3;
+    uint64_t sub = bucket % SUB_BUCKETS;
+    uint64_t width = 1ULL << (exponent - 4);
+    return ((SUB_BUCKETS + sub) << (exponent - 4)) + width - 1;
+}
+
+void LatencyStats::record(uint64_t us)
+{
+    ++m_buckets[bucketFor(us)];
+    ++m_count;
+    m_totalUs += us;
+    m_maxUs = std::max(m_maxUs, us);
+}
+
+void LatencyStats::merge(const LatencyStats& other)
+{
+    for (size_t i = 0; i < BUCKETS; ++i)
+        m_buckets[i] += other.m_buckets[i];
+    m_count += other.m_count;
+    m_totalUs += other.m_totalUs;
+    m_maxUs = std::max(m_maxUs, other.m_maxUs);
+}
+
+uint64_t LatencyStats::percentile(double p) const
+{
+    if (m_count == 0)
+        return 0;
+
+    uint64_t target = static_cast<uint64_t>(p * static_cast<double>(m_count));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += m_buckets[i];
+        if (seen > target)
+            return std::min(bucketUpperBound(i), m_maxUs);
+    }
+    return m_maxUs;
+}
+
+} // namespace LoadGen
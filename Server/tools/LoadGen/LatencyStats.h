@@ -0,0 +1,41 @@
+// Latency Stats - Round-trip latency histogram for the load generator
+// Log-linear buckets (16 per power of two) keep percentiles within ~6% up to
+// the p999 tail in a fixed 6 KB per histogram. Each bot thread fills its own
+// histograms; the totals are merged once the run ends.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace LoadGen
+{
+
+class LatencyStats
+{
+public:
+    void record(uint64_t us);
+    void merge(const LatencyStats& other);
+
+    uint64_t getCount() const { return m_count; }
+    uint64_t getMaxUs() const { return m_maxUs; }
+    double getMeanUs() const { return m_count ? static_cast<double>(m_totalUs) / m_count : 0.0; }
+
+    // Upper bound of the bucket holding the p-th sample, p in [0, 1]
+    uint64_t percentile(double p) const;
+
+private:
+    static constexpr size_t SUB_BUCKETS = 16;
+    static constexpr size_t BUCKETS = 48 * SUB_BUCKETS;
+
+    static size_t bucketFor(uint64_t us);
+    static uint64_t bucketUpperBound(size_t bucket);
+
+    std::array<uint64_t, BUCKETS> m_buckets{};
+    uint64_t m_count = 0;
+    uint64_t m_totalUs = 0;
+    uint64_t m_maxUs = 0;
+};
+
+} // namespace LoadGen
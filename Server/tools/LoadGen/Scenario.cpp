@@ -0,0 +1,141 @@
+// Scenario - Load generator run description
+
+#include "Scenario.h"
+#include "ChatDefines.h"
+#include "Config.h"
+#include "Core/Logger.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <sstream>
+
+namespace LoadGen
+{
+
+const char* getActionName(Action action)
+{
+    switch (action) {
+        case Action::Move: return "Move";
+        case Action::Cast: return "Cast";
+        case Action::Chat: return "Chat";
+        case Action::Loot: return "Loot";
+        case Action::Ping: return "Ping";
+        default:           return "Unknown";
+    }
+}
+
+static std::vector<int32_t> parseIdList(const std::string& text)
+{
+    std::vector<int32_t> ids;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        try {
+            ids.push_back(std::stoi(item));
+        } catch (...) {
+            LOG_WARN("Scenario: ignoring spell id '%s'", item.c_str());
+        }
+    }
+    return ids;
+}
+
+static bool parseChatChannel(const std::string& text, uint8_t& channel)
+{
+    using ChatDefines::Channels;
+    if (text == "Say")     { channel = static_cast<uint8_t>(Channels::Say); return true; }
+    if (text == "Yell")    { channel = static_cast<uint8_t>(Channels::Yell); return true; }
+    if (text == "AllChat") { channel = static_cast<uint8_t>(Channels::AllChat); return true; }
+    return false;
+}
+
+bool Scenario::load(const std::string& path)
+{
+    Config config;
+    if (!config.load(path)) {
+        LOG_ERROR("Scenario: cannot read '%s'", path.c_str());
+        return false;
+    }
+
+    name = config.getString("Scenario", "Name", name);
+
+    host = config.getString("Server", "Host", host);
+    port = static_cast<uint16_t>(config.getInt("Server", "Port", port));
+    tickIntervalMs = std::max(1, config.getInt("Server", "TickIntervalMs", tickIntervalMs));
+
+    bots = std::max(1, config.getInt("Bots", "Count", bots));
+    threads = std::max(1, config.getInt("Bots", "Threads", threads));
+    rampPerSecond = std::max(1, config.getInt("Bots", "RampPerSecond", rampPerSecond));
+    durationSeconds = std::max(1, config.getInt("Bots", "DurationSeconds", durationSeconds));
+    reportIntervalSeconds = std::max(1, config.getInt("Bots", "ReportIntervalSeconds", reportIntervalSeconds));
+    namePrefix = config.getString("Bots", "NamePrefix", namePrefix);
+    password = config.getString("Bots", "Password", password);
+    classId = config.getInt("Bots", "ClassId", classId);
+
+    actionIntervalMs = std::max(1, config.getInt("Actions", "IntervalMs", actionIntervalMs));
+    for (size_t i = 0; i < static_cast<size_t>(Action::Count); ++i) {
+        const char* key = getActionName(static_cast<Action>(i));
+        weights[i] = std::max(0, config.getInt("Actions", key, weights[i]));
+    }
+
+    moveRadius = config.getFloat("Move", "Radius", moveRadius);
+
+    std::string spells = config.getString("Cast", "SpellIds", "");
+    if (!spells.empty()) {
+        spellIds = parseIdList(spells);
+    }
+
+    std::string channel = config.getString("Chat", "Channel", "Say");
+    if (!parseChatChannel(channel, chatChannel)) {
+        LOG_WARN("Scenario: unknown chat channel '%s', using Say", channel.c_str());
+    }
+    chatLength = std::clamp(config.getInt("Chat", "MessageLength", chatLength), 1, 255);
+
+    // Bot names must be letters only
+    if (namePrefix.empty() ||
+        !std::all_of(namePrefix.begin(), namePrefix.end(), [](char c) { return std::isalpha(static_cast<unsigned char>(c)); })) {
+        LOG_ERROR("Scenario: NamePrefix must be letters only");
+        return false;
+    }
+
+    if (totalWeight() == 0) {
+        LOG_ERROR("Scenario: every action weight is zero");
+        return false;
+    }
+    return true;
+}
+
+int Scenario::totalWeight() const
+{
+    int total = 0;
+    for (int weight : weights) {
+        total += weight;
+    }
+    return total;
+}
+
+Action Scenario::pickAction(int roll) const
+{
+    for (size_t i = 0; i < static_cast<size_t>(Action::Count); ++i) {
+        if (roll < weights[i])
+            return static_cast<Action>(i);
+        roll -= weights[i];
+    }
+    return Action::Ping;
+}
+
+void Scenario::print() const
+{
+    std::printf("Scenario '%s': %d bots on %d thread(s) -> %s:%u, ramp %d/s, %ds\n",
+                name.c_str(), bots, threads, host.c_str(), port, rampPerSecond, durationSeconds);
+    std::printf("  Action every %dms (+/-50%%):", actionIntervalMs);
+    int total = totalWeight();
+    for (size_t i = 0; i < static_cast<size_t>(Action::Count); ++i) {
+        if (weights[i] > 0) {
+            std::printf(" %s %d%%", getActionName(static_cast<Action>(i)), weights[i] * 100 / total);
+        }
+    }
+    std::printf("\n");
+}
+
+} // namespace LoadGen
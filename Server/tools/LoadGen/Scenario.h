@@ -0,0 +1,70 @@
+// Scenario - Load generator run description
+// Loaded from an INI file (see tools/LoadGen/scenarios) so a production
+// traffic mix can be reproduced locally. Every value has a default; command
+// line options override the connection and size settings.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace LoadGen
+{
+
+// What an in-world bot can do each time its action timer fires
+enum class Action : uint8_t
+{
+    Move,
+    Cast,
+    Chat,
+    Loot,
+    Ping,
+    Count
+};
+
+const char* getActionName(Action action);
+
+struct Scenario
+{
+    std::string name = "default";
+
+    // [Server]
+    std::string host = "127.0.0.1";
+    uint16_t port = 8080;
+    int tickIntervalMs = 50;  // Server tick, for the overrun estimate
+
+    // [Bots]
+    int bots = 100;
+    int threads = 2;
+    int rampPerSecond = 100;     // New connections per second
+    int durationSeconds = 60;    // Whole run, ramp included
+    int reportIntervalSeconds = 10;
+    std::string namePrefix = "lg";  // Letters only; the bot index is appended as letters
+    std::string password = "pass1234";
+    int classId = 1;
+
+    // [Actions]
+    int actionIntervalMs = 1000;  // Mean; each wait is jittered +/-50%
+    int weights[static_cast<size_t>(Action::Count)] = {60, 10, 10, 5, 15};
+
+    // [Move]
+    float moveRadius = 150.0f;  // Around the bot's spawn point
+
+    // [Cast]
+    std::vector<int32_t> spellIds = {13, 10};
+
+    // [Chat]
+    uint8_t chatChannel = 0;  // ChatDefines::Channels
+    int chatLength = 32;
+
+    bool load(const std::string& path);
+
+    // Pick an action by weight; `roll` is uniform in [0, totalWeight())
+    Action pickAction(int roll) const;
+    int totalWeight() const;
+
+    void print() const;
+};
+
+} // namespace LoadGen
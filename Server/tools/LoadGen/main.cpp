@@ -0,0 +1,216 @@
+// Dreadmyst Load Generator - Headless bots for server load testing
+// Usage: DreadmystLoadGen [scenario.ini] [--bots N] [--threads N]
+//                         [--duration S] [--host H] [--port P]
+// Runs the scenario's bots against a live server, printing progress while
+// it runs and per-request round-trip percentiles at the end.
+
+#include "BotWorker.h"
+#include "Core/Logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+using namespace LoadGen;
+
+static std::atomic<bool> g_running{true};
+
+static void signalHandler(int)
+{
+    g_running = false;
+}
+
+static void printUsage()
+{
+    std::printf("Usage: DreadmystLoadGen [scenario.ini] [--bots N] [--threads N] "
+                "[--duration S] [--host H] [--port P]\n");
+}
+
+static bool parseArgs(int argc, char* argv[], Scenario& scenario)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return false;
+        } else if (arg == "--bots" && hasValue) {
+            scenario.bots = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--threads" && hasValue) {
+            scenario.threads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--duration" && hasValue) {
+            scenario.durationSeconds = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--host" && hasValue) {
+            scenario.host = argv[++i];
+        } else if (arg == "--port" && hasValue) {
+            scenario.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        } else if (arg.rfind("--", 0) != 0) {
+            if (!scenario.load(arg))
+                return false;
+        } else {
+            printUsage();
+            return false;
+        }
+    }
+    return true;
+}
+
+// Each bot needs a descriptor; raise the soft limit as far as allowed
+static void raiseFileLimit(int bots)
+{
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0)
+        return;
+
+    rlim_t wanted = static_cast<rlim_t>(bots) + 64;
+    if (limit.rlim_cur >= wanted)
+        return;
+
+    limit.rlim_cur = std::min(wanted, limit.rlim_max);
+    setrlimit(RLIMIT_NOFILE, &limit);
+    if (limit.rlim_cur < wanted) {
+        LOG_WARN("Open file limit is %llu; some of the %d bots will fail to connect",
+                 static_cast<unsigned long long>(limit.rlim_cur), bots);
+    }
+}
+
+struct Totals
+{
+    uint32_t connected = 0;
+    uint32_t inWorld = 0;
+    uint32_t failed = 0;
+    uint64_t packetsOut = 0;
+    uint64_t bytesOut = 0;
+    uint64_t packetsIn = 0;
+    uint64_t bytesIn = 0;
+};
+
+static Totals sumCounters(const std::vector<std::unique_ptr<BotWorker>>& workers)
+{
+    Totals totals;
+    for (const auto& worker : workers) {
+        const BotStats& stats = worker->getStats();
+        totals.connected += stats.connected.load(std::memory_order_relaxed);
+        totals.inWorld += stats.inWorld.load(std::memory_order_relaxed);
+        totals.failed += stats.failed.load(std::memory_order_relaxed);
+        totals.packetsOut += stats.packetsOut.load(std::memory_order_relaxed);
+        totals.bytesOut += stats.bytesOut.load(std::memory_order_relaxed);
+        totals.packetsIn += stats.packetsIn.load(std::memory_order_relaxed);
+        totals.bytesIn += stats.bytesIn.load(std::memory_order_relaxed);
+    }
+    return totals;
+}
+
+static void printReport(const Scenario& scenario, const std::vector<std::unique_ptr<BotWorker>>& workers,
+                        const Totals& totals, double seconds)
+{
+    LatencyStats latency[static_cast<size_t>(Request::Count)];
+    uint64_t roundTrips = 0;
+    uint64_t overruns = 0;
+    for (const auto& worker : workers) {
+        const BotStats& stats = worker->getStats();
+        for (size_t i = 0; i < static_cast<size_t>(Request::Count); ++i) {
+            latency[i].merge(stats.latency[i]);
+        }
+        roundTrips += stats.roundTrips;
+        overruns += stats.tickOverruns;
+    }
+
+    std::printf("\n=== Load test '%s': %.1fs, %d bots ===\n", scenario.name.c_str(), seconds, scenario.bots);
+    std::printf("Bots: %u in world at end, %u failed\n", totals.inWorld, totals.failed);
+    std::printf("Throughput: out %.0f pkt/s (%.1f KB/s), in %.0f pkt/s (%.1f KB/s)\n",
+                totals.packetsOut / seconds, totals.bytesOut / 1024.0 / seconds,
+                totals.packetsIn / seconds, totals.bytesIn / 1024.0 / seconds);
+    std::printf("Tick overrun (estimate): %llu of %llu round trips took over two %dms ticks (%.2f%%)\n",
+                static_cast<unsigned long long>(overruns), static_cast<unsigned long long>(roundTrips),
+                scenario.tickIntervalMs, roundTrips ? 100.0 * overruns / roundTrips : 0.0);
+
+    std::printf("\n%-14s %6s %9s %9s %9s %9s %9s %9s\n",
+                "Request", "Opcode", "Count", "Mean ms", "p50 ms", "p99 ms", "p999 ms", "Max ms");
+    for (size_t i = 0; i < static_cast<size_t>(Request::Count); ++i) {
+        const LatencyStats& stats = latency[i];
+        if (stats.getCount() == 0)
+            continue;
+
+        Request request = static_cast<Request>(i);
+        std::printf("%-14s 0x%04X %9llu %9.2f %9.2f %9.2f %9.2f %9.2f\n",
+                    getRequestName(request), getRequestOpcode(request),
+                    static_cast<unsigned long long>(stats.getCount()),
+                    stats.getMeanUs() / 1000.0,
+                    stats.percentile(0.50) / 1000.0,
+                    stats.percentile(0.99) / 1000.0,
+                    stats.percentile(0.999) / 1000.0,
+                    stats.getMaxUs() / 1000.0);
+    }
+    std::fflush(stdout);
+}
+
+int main(int argc, char* argv[])
+{
+    Scenario scenario;
+    if (!parseArgs(argc, argv, scenario))
+        return 1;
+
+    std::signal(SIGINT, signalHandler);
+    std::signal(SIGTERM, signalHandler);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    scenario.threads = std::min(scenario.threads, scenario.bots);
+    raiseFileLimit(scenario.bots);
+    scenario.print();
+
+    // Bots are dealt out round-robin so every thread ramps up together
+    Clock::time_point start = Clock::now();
+    std::vector<std::unique_ptr<BotWorker>> workers;
+    for (int i = 0; i < scenario.threads; ++i) {
+        workers.push_back(std::make_unique<BotWorker>(scenario, static_cast<uint32_t>(i),
+                                                      static_cast<uint32_t>(scenario.threads), start));
+    }
+    for (auto& worker : workers) {
+        worker->startThread();
+    }
+
+    Clock::time_point end = start + std::chrono::seconds(scenario.durationSeconds);
+    Clock::time_point nextReport = start + std::chrono::seconds(scenario.reportIntervalSeconds);
+    Totals previous;
+    Clock::time_point previousTime = start;
+
+    while (g_running && Clock::now() < end) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        Clock::time_point now = Clock::now();
+        if (now < nextReport)
+            continue;
+        nextReport += std::chrono::seconds(scenario.reportIntervalSeconds);
+
+        Totals totals = sumCounters(workers);
+        double elapsed = std::chrono::duration<double>(now - previousTime).count();
+        LOG_INFO("%3.0fs: %u connected, %u in world, %u failed | out %.0f pkt/s, in %.0f pkt/s (%.1f KB/s)",
+                 std::chrono::duration<double>(now - start).count(),
+                 totals.connected, totals.inWorld, totals.failed,
+                 (totals.packetsOut - previous.packetsOut) / elapsed,
+                 (totals.packetsIn - previous.packetsIn) / elapsed,
+                 (totals.bytesIn - previous.bytesIn) / 1024.0 / elapsed);
+        previous = totals;
+        previousTime = now;
+    }
+
+    // Totals are taken before stopping so "in world" reflects the run
+    Totals totals = sumCounters(workers);
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (auto& worker : workers) {
+        worker->stop();
+    }
+
+    printReport(scenario, workers, totals, seconds);
+    return totals.inWorld > 0 ? 0 : 1;
+}
@@ -0,0 +1,380 @@
+// Path Bench - pathfinding benchmark over every .map file in a directory
+// Usage: DreadmystPathBench [mapsDir] [queriesPerMap]
+// Each map's load time is printed first (from the .smap cache, or from the
+// .map source when the cache is missing or stale, which writes it).
+// Runs the same walkable start/goal pairs (fixed seed; anywhere on the map,
+// and within LOCAL_RADIUS cells of the start) through the server's JPS
+// Pathfinder and the shared 4-way BFS (MapLogic::constructPathTo,
+// which allocates its parent array per call) and reports the time per query
+// and the waypoints left after smoothing.
+// Both must agree on which goals are reachable: diagonal steps never cut
+// corners, so 8-way and 4-way connectivity are the same. Long queries only
+// return their first leg (timed); the remaining legs are then followed,
+// untimed, to check that every path really ends at the goal.
+// A "los" line then times line of sight the way AoE and aggro use it: one
+// caster against LOS_TARGETS nearby cells, through MapLogic::checkLosToC, the
+// map's sight bitset one target at a time, and the batch call. All three
+// must give the same answers.
+// A "move" line checks the clearance field the way move validation uses it:
+// how far a straight walk gets (against stepping through every cell on the
+// way) and walkable-with-radius points (against testing every cell in the
+// radius). The field may only be stricter on points, never looser.
+
+#include "stdafx.h"
+#include "World/Map.h"
+#include "World/Pathfinder.h"
+#include "Core/Logger.h"
+#include "MapLogic.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct Query
+{
+    float fromX, fromY;
+    float toX, toY;
+};
+
+static double elapsedUs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+// Goal distance for the "local" set: what NPC chase and wander queries look like
+static constexpr int LOCAL_RADIUS = 32;
+
+// More legs than this means the leg planning is going round in circles
+static constexpr int MAX_LEGS = 500;
+
+// Run one set of pairs through both searches and print a line. Unreachable
+// goals make both searches flood the whole region, so the reachable queries
+// are also timed on their own.
+static bool runPairs(const Map& map, const char* label, const std::vector<Query>& pairs)
+{
+    // Unlimited expansions so reachability can be compared with the BFS
+    Pathfinder::setTickBudget(0);
+
+    std::vector<MoveSpline::Point> jpsPath;
+    std::vector<bool> jpsFound;
+    size_t points = 0;
+    size_t legs = 0;
+    int brokenLegs = 0;
+    double jpsUs = 0.0;
+    double jpsFoundUs = 0.0;
+    for (const Query& q : pairs) {
+        Clock::time_point start = Clock::now();
+        PathResult result = Pathfinder::findPath(map, q.fromX, q.fromY, q.toX, q.toY, jpsPath, UINT32_MAX);
+        double us = elapsedUs(start);
+        jpsUs += us;
+        jpsFound.push_back(result == PathResult::Found);
+        if (result == PathResult::Found) {
+            jpsFoundUs += us;
+            points += jpsPath.size();
+
+            // Ask again from the end of each leg, as an NPC would
+            int leg = 1;
+            while (jpsPath.back().x != q.toX || jpsPath.back().y != q.toY) {
+                MoveSpline::Point end = jpsPath.back();
+                if (++leg > MAX_LEGS ||
+                    Pathfinder::findPath(map, end.x, end.y, q.toX, q.toY, jpsPath, UINT32_MAX) != PathResult::Found) {
+                    ++brokenLegs;
+                    break;
+                }
+            }
+            legs += static_cast<size_t>(leg);
+        }
+    }
+
+    std::vector<Geo2d::Vector2> bfsPath;
+    std::vector<bool> bfsFound;
+    double bfsUs = 0.0;
+    double bfsFoundUs = 0.0;
+    for (const Query& q : pairs) {
+        Clock::time_point start = Clock::now();
+        MapLogic::constructPathTo(map, bfsPath, Geo2d::Vector2(q.fromX, q.fromY), Geo2d::Vector2(q.toX, q.toY));
+        double us = elapsedUs(start);
+        bool found = !bfsPath.empty() || (std::floor(q.fromX) == std::floor(q.toX) &&
+                                          std::floor(q.fromY) == std::floor(q.toY));
+        bfsUs += us;
+        bfsFound.push_back(found);
+        if (found) {
+            bfsFoundUs += us;
+        }
+    }
+
+    int found = 0;
+    int mismatches = 0;
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        found += jpsFound[i] ? 1 : 0;
+        mismatches += jpsFound[i] != bfsFound[i] ? 1 : 0;
+    }
+    int queries = static_cast<int>(pairs.size());
+    int reachable = std::max(found, 1);
+
+    std::printf("%-20s %4d %-6s found %3d/%-3d  all: JPS %8.1f us BFS %8.1f us"
+                "  reachable: JPS %7.1f us BFS %7.1f us  %4.1f pts %4.1f legs%s%s\n",
+                map.getName().c_str(), map.getWidth(), label, found, queries,
+                jpsUs / queries, bfsUs / queries, jpsFoundUs / reachable, bfsFoundUs / reachable,
+                static_cast<double>(points) / reachable, static_cast<double>(legs) / reachable,
+                mismatches > 0 ? "  REACHABILITY MISMATCH" : "",
+                brokenLegs > 0 ? "  LEGS DO NOT REACH GOAL" : "");
+    return mismatches == 0 && brokenLegs == 0;
+}
+
+// Targets per caster in the "los" line (a busy AoE)
+static constexpr int LOS_TARGETS = 32;
+
+static bool runLos(const Map& map, const std::vector<int>& walkable, int casters, std::mt19937& rng)
+{
+    std::uniform_int_distribution<size_t> pick(0, walkable.size() - 1);
+    std::uniform_int_distribution<int> offset(-LOCAL_RADIUS, LOCAL_RADIUS);
+    int width = map.getWidth();
+
+    std::vector<float> xs(LOS_TARGETS);
+    std::vector<float> ys(LOS_TARGETS);
+    std::vector<uint8_t> batch(LOS_TARGETS);
+    double cellUs = 0.0;
+    double bitsUs = 0.0;
+    double batchUs = 0.0;
+    int visible = 0;
+    int mismatches = 0;
+    for (int c = 0; c < casters; ++c) {
+        int from = walkable[pick(rng)];
+        float fx = from % width + 0.5f;
+        float fy = from / width + 0.5f;
+        for (int i = 0; i < LOS_TARGETS; ++i) {
+            xs[i] = fx + offset(rng);
+            ys[i] = fy + offset(rng);
+        }
+
+        bool cell[LOS_TARGETS];
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < LOS_TARGETS; ++i) {
+            cell[i] = MapLogic::checkLosToC(map, Geo2d::Vector2(fx, fy), Geo2d::Vector2(xs[i], ys[i]),
+                                            MapCellT::CollideBlock);
+        }
+        cellUs += elapsedUs(start);
+
+        bool bits[LOS_TARGETS];
+        start = Clock::now();
+        for (int i = 0; i < LOS_TARGETS; ++i) {
+            bits[i] = map.hasLineOfSight(fx, fy, xs[i], ys[i]);
+        }
+        bitsUs += elapsedUs(start);
+
+        start = Clock::now();
+        visible += static_cast<int>(map.getSightLayer().segmentsClear(fx, fy, xs.data(), ys.data(),
+                                                                      LOS_TARGETS, batch.data()));
+        batchUs += elapsedUs(start);
+
+        for (int i = 0; i < LOS_TARGETS; ++i) {
+            mismatches += (cell[i] != bits[i] || bits[i] != (batch[i] != 0)) ? 1 : 0;
+        }
+    }
+
+    std::printf("%-20s %4d los    visible %4.1f/%-3d  per caster: cells %6.2f us bits %6.2f us batch %6.2f us%s\n",
+                map.getName().c_str(), width, static_cast<double>(visible) / casters, LOS_TARGETS,
+                cellUs / casters, bitsUs / casters, batchUs / casters,
+                mismatches > 0 ? "  LOS MISMATCH" : "");
+    return mismatches == 0;
+}
+
+// Radius of the "move" line's point checks (cells)
+static constexpr float MOVE_RADIUS = 2.0f;
+
+// Walk from `from` towards `to` one cell at a time: the reference for
+// ClearanceField::clearLength
+static float stepClearLength(const Map& map, float fx, float fy, float tx, float ty)
+{
+    float dx = tx - fx;
+    float dy = ty - fy;
+    float length = std::sqrt(dx * dx + dy * dy);
+    int cx = static_cast<int>(std::floor(fx));
+    int cy = static_cast<int>(std::floor(fy));
+    if (!map.isWalkable(cx, cy))
+        return 0.0f;
+    if (length < 1e-4f)
+        return length;
+
+    float ux = dx / length;
+    float uy = dy / length;
+    float t = 0.0f;
+    for (;;) {
+        float x = fx + ux * t;
+        float y = fy + uy * t;
+        cx = static_cast<int>(std::floor(x));
+        cy = static_cast<int>(std::floor(y));
+        float exitX = ux > 0.0f ? (cx + 1 - x) / ux : ux < 0.0f ? (cx - x) / ux : length;
+        float exitY = uy > 0.0f ? (cy + 1 - y) / uy : uy < 0.0f ? (cy - y) / uy : length;
+        float exit = t + std::min(exitX, exitY);
+        if (exit >= length)
+            return length;
+
+        t = exit + 1e-3f;
+        int nx = static_cast<int>(std::floor(fx + ux * t));
+        int ny = static_cast<int>(std::floor(fy + uy * t));
+        if (!map.isWalkable(nx, ny) ||
+            (nx != cx && ny != cy && (!map.isWalkable(nx, cy) || !map.isWalkable(cx, ny))))
+            return exit;
+    }
+}
+
+static bool runMoves(const Map& map, const std::vector<int>& walkable, int moves, std::mt19937& rng)
+{
+    std::uniform_int_distribution<size_t> pick(0, walkable.size() - 1);
+    std::uniform_real_distribution<float> offset(-LOCAL_RADIUS, LOCAL_RADIUS);
+    std::uniform_real_distribution<float> inCell(0.0f, 0.999f);
+    const ClearanceField& field = map.getClearance();
+    const int width = map.getWidth();
+    const int reach = static_cast<int>(MOVE_RADIUS);
+
+    double fieldUs = 0.0;
+    double stepUs = 0.0;
+    double pointFieldUs = 0.0;
+    double pointCellsUs = 0.0;
+    int clear = 0;
+    int mismatches = 0;
+    int stricter = 0;
+    for (int m = 0; m < moves; ++m) {
+        int from = walkable[pick(rng)];
+        float fx = from % width + inCell(rng);
+        float fy = from / width + inCell(rng);
+        float tx = fx + offset(rng);
+        float ty = fy + offset(rng);
+
+        Clock::time_point start = Clock::now();
+        float byField = field.clearLength(fx, fy, tx, ty);
+        fieldUs += elapsedUs(start);
+
+        start = Clock::now();
+        float bySteps = stepClearLength(map, fx, fy, tx, ty);
+        stepUs += elapsedUs(start);
+
+        clear += field.isSegmentClear(fx, fy, tx, ty) ? 1 : 0;
+        mismatches += std::abs(byField - bySteps) > 0.01f ? 1 : 0;
+
+        // The destination, with room around it
+        int cx = static_cast<int>(std::floor(tx));
+        int cy = static_cast<int>(std::floor(ty));
+        start = Clock::now();
+        bool fieldClear = field.isClear(tx, ty, MOVE_RADIUS);
+        pointFieldUs += elapsedUs(start);
+
+        start = Clock::now();
+        bool cellsClear = true;
+        for (int y = cy - reach; y <= cy + reach && cellsClear; ++y) {
+            for (int x = cx - reach; x <= cx + reach; ++x) {
+                int ox = x - cx;
+                int oy = y - cy;
+                if (ox * ox + oy * oy <= MOVE_RADIUS * MOVE_RADIUS && !map.isWalkable(x, y)) {
+                    cellsClear = false;
+                    break;
+                }
+            }
+        }
+        pointCellsUs += elapsedUs(start);
+
+        mismatches += (fieldClear && !cellsClear) ? 1 : 0;
+        stricter += (!fieldClear && cellsClear) ? 1 : 0;
+    }
+
+    std::printf("%-20s %4d move   clear %3d/%-4d per move: field %6.2f us steps %6.2f us, "
+                "radius %.0f: field %5.2f us cells %5.2f us (%d stricter)%s\n",
+                map.getName().c_str(), width, clear, moves, fieldUs / moves, stepUs / moves,
+                MOVE_RADIUS, pointFieldUs / moves, pointCellsUs / moves, stricter,
+                mismatches > 0 ? "  CLEARANCE MISMATCH" : "");
+    return mismatches == 0;
+}
+
+static bool benchMap(const std::string& path, int queries)
+{
+    Map map;
+    Clock::time_point loadStart = Clock::now();
+    if (!map.load(path)) {
+        std::printf("%s: failed to load\n", path.c_str());
+        return false;
+    }
+    std::printf("%-20s %4d load   from %-6s %8.1f ms\n", map.getName().c_str(), map.getWidth(),
+                map.isFromCache() ? "cache" : "source", elapsedUs(loadStart) / 1000.0);
+
+    std::vector<int> walkable;
+    for (int cell = 0; cell < map.getNumCells(); ++cell) {
+        if (map.isWalkable(cell)) {
+            walkable.push_back(cell);
+        }
+    }
+    if (walkable.size() < 2) {
+        std::printf("%-20s %4d  no walkable cells\n", map.getName().c_str(), map.getWidth());
+        return true;
+    }
+
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<size_t> pick(0, walkable.size() - 1);
+    std::uniform_int_distribution<int> offset(-LOCAL_RADIUS, LOCAL_RADIUS);
+    int width = map.getWidth();
+
+    // Anywhere to anywhere, and to a walkable cell near the start
+    std::vector<Query> randomPairs;
+    std::vector<Query> localPairs;
+    for (int i = 0; i < queries; ++i) {
+        int from = walkable[pick(rng)];
+        int to = walkable[pick(rng)];
+        int fx = from % width;
+        int fy = from / width;
+        randomPairs.push_back({fx + 0.5f, fy + 0.5f, to % width + 0.5f, to / width + 0.5f});
+
+        for (int attempt = 0; attempt < 64; ++attempt) {
+            int tx = fx + offset(rng);
+            int ty = fy + offset(rng);
+            if (map.isWalkable(tx, ty)) {
+                localPairs.push_back({fx + 0.5f, fy + 0.5f, tx + 0.5f, ty + 0.5f});
+                break;
+            }
+        }
+    }
+
+    bool ok = runPairs(map, "random", randomPairs);
+    ok = runPairs(map, "local", localPairs) && ok;
+    ok = runLos(map, walkable, queries, rng) && ok;
+    return runMoves(map, walkable, queries, rng) && ok;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string mapsDir = argc > 1 ? argv[1] : "../game/maps";
+    int queries = argc > 2 ? std::atoi(argv[2]) : 200;
+    if (queries <= 0) {
+        std::printf("Usage: DreadmystPathBench [mapsDir] [queriesPerMap]\n");
+        return 1;
+    }
+
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(mapsDir, ec)) {
+        if (entry.path().extension() == ".map") {
+            files.push_back(entry.path().string());
+        }
+    }
+    if (files.empty()) {
+        std::printf("No .map files in %s\n", mapsDir.c_str());
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+
+    sLogger.setLevel(LogLevel::Warning);
+
+    bool ok = true;
+    for (const std::string& file : files) {
+        ok = benchMap(file, queries) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -240,11 +240,16 @@ public:
     virtual void pack(StlBuffer& buf) const = 0;
     virtual void unpack(StlBuffer& buf) = 0;
 
+    // Expected pack() size in bytes, used to reserve the buffer up front.
+    // 0 = unknown; SchemaPacket computes it exactly from the field list.
+    virtual size_t sizeHint() const { return 0; }
+
     // Build packet with opcode header
     StlBuffer build(StlBuffer buf) const
     {
         (void)buf;
         StlBuffer result;
+        result.reserve(sizeof(uint16_t) + sizeHint());
         uint16_t op = getOpcode();
         result << op;
         pack(result);
@@ -0,0 +1,335 @@
+#pragma once
+
+#include "GamePacketBase.h"
+#include "ItemDefines.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Compile-time packet schema
+//
+// A packet derives from SchemaPacket<Self, Opcode> and lists its wire fields
+// once, in wire order, with PACKET_FIELDS(...). pack(), unpack() and an exact
+// sizeHint() are generated from that list, and they are final so calls on a
+// concrete packet type are resolved statically. Nested structs (container
+// elements) describe themselves with PACKET_FIELDS as well.
+//
+// Containers are a uint16 count followed by the elements, the layout the
+// hand-written packets always used. Hot packets should use PacketPairs (a
+// flat vector of key/value pairs) rather than std::map: no tree nodes to
+// allocate while building the packet. A PacketPairs goes out in insertion
+// order, so builders call sortPacketPairs() before packing to send the
+// bytes the std::map version did.
+
+#define PACKET_FIELDS(...) \
+    auto fields() { return std::tie(__VA_ARGS__); } \
+    auto fields() const { return std::tie(__VA_ARGS__); }
+
+template<typename K, typename V>
+using PacketPairs = std::vector<std::pair<K, V>>;
+
+// Puts a PacketPairs in std::map order: keys ascending, and a key added more
+// than once keeps its last value, as repeated map[key] = value would
+template<typename K, typename V>
+void sortPacketPairs(PacketPairs<K, V>& pairs)
+{
+    std::stable_sort(pairs.begin(), pairs.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    size_t out = 0;
+    for (size_t i = 0; i < pairs.size(); ++i)
+    {
+        if (out > 0 && pairs[out - 1].first == pairs[i].first)
+            pairs[out - 1].second = std::move(pairs[i].second);
+        else
+            pairs[out++] = std::move(pairs[i]);
+    }
+    pairs.resize(out);
+}
+
+namespace PacketWire
+{
+    // One specialization per wire type. Unsupported field types fail to
+    // compile here instead of being serialized wrongly.
+    //   put(buf, val)  - append val
+    //   get(buf, val)  - read val (zero/empty and StlBuffer::hasError() on truncation)
+    //   size(val)      - bytes put() will write
+    //   kFixedSize     - bytes for every value of the type, 0 if it varies
+    template<typename T, typename Enable = void>
+    struct Codec;
+
+    template<typename T>
+    void put(StlBuffer& buf, const T& val) { Codec<T>::put(buf, val); }
+
+    template<typename T>
+    void get(StlBuffer& buf, T& val) { Codec<T>::get(buf, val); }
+
+    template<typename T>
+    size_t size(const T& val) { return Codec<T>::size(val); }
+
+    // Counts are 16 bits; longer containers are cut, like strings
+    constexpr size_t MaxCount = 0xFFFF;
+
+    inline size_t remaining(const StlBuffer& buf) { return buf.size() - buf.readPos(); }
+
+    template<typename... Ts>
+    constexpr size_t fixedSizeOf()
+    {
+        if constexpr (sizeof...(Ts) == 0) {
+            return 0;
+        } else {
+            return ((Codec<Ts>::kFixedSize != 0) && ...) ? (Codec<Ts>::kFixedSize + ...) : 0;
+        }
+    }
+
+    template<typename T>
+    struct Codec<T, std::enable_if_t<std::is_arithmetic_v<T>>>
+    {
+        static constexpr size_t kFixedSize = std::is_same_v<T, bool> ? 1 : sizeof(T);
+        static void put(StlBuffer& buf, T val) { buf << val; }
+        static void get(StlBuffer& buf, T& val) { buf >> val; }
+        static size_t size(T) { return kFixedSize; }
+    };
+
+    // Enums travel as their underlying type
+    template<typename T>
+    struct Codec<T, std::enable_if_t<std::is_enum_v<T>>>
+    {
+        using Raw = std::underlying_type_t<T>;
+        static constexpr size_t kFixedSize = sizeof(Raw);
+        static void put(StlBuffer& buf, T val) { buf << static_cast<Raw>(val); }
+        static void get(StlBuffer& buf, T& val) { Raw raw; buf >> raw; val = static_cast<T>(raw); }
+        static size_t size(T) { return kFixedSize; }
+    };
+
+    template<>
+    struct Codec<std::string>
+    {
+        static constexpr size_t kFixedSize = 0;
+        static void put(StlBuffer& buf, const std::string& val) { buf << val; }
+        static void get(StlBuffer& buf, std::string& val) { buf >> val; }
+        static size_t size(const std::string& val) { return sizeof(uint16_t) + std::min<size_t>(val.size(), 0xFFFF); }
+    };
+
+    template<typename A, typename B>
+    struct Codec<std::pair<A, B>>
+    {
+        static constexpr size_t kFixedSize = fixedSizeOf<A, B>();
+        static void put(StlBuffer& buf, const std::pair<A, B>& val) { PacketWire::put(buf, val.first); PacketWire::put(buf, val.second); }
+        static void get(StlBuffer& buf, std::pair<A, B>& val) { PacketWire::get(buf, val.first); PacketWire::get(buf, val.second); }
+        static size_t size(const std::pair<A, B>& val) { return PacketWire::size(val.first) + PacketWire::size(val.second); }
+    };
+
+    // Write side shared by vector and set
+    template<typename Container>
+    struct SequenceCodec
+    {
+        using Element = typename Container::value_type;
+        static constexpr size_t kFixedSize = 0;
+
+        static void put(StlBuffer& buf, const Container& val)
+        {
+            uint16_t count = static_cast<uint16_t>(std::min(val.size(), MaxCount));
+            buf << count;
+            auto it = val.begin();
+            for (uint16_t i = 0; i < count; ++i, ++it) {
+                PacketWire::put(buf, *it);
+            }
+        }
+
+        static size_t size(const Container& val)
+        {
+            size_t count = std::min(val.size(), MaxCount);
+            if constexpr (Codec<Element>::kFixedSize != 0) {
+                return sizeof(uint16_t) + count * Codec<Element>::kFixedSize;
+            } else {
+                size_t total = sizeof(uint16_t);
+                auto it = val.begin();
+                for (size_t i = 0; i < count; ++i, ++it) {
+                    total += PacketWire::size(*it);
+                }
+                return total;
+            }
+        }
+    };
+
+    template<typename T>
+    struct Codec<std::vector<T>> : SequenceCodec<std::vector<T>>
+    {
+        static void get(StlBuffer& buf, std::vector<T>& val)
+        {
+            uint16_t count;
+            buf >> count;
+            val.clear();
+            // Never trust the count further than the bytes actually present
+            val.reserve(std::min<size_t>(count, remaining(buf)));
+            for (uint16_t i = 0; i < count && !buf.hasError(); ++i) {
+                T item{};
+                PacketWire::get(buf, item);
+                val.push_back(std::move(item));
+            }
+        }
+    };
+
+    template<typename T>
+    struct Codec<std::set<T>> : SequenceCodec<std::set<T>>
+    {
+        static void get(StlBuffer& buf, std::set<T>& val)
+        {
+            uint16_t count;
+            buf >> count;
+            val.clear();
+            for (uint16_t i = 0; i < count && !buf.hasError(); ++i) {
+                T item{};
+                PacketWire::get(buf, item);
+                val.insert(std::move(item));
+            }
+        }
+    };
+
+    template<typename K, typename V>
+    struct Codec<std::map<K, V>>
+    {
+        static constexpr size_t kFixedSize = 0;
+
+        static void put(StlBuffer& buf, const std::map<K, V>& val)
+        {
+            uint16_t count = static_cast<uint16_t>(std::min(val.size(), MaxCount));
+            buf << count;
+            auto it = val.begin();
+            for (uint16_t i = 0; i < count; ++i, ++it) {
+                PacketWire::put(buf, it->first);
+                PacketWire::put(buf, it->second);
+            }
+        }
+
+        static size_t size(const std::map<K, V>& val)
+        {
+            size_t count = std::min(val.size(), MaxCount);
+            if constexpr (fixedSizeOf<K, V>() != 0) {
+                return sizeof(uint16_t) + count * fixedSizeOf<K, V>();
+            } else {
+                size_t total = sizeof(uint16_t);
+                auto it = val.begin();
+                for (size_t i = 0; i < count; ++i, ++it) {
+                    total += PacketWire::size(it->first) + PacketWire::size(it->second);
+                }
+                return total;
+            }
+        }
+
+        static void get(StlBuffer& buf, std::map<K, V>& val)
+        {
+            uint16_t count;
+            buf >> count;
+            val.clear();
+            for (uint16_t i = 0; i < count && !buf.hasError(); ++i) {
+                K key{};
+                V item{};
+                PacketWire::get(buf, key);
+                PacketWire::get(buf, item);
+                val[key] = std::move(item);
+            }
+        }
+    };
+
+    // Item references carry the id, both affixes and the first three gems
+    template<typename T>
+    struct ItemIdCodec
+    {
+        static constexpr size_t kFixedSize = 6 * sizeof(int32_t);
+
+        static void put(StlBuffer& buf, const T& item)
+        {
+            buf << item.m_itemId << item.m_affix1 << item.m_affix2
+                << item.m_gem1 << item.m_gem2 << item.m_gem3;
+        }
+
+        static void get(StlBuffer& buf, T& item)
+        {
+            buf >> item.m_itemId >> item.m_affix1 >> item.m_affix2
+                >> item.m_gem1 >> item.m_gem2 >> item.m_gem3;
+        }
+
+        static size_t size(const T&) { return kFixedSize; }
+    };
+
+    template<>
+    struct Codec<ItemDefines::ItemId> : ItemIdCodec<ItemDefines::ItemId> {};
+
+    template<>
+    struct Codec<ItemDefines::ItemDefinition> : ItemIdCodec<ItemDefines::ItemDefinition> {};
+
+    template<typename Tuple>
+    struct TupleFixedSize;
+
+    template<typename... Ts>
+    struct TupleFixedSize<std::tuple<Ts...>>
+    {
+        static constexpr size_t value = fixedSizeOf<std::decay_t<Ts>...>();
+    };
+
+    // Anything that lists its members with PACKET_FIELDS
+    template<typename T>
+    struct Codec<T, std::void_t<decltype(std::declval<const T&>().fields())>>
+    {
+        static constexpr size_t kFixedSize =
+            TupleFixedSize<decltype(std::declval<const T&>().fields())>::value;
+
+        static void put(StlBuffer& buf, const T& val)
+        {
+            std::apply([&buf](const auto&... field) { (PacketWire::put(buf, field), ...); }, val.fields());
+        }
+
+        static void get(StlBuffer& buf, T& val)
+        {
+            std::apply([&buf](auto&... field) { (PacketWire::get(buf, field), ...); }, val.fields());
+        }
+
+        static size_t size(const T& val)
+        {
+            if constexpr (kFixedSize != 0) {
+                return kFixedSize;
+            } else {
+                return std::apply([](const auto&... field) { return (size_t(0) + ... + PacketWire::size(field)); },
+                                  val.fields());
+            }
+        }
+    };
+}
+
+// Base for packets described by PACKET_FIELDS
+template<typename Derived, uint16_t Op>
+class SchemaPacket : public GamePacket
+{
+public:
+    static constexpr uint16_t kOpcode = Op;
+
+    uint16_t getOpcode() const final { return Op; }
+    void pack(StlBuffer& buf) const final { PacketWire::put(buf, derived()); }
+    void unpack(StlBuffer& buf) final { PacketWire::get(buf, derived()); }
+    size_t sizeHint() const final { return PacketWire::size(derived()); }
+
+    // Same as GamePacket::build, without going through the vtable
+    StlBuffer build(StlBuffer buf = StlBuffer()) const
+    {
+        (void)buf;
+        StlBuffer result;
+        result.reserve(sizeof(Op) + PacketWire::size(derived()));
+        result << Op;
+        PacketWire::put(result, derived());
+        return result;
+    }
+
+    // Payload-less packets keep this; the rest hide it with PACKET_FIELDS
+    std::tuple<> fields() const { return {}; }
+
+private:
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+    Derived& derived() { return static_cast<Derived&>(*this); }
+};
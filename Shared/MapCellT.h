@@ -11,8 +11,8 @@ public:
     enum Flags : uint8_t
     {
         None         = 0x00,
-        Unwalkable   = 0x01,  // Cannot walk through
-        CollideBlock = 0x02,  // Blocks line of sight
+        Unwalkable   = 0x20,  // Cannot walk through
+        CollideBlock = 0x40,  // Blocks line of sight
     };
 
     MapCellT() : m_flags(None) {}
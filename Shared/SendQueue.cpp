@@ -0,0 +1,221 @@
+// SendQueue - Bounded outbound frame queue
+
+#include "SendQueue.h"
+#include <algorithm>
+#include <cstring>
+
+SendQueue::SendQueue(size_t maxBytes)
+{
+    setMaxBytes(maxBytes);
+}
+
+void SendQueue::setMaxBytes(size_t maxBytes)
+{
+    m_maxBytes = std::max(maxBytes, BLOCK_SIZE);
+
+    // Enough slots to hold a full queue of standard blocks, plus room for
+    // oversized single-frame blocks. Rotating first keeps queued blocks in
+    // order when the ring grows.
+    size_t slots = m_maxBytes / BLOCK_SIZE + 2;
+    if (slots > m_blocks.size())
+    {
+        std::rotate(m_blocks.begin(), m_blocks.begin() + m_head, m_blocks.end());
+        m_head = 0;
+        m_blocks.resize(slots);
+    }
+}
+
+bool SendQueue::appendFrame(const uint8_t* payload, size_t size)
+{
+    const size_t frameSize = 4 + size;
+
+    if (m_bytes + frameSize > m_maxBytes)
+    {
+        ++m_stats.overflows;
+        return false;
+    }
+
+    // Append to the newest block when it has room, otherwise start a new one
+    Block* block = writableTail();
+    if (!block || block->storage.size() - block->end < frameSize)
+        block = pushBlock(frameSize);
+
+    // Wire format: [4 bytes: payload size (uint32 LE)] [payload]
+    uint8_t* out = block->storage.data() + block->end;
+    uint32_t len = static_cast<uint32_t>(size);
+    out[0] = static_cast<uint8_t>(len & 0xFF);
+    out[1] = static_cast<uint8_t>((len >> 8) & 0xFF);
+    out[2] = static_cast<uint8_t>((len >> 16) & 0xFF);
+    out[3] = static_cast<uint8_t>((len >> 24) & 0xFF);
+    if (size > 0)
+        std::memcpy(out + 4, payload, size);
+    block->end += frameSize;
+
+    m_bytes += frameSize;
+    ++m_stats.framesQueued;
+    m_stats.bytesQueued += frameSize;
+    m_stats.peakDepth = std::max(m_stats.peakDepth, m_bytes);
+    return true;
+}
+
+bool SendQueue::appendFrames(const uint8_t* data, size_t size, uint32_t frames)
+{
+    if (m_bytes + size > m_maxBytes)
+    {
+        ++m_stats.overflows;
+        return false;
+    }
+
+    // Frames need not stay contiguous here, so fill the newest block and
+    // spill into standard-size blocks
+    size_t copied = 0;
+    while (copied < size)
+    {
+        Block* block = writableTail();
+        if (!block || block->end == block->storage.size())
+            block = pushBlock(BLOCK_SIZE);
+
+        size_t n = std::min(size - copied, block->storage.size() - block->end);
+        std::memcpy(block->storage.data() + block->end, data + copied, n);
+        block->end += n;
+        copied += n;
+    }
+
+    m_bytes += size;
+    m_stats.framesQueued += frames;
+    m_stats.bytesQueued += size;
+    m_stats.peakDepth = std::max(m_stats.peakDepth, m_bytes);
+    return true;
+}
+
+bool SendQueue::appendShared(std::shared_ptr<const void> owner, const uint8_t* data, size_t size)
+{
+    if (m_bytes + size > m_maxBytes)
+    {
+        ++m_stats.overflows;
+        return false;
+    }
+
+    if (m_count == m_blocks.size())
+        growRing();
+
+    Block& block = blockAt(m_count);
+    block.owner = std::move(owner);
+    block.external = data;
+    block.begin = 0;
+    block.end = size;
+    ++m_count;
+
+    m_bytes += size;
+    ++m_stats.framesQueued;
+    m_stats.bytesQueued += size;
+    m_stats.peakDepth = std::max(m_stats.peakDepth, m_bytes);
+    return true;
+}
+
+SendQueue::Block* SendQueue::writableTail()
+{
+    if (m_count == 0)
+        return nullptr;
+
+    Block* tail = &blockAt(m_count - 1);
+    return tail->external ? nullptr : tail;
+}
+
+void SendQueue::growRing()
+{
+    std::rotate(m_blocks.begin(), m_blocks.begin() + m_head, m_blocks.end());
+    m_head = 0;
+    m_blocks.resize(m_blocks.size() * 2);
+}
+
+SendQueue::Block* SendQueue::pushBlock(size_t size)
+{
+    if (m_count == m_blocks.size())
+        growRing();
+
+    Block* block = &blockAt(m_count);
+    size_t needed = std::max(size, BLOCK_SIZE);
+    if (block->storage.size() < needed)
+    {
+        if (block->storage.empty())
+            ++m_allocated;
+        block->storage.resize(needed);
+    }
+    block->begin = 0;
+    block->end = 0;
+    ++m_count;
+    return block;
+}
+
+size_t SendQueue::peek(Chunk* out, size_t maxChunks) const
+{
+    size_t n = std::min(m_count, maxChunks);
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Block& block = blockAt(i);
+        out[i].data = block.bytes() + block.begin;
+        out[i].size = block.end - block.begin;
+    }
+    return n;
+}
+
+void SendQueue::consume(size_t bytes)
+{
+    bytes = std::min(bytes, m_bytes);
+    m_bytes -= bytes;
+    m_stats.bytesSent += bytes;
+
+    while (bytes > 0 && m_count > 0)
+    {
+        Block& block = blockAt(0);
+        size_t pending = block.end - block.begin;
+
+        if (bytes < pending)
+        {
+            block.begin += bytes;
+            return;
+        }
+
+        bytes -= pending;
+        block.begin = block.end = 0;
+        releaseStorage(block);
+        m_head = (m_head + 1) % m_blocks.size();
+        --m_count;
+    }
+}
+
+void SendQueue::clear()
+{
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        Block& block = blockAt(i);
+        block.begin = block.end = 0;
+        releaseStorage(block);
+    }
+    m_head = 0;
+    m_count = 0;
+    m_bytes = 0;
+}
+
+void SendQueue::releaseStorage(Block& block)
+{
+    // Drop our reference to a shared frame; any storage the slot held from
+    // earlier use is kept
+    if (block.external)
+    {
+        block.owner.reset();
+        block.external = nullptr;
+        return;
+    }
+
+    if (block.storage.empty())
+        return;
+
+    // Oversized blocks and anything beyond the retained set go back to the heap
+    if (block.storage.size() != BLOCK_SIZE || m_allocated > RETAINED_BLOCKS)
+    {
+        std::vector<uint8_t>().swap(block.storage);
+        --m_allocated;
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Bounded outbound queue for one connection
+// Frames ([4-byte length][payload]) are copied back to back into a ring of
+// reusable blocks, so queuing a packet normally costs one memcpy and no
+// allocation. Frames shared between connections (broadcasts) are queued by
+// reference instead. The socket drains it with one scatter/gather write
+// covering every queued block, and anything the kernel did not accept stays
+// queued.
+class SendQueue
+{
+public:
+    // A contiguous run of queued bytes, in send order
+    struct Chunk
+    {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+    };
+
+    // Lifetime counters (monotonic, for rate reporting)
+    struct Stats
+    {
+        uint64_t framesQueued = 0;
+        uint64_t bytesQueued = 0;
+        uint64_t bytesSent = 0;
+        uint64_t writeCalls = 0;
+        uint64_t overflows = 0;
+        size_t peakDepth = 0;
+    };
+
+    static constexpr size_t BLOCK_SIZE = 16 * 1024;
+    static constexpr size_t DEFAULT_MAX_BYTES = 256 * 1024;
+
+    explicit SendQueue(size_t maxBytes = DEFAULT_MAX_BYTES);
+
+    // Change the byte limit (takes effect for subsequent appends)
+    void setMaxBytes(size_t maxBytes);
+    size_t getMaxBytes() const { return m_maxBytes; }
+
+    // Queue one frame: length header + payload.
+    // Returns false (and queues nothing) if the frame would exceed the limit.
+    bool appendFrame(const uint8_t* payload, size_t size);
+
+    // Queue bytes that already hold `frames` complete frames. Returns false
+    // (and queues nothing) if they would exceed the limit.
+    bool appendFrames(const uint8_t* data, size_t size, uint32_t frames);
+
+    // Queue one complete frame owned by someone else, without copying it.
+    // `owner` keeps the bytes alive until they have been sent.
+    bool appendShared(std::shared_ptr<const void> owner, const uint8_t* data, size_t size);
+
+    // Fill `out` with up to maxChunks runs of pending bytes, oldest first
+    size_t peek(Chunk* out, size_t maxChunks) const;
+
+    // Drop `bytes` from the front after they were written to the socket
+    void consume(size_t bytes);
+
+    // Record one write syscall (for frames-per-write statistics)
+    void noteWrite() { ++m_stats.writeCalls; }
+
+    // Discard everything queued
+    void clear();
+
+    size_t size() const { return m_bytes; }
+    bool empty() const { return m_bytes == 0; }
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    struct Block
+    {
+        std::vector<uint8_t> storage;  // Capacity kept between uses
+        size_t begin = 0;              // First unsent byte
+        size_t end = 0;                // One past the last queued byte
+
+        // Shared frame: bytes live in `external`, kept alive by `owner`
+        std::shared_ptr<const void> owner;
+        const uint8_t* external = nullptr;
+
+        const uint8_t* bytes() const { return external ? external : storage.data(); }
+    };
+
+    // Blocks that keep their storage once drained (the rest are freed so idle
+    // sessions do not pin a full queue's worth of memory)
+    static constexpr size_t RETAINED_BLOCKS = 2;
+
+    Block& blockAt(size_t index) { return m_blocks[(m_head + index) % m_blocks.size()]; }
+    const Block& blockAt(size_t index) const { return m_blocks[(m_head + index) % m_blocks.size()]; }
+    void releaseStorage(Block& block);
+
+    // Start a new block with room for at least `size` bytes
+    Block* pushBlock(size_t size);
+
+    // Tail block if more bytes can be copied into it
+    Block* writableTail();
+
+    // Double the slot count (many small shared frames need more slots than
+    // the byte limit alone suggests)
+    void growRing();
+
+    std::vector<Block> m_blocks;  // Ring of block slots
+    size_t m_head = 0;            // Slot index of the oldest block
+    size_t m_count = 0;           // Blocks currently queued
+    size_t m_allocated = 0;       // Slots holding storage
+    size_t m_bytes = 0;           // Unsent bytes
+    size_t m_maxBytes;
+    Stats m_stats;
+};
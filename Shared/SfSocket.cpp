@@ -3,6 +3,29 @@
 
 #include "SfSocket.h"
 #include <SFML/Network.hpp>
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <cerrno>
+#endif
+
+namespace
+{
+    // sf::Socket::getHandle() is protected. A derived type may form a pointer to
+    // the member and apply it to any sf::Socket, which gives us the OS handle
+    // without patching SFML.
+    struct SocketHandleAccess : sf::Socket
+    {
+        static sf::SocketHandle get(const sf::Socket& socket)
+        {
+            return (socket.*(&SocketHandleAccess::getHandle))();
+        }
+    };
+}
 
 SfSocket::SfSocket(Type type)
     : m_type(type)
@@ -30,77 +53,243 @@ bool SfSocket::update()
         return false;
 
     // Try to receive any pending data (this just appends to buffer)
-    std::vector<std::unique_ptr<StlBuffer>> dummy;
+    std::vector<PacketView> dummy;
     receive(dummy);  // Ignoring received packets in update, caller should call popReceived
 
     return isConnected();
 }
 
 bool SfSocket::send(const StlBuffer& data)
+{
+    return queue(data) && flush();
+}
+
+bool SfSocket::queue(const StlBuffer& data)
 {
     if (!m_socket || !isConnected())
         return false;
 
-    // Build packet with size header
-    StlBuffer packet;
-    packet.build(StlBuffer(std::vector<uint8_t>(data.data(), data.data() + data.size())));
+    return m_sendQueue.appendFrame(data.data(), data.size());
+}
 
-    size_t sent = 0;
-    auto status = m_socket->send(packet.data(), packet.size(), sent);
-    return (status == sf::Socket::Done || status == sf::Socket::Partial);
+bool SfSocket::queueFrames(const uint8_t* data, size_t size, uint32_t frames)
+{
+    if (!m_socket || !isConnected())
+        return false;
+
+    return m_sendQueue.appendFrames(data, size, frames);
 }
 
-void SfSocket::receive(std::vector<std::unique_ptr<StlBuffer>>& output)
+bool SfSocket::queueShared(std::shared_ptr<const void> owner, const uint8_t* data, size_t size)
+{
+    if (!m_socket || !isConnected())
+        return false;
+
+    return m_sendQueue.appendShared(std::move(owner), data, size);
+}
+
+void SfSocket::setNoDelay(bool enabled)
+{
+#if !defined(_WIN32)
+    int value = enabled ? 1 : 0;
+    ::setsockopt(getNativeHandle(), IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value));
+#else
+    (void)enabled;  // SFML already disables Nagle on its TCP sockets
+#endif
+}
+
+bool SfSocket::flush()
+{
+    if (!m_socket)
+        return false;
+
+    // Max chunks per gather write (each chunk is one queue block)
+    constexpr size_t MAX_CHUNKS = 64;
+    SendQueue::Chunk chunks[MAX_CHUNKS];
+
+    while (!m_sendQueue.empty()) {
+        size_t count = m_sendQueue.peek(chunks, MAX_CHUNKS);
+
+#if !defined(_WIN32)
+        // One gather write for all queued blocks. sendmsg is writev plus flags,
+        // which lets us suppress SIGPIPE on a peer that already went away.
+        iovec iov[MAX_CHUNKS];
+        for (size_t i = 0; i < count; ++i) {
+            iov[i].iov_base = const_cast<uint8_t*>(chunks[i].data);
+            iov[i].iov_len = chunks[i].size;
+        }
+
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+
+        int flags = 0;
+#ifdef MSG_NOSIGNAL
+        flags |= MSG_NOSIGNAL;
+#endif
+#ifdef MSG_MORE
+        // More than MAX_CHUNKS blocks queued: cork this write so the kernel
+        // does not push a short segment before the next one
+        size_t peeked = 0;
+        for (size_t i = 0; i < count; ++i)
+            peeked += chunks[i].size;
+        if (peeked < m_sendQueue.size())
+            flags |= MSG_MORE;
+#endif
+        ssize_t written = ::sendmsg(getNativeHandle(), &msg, flags);
+        m_sendQueue.noteWrite();
+
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return true;  // Kernel buffer full - retry on next flush
+
+            disconnect();
+            return false;
+        }
+
+        m_sendQueue.consume(static_cast<size_t>(written));
+#else
+        // No gather write through SFML: send block by block
+        for (size_t i = 0; i < count; ++i) {
+            size_t sent = 0;
+            auto status = m_socket->send(chunks[i].data, chunks[i].size, sent);
+            m_sendQueue.noteWrite();
+            m_sendQueue.consume(sent);
+
+            if (status == sf::Socket::Partial || status == sf::Socket::NotReady)
+                return true;  // Retry the rest on next flush
+            if (status != sf::Socket::Done) {
+                disconnect();
+                return false;
+            }
+        }
+#endif
+    }
+
+    return true;
+}
+
+void SfSocket::receive(std::vector<PacketView>& output)
 {
     if (!m_socket)
         return;
 
-    // Receive into buffer
-    uint8_t tempBuf[4096];
-    size_t received = 0;
-    auto status = m_socket->receive(tempBuf, sizeof(tempBuf), received);
+    // Everything before m_recvBegin was handed out by the previous call
+    if (m_recvBegin == m_recvEnd) {
+        m_recvBegin = m_recvEnd = 0;
+        if (m_recvBuffer.size() > RECV_BUFFER_SIZE) {
+            // Shrink back after an oversized packet
+            std::vector<uint8_t>(RECV_BUFFER_SIZE).swap(m_recvBuffer);
+        }
+    }
+    if (m_recvBuffer.empty()) {
+        m_recvBuffer.resize(RECV_BUFFER_SIZE);
+    }
+
+    // Receive straight into the buffer. Non-blocking sockets are read until
+    // they would block so an edge-triggered poller never misses data left in
+    // the kernel buffer.
+    m_recvLimited = false;
+    const bool drain = !m_socket->isBlocking();
+    sf::Socket::Status status = sf::Socket::Done;
+    do {
+        if (m_recvEnd == m_recvBuffer.size() && !makeReceiveSpace()) {
+            // Hand out what we have; the caller comes back for the rest
+            m_recvLimited = true;
+            break;
+        }
 
-    if (status == sf::Socket::Done && received > 0) {
-        // Append to receive buffer
-        for (size_t i = 0; i < received; ++i) {
-            m_recvBuffer << tempBuf[i];
+        size_t received = 0;
+        status = m_socket->receive(m_recvBuffer.data() + m_recvEnd,
+                                   m_recvBuffer.size() - m_recvEnd, received);
+        if (status == sf::Socket::Done) {
+            m_recvEnd += received;
         }
+    } while (drain && status == sf::Socket::Done);
+
+    // Peer closed or socket failed - close our end so isConnected() reports it
+    if (!m_recvLimited && (status == sf::Socket::Disconnected || status == sf::Socket::Error)) {
+        disconnect();
     }
 
     // Extract complete packets
     // Wire format: [4 bytes: payload size (uint32 LE)] [2 bytes: opcode] [payload]
-    while (m_recvBuffer.size() >= 6) {  // Minimum: 4 bytes size + 2 bytes opcode
+    while (m_recvEnd - m_recvBegin >= 6) {  // Minimum: 4 bytes size + 2 bytes opcode
+        const uint8_t* header = m_recvBuffer.data() + m_recvBegin;
+
         // Peek at payload size (4 bytes, little-endian)
-        uint32_t payloadSize = static_cast<uint32_t>(m_recvBuffer.data()[0]) |
-                               (static_cast<uint32_t>(m_recvBuffer.data()[1]) << 8) |
-                               (static_cast<uint32_t>(m_recvBuffer.data()[2]) << 16) |
-                               (static_cast<uint32_t>(m_recvBuffer.data()[3]) << 24);
+        uint32_t payloadSize = static_cast<uint32_t>(header[0]) |
+                               (static_cast<uint32_t>(header[1]) << 8) |
+                               (static_cast<uint32_t>(header[2]) << 16) |
+                               (static_cast<uint32_t>(header[3]) << 24);
 
         // Validate payload size (must be at least 2 bytes for opcode)
         if (payloadSize < 2) {
             // Invalid packet - discard byte and try again
-            m_recvBuffer.eraseFront(1);
+            ++m_recvBegin;
             continue;
         }
 
         // Sanity check: don't allow packets > 1MB
-        if (payloadSize > 1000000) {
+        if (payloadSize > MAX_PACKET_SIZE) {
             // Likely garbage - disconnect
             disconnect();
+            m_recvLimited = false;
             return;
         }
 
         // Check if we have the full packet (4-byte header + payload)
-        if (m_recvBuffer.size() < 4 + payloadSize)
+        if (m_recvEnd - m_recvBegin < 4 + payloadSize)
             break;  // Incomplete packet
 
-        // Extract packet payload (skip 4-byte size header)
-        auto pkt = std::make_unique<StlBuffer>(
-            std::vector<uint8_t>(m_recvBuffer.data() + 4, m_recvBuffer.data() + 4 + payloadSize));
-        output.push_back(std::move(pkt));
+        output.push_back(PacketView{header + 4, payloadSize});
+        m_recvBegin += 4 + payloadSize;
+    }
+}
+
+void SfSocket::receive(std::vector<std::unique_ptr<StlBuffer>>& output)
+{
+    std::vector<PacketView> views;
+    do {
+        views.clear();
+        receive(views);
+        for (const PacketView& view : views) {
+            output.push_back(std::make_unique<StlBuffer>(
+                std::vector<uint8_t>(view.data, view.data + view.size)));
+        }
+    } while (hasUnreadInput());
+}
+
+bool SfSocket::makeReceiveSpace()
+{
+    // Slide unparsed bytes to the front. Only legal before any view from the
+    // current receive() exists, which holds because parsing happens after the
+    // read loop.
+    if (m_recvBegin > 0) {
+        size_t pending = m_recvEnd - m_recvBegin;
+        std::memmove(m_recvBuffer.data(), m_recvBuffer.data() + m_recvBegin, pending);
+        m_recvBegin = 0;
+        m_recvEnd = pending;
+        return true;
+    }
 
-        m_recvBuffer.eraseFront(4 + payloadSize);
+    // Buffer is full from the front. Grow only if it holds the start of a
+    // single packet too large to fit; otherwise it is full of complete
+    // packets and the caller should consume them first.
+    if (m_recvEnd >= 4) {
+        const uint8_t* header = m_recvBuffer.data();
+        size_t frameSize = 4 + (static_cast<size_t>(header[0]) |
+                                (static_cast<size_t>(header[1]) << 8) |
+                                (static_cast<size_t>(header[2]) << 16) |
+                                (static_cast<size_t>(header[3]) << 24));
+        if (frameSize > m_recvBuffer.size() && frameSize <= 4 + MAX_PACKET_SIZE) {
+            m_recvBuffer.resize(frameSize);
+            return true;
+        }
     }
+    return false;
 }
 
 bool SfSocket::isConnected() const
@@ -113,6 +302,7 @@ void SfSocket::disconnect()
     if (m_socket) {
         m_socket->disconnect();
     }
+    m_sendQueue.clear();
 }
 
 sf::TcpSocket* SfSocket::getSocket()
@@ -120,6 +310,17 @@ sf::TcpSocket* SfSocket::getSocket()
     return m_socket;
 }
 
+sf::SocketHandle SfSocket::getNativeHandle() const
+{
+    // -1 matches SFML's invalid handle on POSIX (INVALID_SOCKET on Windows)
+    return m_socket ? getNativeHandle(*m_socket) : static_cast<sf::SocketHandle>(-1);
+}
+
+sf::SocketHandle SfSocket::getNativeHandle(const sf::Socket& socket)
+{
+    return SocketHandleAccess::get(socket);
+}
+
 std::string SfSocket::getRemoteAddress() const
 {
     if (m_socket) {
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "StlBuffer.h"
+#include "SendQueue.h"
+#include <SFML/Network/SocketHandle.hpp>
 #include <memory>
 #include <vector>
 
 // Forward declaration
-namespace sf { class TcpSocket; }
+namespace sf { class Socket; class TcpSocket; }
 
 // Socket wrapper with packet buffering
 // Handles partial sends and receives
@@ -28,11 +30,50 @@ public:
 
     ~SfSocket();
 
-    // Send packet (handles partial sends)
+    // Send packet now: queue() + flush()
     bool send(const StlBuffer& data);
     void sendPacket(StlBuffer data) { send(data); }  // Legacy alias
 
+    // Append a framed packet to the outbound queue without writing it.
+    // Returns false if the queue is full (the peer is not keeping up).
+    bool queue(const StlBuffer& data);
+
+    // Append already-framed bytes (e.g. a batch built on another thread)
+    bool queueFrames(const uint8_t* data, size_t size, uint32_t frames);
+
+    // Append one frame shared with other sockets (kept alive by `owner`)
+    bool queueShared(std::shared_ptr<const void> owner, const uint8_t* data, size_t size);
+
+    // Write as much queued output as the socket accepts, in as few syscalls as
+    // possible. Unsent bytes stay queued for the next flush (partial writes are
+    // never dropped). Returns false if the connection failed.
+    bool flush();
+
+    // Disable Nagle. Output is already coalesced into one flush per tick, so
+    // holding the tail of a flush back for an ACK only adds latency.
+    void setNoDelay(bool enabled);
+
+    bool hasPendingOutput() const { return !m_sendQueue.empty(); }
+    const SendQueue& getSendQueue() const { return m_sendQueue; }
+    void setSendQueueLimit(size_t maxBytes) { m_sendQueue.setMaxBytes(maxBytes); }
+
+    // A complete inbound packet ([2 bytes: opcode] [payload], no length
+    // header) pointing into the receive buffer. Valid until the next receive().
+    struct PacketView
+    {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+    };
+
     // Receive packets (may return multiple)
+    // Non-blocking sockets are drained until the OS reports would-block, so this
+    // is safe to drive from an edge-triggered poller. If the receive buffer
+    // filled up first, hasUnreadInput() is true and the caller should handle
+    // the returned packets and call receive() again.
+    void receive(std::vector<PacketView>& output);
+    bool hasUnreadInput() const { return m_recvLimited; }
+
+    // Copying variant (one StlBuffer per packet) for callers that keep packets
     void receive(std::vector<std::unique_ptr<StlBuffer>>& output);
     void popReceived(std::vector<std::unique_ptr<StlBuffer>>& output) { receive(output); }  // Legacy alias
 
@@ -49,11 +90,34 @@ public:
     // Access underlying socket (for polling)
     sf::TcpSocket* getSocket();
 
+    // OS socket handle (for epoll registration and socket options)
+    sf::SocketHandle getNativeHandle() const;
+    static sf::SocketHandle getNativeHandle(const sf::Socket& socket);
+
+    // Largest accepted payload (opcode + data); bigger frames drop the connection
+    static constexpr size_t MAX_PACKET_SIZE = 1000000;
+
 private:
+    // Receive buffer starts at this size and only grows to fit a single
+    // packet larger than it (up to the 4-byte header + MAX_PACKET_SIZE)
+    static constexpr size_t RECV_BUFFER_SIZE = 16 * 1024;
+
+    // Make room at the end of the receive buffer. Returns false if the buffer
+    // is full of complete packets that have not been handed out yet.
+    bool makeReceiveSpace();
+
     Type m_type;
     std::unique_ptr<sf::TcpSocket> m_ownedSocket;
     std::shared_ptr<sf::TcpSocket> m_sharedSocket;  // For legacy constructor
     sf::TcpSocket* m_socket = nullptr;  // Points to either owned or shared
-    StlBuffer m_recvBuffer;
-    StlBuffer m_sendBuffer;
+
+    // Inbound bytes [m_recvBegin, m_recvEnd) are unparsed or belong to packets
+    // handed out by the last receive(). Already-parsed bytes are reclaimed at
+    // the start of the next receive(), so views never move under the caller.
+    std::vector<uint8_t> m_recvBuffer;
+    size_t m_recvBegin = 0;
+    size_t m_recvEnd = 0;
+    bool m_recvLimited = false;
+
+    SendQueue m_sendQueue;
 };
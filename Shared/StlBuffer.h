@@ -2,11 +2,18 @@
 
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <cstring>
 #include <stdint.h>
 #include <stdexcept>
 
 // Binary packet serialization buffer
 // Used for all network packet serialization/deserialization
+//
+// Integers and floats are little-endian on the wire and are copied with a
+// single memcpy (byte-swapped only on big-endian hosts). Reading past the end
+// yields zero/empty values and sets a sticky error flag; check hasError()
+// once after unpacking rather than after every field.
 
 class StlBuffer
 {
@@ -14,52 +21,66 @@ public:
     StlBuffer() = default;
     StlBuffer(const std::vector<uint8_t>& data) : m_data(data) {}
 
-    // Write operators
-    StlBuffer& operator<<(uint8_t val);
-    StlBuffer& operator<<(int8_t val);
-    StlBuffer& operator<<(uint16_t val);
-    StlBuffer& operator<<(int16_t val);
-    StlBuffer& operator<<(uint32_t val);
-    StlBuffer& operator<<(int32_t val);
-    StlBuffer& operator<<(uint64_t val);
-    StlBuffer& operator<<(int64_t val);
-    StlBuffer& operator<<(float val);
-    StlBuffer& operator<<(double val);
-    StlBuffer& operator<<(bool val);
+    // Read-only view over memory owned by someone else (e.g. a packet inside a
+    // socket's receive buffer). Reads come straight from that memory; the
+    // first write copies it into owned storage. The memory must outlive every
+    // read through the view.
+    static StlBuffer view(const uint8_t* data, size_t size);
+    void setView(const uint8_t* data, size_t size);
+    bool isView() const { return m_view != nullptr; }
+
+    // Write operators (numeric ones are inline: every packet field goes
+    // through them)
+    StlBuffer& operator<<(uint8_t val) { put(val); return *this; }
+    StlBuffer& operator<<(int8_t val) { put(val); return *this; }
+    StlBuffer& operator<<(uint16_t val) { put(val); return *this; }
+    StlBuffer& operator<<(int16_t val) { put(val); return *this; }
+    StlBuffer& operator<<(uint32_t val) { put(val); return *this; }
+    StlBuffer& operator<<(int32_t val) { put(val); return *this; }
+    StlBuffer& operator<<(uint64_t val) { put(val); return *this; }
+    StlBuffer& operator<<(int64_t val) { put(val); return *this; }
+    StlBuffer& operator<<(float val) { put(val); return *this; }
+    StlBuffer& operator<<(double val) { put(val); return *this; }
+    StlBuffer& operator<<(bool val) { put(static_cast<uint8_t>(val ? 1 : 0)); return *this; }
     StlBuffer& operator<<(const std::string& val);
 
     // Read operators
-    StlBuffer& operator>>(uint8_t& val);
-    StlBuffer& operator>>(int8_t& val);
-    StlBuffer& operator>>(uint16_t& val);
-    StlBuffer& operator>>(int16_t& val);
-    StlBuffer& operator>>(uint32_t& val);
-    StlBuffer& operator>>(int32_t& val);
-    StlBuffer& operator>>(uint64_t& val);
-    StlBuffer& operator>>(int64_t& val);
-    StlBuffer& operator>>(float& val);
-    StlBuffer& operator>>(double& val);
+    StlBuffer& operator>>(uint8_t& val) { get(val); return *this; }
+    StlBuffer& operator>>(int8_t& val) { get(val); return *this; }
+    StlBuffer& operator>>(uint16_t& val) { get(val); return *this; }
+    StlBuffer& operator>>(int16_t& val) { get(val); return *this; }
+    StlBuffer& operator>>(uint32_t& val) { get(val); return *this; }
+    StlBuffer& operator>>(int32_t& val) { get(val); return *this; }
+    StlBuffer& operator>>(uint64_t& val) { get(val); return *this; }
+    StlBuffer& operator>>(int64_t& val) { get(val); return *this; }
+    StlBuffer& operator>>(float& val) { get(val); return *this; }
+    StlBuffer& operator>>(double& val) { get(val); return *this; }
     StlBuffer& operator>>(bool& val);
     StlBuffer& operator>>(std::string& val);
 
     // Buffer operations
+    void reserve(size_t capacity);
     void eraseFront(size_t bytes);
     void clear();
-    size_t size() const { return m_data.size(); }
-    bool empty() const { return m_data.empty(); }
-    const uint8_t* data() const { return m_data.data(); }
-    uint8_t* data() { return m_data.data(); }
+    size_t size() const { return m_view ? m_viewSize : m_data.size(); }
+    bool empty() const { return size() == 0; }
+    const uint8_t* data() const { return m_view ? m_view : m_data.data(); }
+    uint8_t* data() { makeOwned(); return m_data.data(); }
 
     // Raw data write (for loading from file)
     void write(const char* data, size_t size) {
+        makeOwned();
         m_data.insert(m_data.end(), data, data + size);
     }
 
-    // Reset read position to beginning
-    void resetRead() { m_readPos = 0; }
+    // Reset read position to beginning (and the read error)
+    void resetRead() { m_readPos = 0; m_readError = false; }
+
+    // A read ran past the end of the buffer since the last clear/resetRead
+    bool hasError() const { return m_readError; }
 
     // Check if at end of buffer
-    bool isEof() const { return m_readPos >= m_data.size(); }
+    bool isEof() const { return m_readPos >= size(); }
 
     // Get current read position
     size_t readPos() const { return m_readPos; }
@@ -72,6 +93,54 @@ public:
     bool readFile(const std::string& path);
 
 private:
+    // Wire order is little-endian; only big-endian hosts pay for a swap
+    template<typename T>
+    static T toWireOrder(T val)
+    {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &val, sizeof(T));
+        std::reverse(bytes, bytes + sizeof(T));
+        std::memcpy(&val, bytes, sizeof(T));
+#endif
+        return val;
+    }
+
+    template<typename T>
+    void put(T val)
+    {
+        makeOwned();
+        val = toWireOrder(val);
+        size_t pos = m_data.size();
+        m_data.resize(pos + sizeof(T));
+        std::memcpy(m_data.data() + pos, &val, sizeof(T));
+    }
+
+    template<typename T>
+    void get(T& val)
+    {
+        // Const access: reading must not copy a view into owned storage
+        const StlBuffer& self = *this;
+        if (self.size() - m_readPos < sizeof(T)) {
+            readFailed();
+            val = T();
+            return;
+        }
+        std::memcpy(&val, self.data() + m_readPos, sizeof(T));
+        val = toWireOrder(val);
+        m_readPos += sizeof(T);
+    }
+
+    // Skip to the end and set the error flag
+    void readFailed() { m_readPos = size(); m_readError = true; }
+
+    // Copy a view into m_data so it can be modified
+    void makeOwned() { if (m_view) detachView(); }
+    void detachView();
+
     std::vector<uint8_t> m_data;
     size_t m_readPos = 0;
+    const uint8_t* m_view = nullptr;  // Non-null: reading someone else's memory
+    size_t m_viewSize = 0;
+    bool m_readError = false;
 };